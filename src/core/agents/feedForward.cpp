@@ -40,6 +40,11 @@ namespace Agents {
  * There is no learning during the agent's lifetime; weights and topology are
  * fixed when the genome is decoded in `createWiringFromGenome()`. Persistent
  * neuron outputs allow for recurrent behavior without explicit feedback edges.
+ *
+ * **Memoization** – when `createWiringFromGenome()` found the net's inputs to
+ * be few and discrete (see `FeedForwardMemo`), the input state is computed from
+ * `getSensorLevel()` and a state seen before returns its stored levels without
+ * sampling sensors or touching the neurons.
  */
 std::array<float, Action::NUM_ACTIONS> Individual::feedForward(unsigned simStep) {
   /// This container is used to return values for all the action outputs. This array
@@ -47,6 +52,16 @@ std::array<float, Action::NUM_ACTIONS> Individual::feedForward(unsigned simStep)
   /// input connections. The sum has an arbitrary range. Return by value assumes compiler
   /// return value optimization.
   std::array<float, Action::NUM_ACTIONS> actionLevels;
+
+  /// Nets with a small discrete input space answer repeated input states from the memo
+  unsigned memoState = 0;
+  if (memo.enabled()) {
+    memoState = memo.state([this](Sensor sensor) { return getSensorLevel(sensor); });
+    if (memo.lookup(memoState, actionLevels)) {
+      return actionLevels;
+    }
+  }
+
   actionLevels.fill(0.0);  ///< undriven actions default to value 0.0
 
   /// Weighted inputs to each neuron are summed in neuronAccumulators[]
@@ -92,6 +107,9 @@ std::array<float, Action::NUM_ACTIONS> Individual::feedForward(unsigned simStep)
     }
   }
 
+  if (memo.enabled()) {
+    memo.store(memoState, actionLevels);
+  }
   return actionLevels;
 }
 
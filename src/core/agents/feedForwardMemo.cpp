@@ -0,0 +1,77 @@
+/**
+ * @file feedForwardMemo.cpp
+ * @brief Wiring-time analysis and storage for FeedForwardMemo
+ */
+
+#include "feedForwardMemo.h"
+
+#include "indiv.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Agents {
+
+void FeedForwardMemo::analyze(const NeuralNet& nnet) {
+  stateInputs.clear();
+  drivenActions.clear();
+  numStates = 0;
+
+  unsigned states = 1;
+  for (const Gene& conn : nnet.connections) {
+    if (conn.sourceType == SENSOR) {
+      const Sensor sensor = static_cast<Sensor>(conn.sourceNum);
+      const bool seen = std::any_of(stateInputs.begin(), stateInputs.end(),
+                                    [sensor](const Input& input) { return input.sensor == sensor; });
+      if (!seen) {
+        const unsigned sensorLevels = Individual::sensorLevelCount(sensor);
+        if (sensorLevels == 0 || states * sensorLevels > MAX_STATES) {
+          return;  // Continuous sensor, or too many states
+        }
+        states *= sensorLevels;
+        stateInputs.push_back({sensor, sensorLevels});
+      }
+    } else if (conn.sinkType == NEURON && nnet.neurons[conn.sourceNum].driven) {
+      return;  // Recurrent: the previous step's neuron outputs are part of the state
+    }
+
+    if (conn.sinkType == ACTION &&
+        std::find(drivenActions.begin(), drivenActions.end(), conn.sinkNum) == drivenActions.end()) {
+      drivenActions.push_back(conn.sinkNum);
+    }
+  }
+
+  numStates = states;
+  levels.assign(numStates * drivenActions.size(), 0.0f);
+  stored.assign(numStates, 0);
+}
+
+bool FeedForwardMemo::lookup(unsigned state, std::array<float, Action::NUM_ACTIONS>& actionLevels) const {
+  assert(state < numStates);
+  if (!stored[state]) {
+    return false;
+  }
+  actionLevels.fill(0.0);
+  const float* row = &levels[state * drivenActions.size()];
+  for (unsigned i = 0; i < drivenActions.size(); ++i) {
+    actionLevels[drivenActions[i]] = row[i];
+  }
+  return true;
+}
+
+void FeedForwardMemo::store(unsigned state, const std::array<float, Action::NUM_ACTIONS>& actionLevels) {
+  assert(state < numStates);
+  float* row = &levels[state * drivenActions.size()];
+  for (unsigned i = 0; i < drivenActions.size(); ++i) {
+    row[i] = actionLevels[drivenActions[i]];
+  }
+  stored[state] = 1;
+}
+
+}  // namespace Agents
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
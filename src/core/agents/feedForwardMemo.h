@@ -0,0 +1,109 @@
+#ifndef BIOSIM4_SRC_CORE_AGENTS_FEEDFORWARDMEMO_H_
+#define BIOSIM4_SRC_CORE_AGENTS_FEEDFORWARDMEMO_H_
+
+/**
+ * @file feedForwardMemo.h
+ * @brief Per-net table of action levels for nets with a small input space
+ *
+ * Many evolved nets read only sensors with a few discrete values (last move
+ * direction, boundary distance, location, short barrier probes). When all of
+ * a net's sensors are discrete and no driven neuron reads a driven neuron, the
+ * action levels are a pure function of those sensor values. analyze() detects
+ * such nets when they are wired; feedForward() then evaluates each input state
+ * once and answers repeats from the table, with bit-identical results.
+ */
+
+#include "../genetics/genome-neurons.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Agents {
+
+/**
+ * @class FeedForwardMemo
+ * @brief Action levels of one net, indexed by its discrete input state
+ *
+ * The input state is a mixed-radix number with one digit per distinct sensor
+ * the net reads; the digit is Individual::getSensorLevel(). Only the levels of
+ * actions the net drives are stored. Driven neuron outputs are not replayed on
+ * a hit: in a net without recurrence they are never read before being
+ * recomputed, so skipping them is not observable.
+ */
+class FeedForwardMemo {
+ public:
+  static constexpr unsigned MAX_STATES = 256;  ///< Largest input space worth a table
+
+  /// One digit of the input state
+  struct Input {
+    Sensor sensor;    ///< Sensor the net reads
+    unsigned levels;  ///< Individual::sensorLevelCount(sensor)
+  };
+
+  /**
+   * @brief Decide whether a freshly wired net can be memoized, and reset the table
+   *
+   * A net qualifies if every sensor it reads is discrete, no driven neuron has
+   * an input from a driven neuron (including itself), and its input space has
+   * at most MAX_STATES states.
+   *
+   * @param nnet Net as produced by createWiringFromGenome()
+   */
+  void analyze(const NeuralNet& nnet);
+
+  /// True if analyze() accepted the net
+  bool enabled() const { return numStates != 0; }
+
+  /// Digits of the input state, most significant first
+  const std::vector<Input>& inputs() const { return stateInputs; }
+
+  /**
+   * @brief Input state from per-sensor levels
+   * @param levelOf Callable mapping a Sensor to its current level
+   * @return 0..number of states - 1
+   */
+  template <typename LevelOf>
+  unsigned state(LevelOf&& levelOf) const {
+    unsigned index = 0;
+    for (const Input& input : stateInputs) {
+      index = index * input.levels + levelOf(input.sensor);
+    }
+    return index;
+  }
+
+  /**
+   * @brief Copy a stored result into actionLevels
+   * @param state Input state
+   * @param[out] actionLevels Receives the levels if the state was stored
+   * @return false if the state has not been evaluated yet
+   */
+  bool lookup(unsigned state, std::array<float, Action::NUM_ACTIONS>& actionLevels) const;
+
+  /**
+   * @brief Remember the result of evaluating the net in a state
+   * @param state Input state
+   * @param actionLevels Levels returned by the evaluation
+   */
+  void store(unsigned state, const std::array<float, Action::NUM_ACTIONS>& actionLevels);
+
+ private:
+  std::vector<Input> stateInputs;      ///< Distinct sensors the net reads
+  std::vector<uint8_t> drivenActions;  ///< Action sinks the net drives
+  unsigned numStates = 0;              ///< Size of the input space; 0 when disabled
+  std::vector<float> levels;           ///< numStates rows of drivenActions.size() levels
+  std::vector<uint8_t> stored;         ///< Per state: 1 once its row is valid
+};
+
+}  // namespace Agents
+}  // namespace Core
+}  // namespace v1
+
+using Core::Agents::FeedForwardMemo;
+
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_CORE_AGENTS_FEEDFORWARDMEMO_H_
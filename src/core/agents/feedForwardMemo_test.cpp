@@ -0,0 +1,68 @@
+/**
+ * @file feedForwardMemo_test.cpp
+ * @brief Tests for memoized feed-forward evaluation of discrete-input nets.
+ */
+
+#include "../simulation/simulator.h"
+#include "feedForwardMemo.h"
+
+#include <gtest/gtest.h>
+
+namespace BioSim {
+
+namespace {
+
+Individual wiredIndividual(Genome genome) {
+  Individual indiv;
+  indiv.age = 0;
+  indiv.oscPeriod = 34;
+  indiv.longProbeDist = 16;
+  indiv.loc = Coordinate{0, 0};
+  indiv.lastMoveDir = Dir(Compass::CENTER);
+  indiv.genome = std::move(genome);
+  indiv.createWiringFromGenome();
+  return indiv;
+}
+
+}  // namespace
+
+TEST(FeedForwardMemoTest, RepeatedStatesMatchFullEvaluationExactly) {
+  initParamsForTesting(16, 16);
+  Individual memoized = wiredIndividual({
+      {SENSOR, Sensor::LAST_MOVE_DIR_X, NEURON, 0, 9000},
+      {SENSOR, Sensor::BOUNDARY_DIST_X, NEURON, 0, -12000},
+      {NEURON, 0, ACTION, Action::MOVE_X, 20000},
+      {SENSOR, Sensor::LAST_MOVE_DIR_Y, ACTION, Action::MOVE_Y, -7000},
+  });
+  ASSERT_TRUE(memoized.memo.enabled());
+  Individual reference = memoized;
+  reference.memo = FeedForwardMemo{};
+
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int16_t x = 0; x < 16; ++x) {
+      for (uint8_t dir = 0; dir < 9; ++dir) {
+        memoized.loc = reference.loc = Coordinate{x, 3};
+        memoized.lastMoveDir = reference.lastMoveDir = Dir(static_cast<Compass>(dir));
+        EXPECT_EQ(memoized.feedForward(0), reference.feedForward(0)) << "x " << x << " dir " << int(dir);
+      }
+    }
+  }
+}
+
+TEST(FeedForwardMemoTest, OnlySmallDiscreteNonRecurrentNetsAreMemoized) {
+  initParamsForTesting(16, 16);
+  EXPECT_TRUE(wiredIndividual({{SENSOR, Sensor::LOC_X, ACTION, Action::MOVE_X, 8192},
+                               {SENSOR, Sensor::LOC_Y, ACTION, Action::MOVE_Y, 8192}})
+                  .memo.enabled());
+  EXPECT_FALSE(wiredIndividual({{SENSOR, Sensor::LOC_X, ACTION, Action::MOVE_X, 8192},
+                                {SENSOR, Sensor::LOC_Y, ACTION, Action::MOVE_Y, 8192},
+                                {SENSOR, Sensor::LAST_MOVE_DIR_X, ACTION, Action::MOVE_Y, 8192}})
+                   .memo.enabled());
+  EXPECT_FALSE(wiredIndividual({{SENSOR, Sensor::RANDOM, ACTION, Action::MOVE_X, 8192}}).memo.enabled());
+  EXPECT_FALSE(wiredIndividual({{SENSOR, Sensor::LAST_MOVE_DIR_X, NEURON, 0, 8192},
+                                {NEURON, 0, NEURON, 0, 8192},
+                                {NEURON, 0, ACTION, Action::MOVE_X, 8192}})
+                   .memo.enabled());
+}
+
+}  // namespace BioSim
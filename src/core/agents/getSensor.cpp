@@ -10,6 +10,7 @@
 
 #include "../../core/simulation/simulator.h"
 #include "../../utils/analysis.h"
+#include "../../utils/logger.h"
 
 #include <spdlog/fmt/fmt.h>
 
@@ -70,14 +71,13 @@ float getPopulationDensityAlongAxis(Coordinate loc, Dir dir) {
  * @param loc0 Starting coordinate (current individual location).
  * @param dir Axis to probe along (forward vs reverse).
  * @param probeDistance Maximum number of cells to inspect each way.
- * @return Normalized sensor value in `[0.0, 1.0]` (0.5 == balanced).
+ * @return Differential distance shifted to `[0, 2 * probeDistance]` (probeDistance == balanced).
  *
  * The helper counts how many free cells exist before the first barrier (or
- * border) in both the forward and reverse direction. The differential distance
- * is mapped to sensor space, producing high values when the forward path is
- * clearer than the reverse.
+ * border) in both the forward and reverse direction. High values mean the
+ * forward path is clearer than the reverse.
  */
-float getShortProbeBarrierDistance(Coordinate loc0, Dir dir, unsigned probeDistance) {
+unsigned getShortProbeBarrierSteps(Coordinate loc0, Dir dir, unsigned probeDistance) {
   unsigned countFwd = 0;
   unsigned countRev = 0;
   Coordinate loc = loc0 + dir;
@@ -103,8 +103,19 @@ float getShortProbeBarrierDistance(Coordinate loc0, Dir dir, unsigned probeDista
     countRev = probeDistance;
   }
 
-  float sensorVal = ((countFwd - countRev) + probeDistance);  ///< convert to 0..2*probeDistance
-  sensorVal = (sensorVal / 2.0) / probeDistance;              ///< convert to 0.0..1.0
+  return (countFwd - countRev) + probeDistance;  ///< convert to 0..2*probeDistance
+}
+
+/**
+ * @brief getShortProbeBarrierSteps() mapped to sensor space.
+ * @param loc0 Starting coordinate (current individual location).
+ * @param dir Axis to probe along (forward vs reverse).
+ * @param probeDistance Maximum number of cells to inspect each way.
+ * @return Normalized sensor value in `[0.0, 1.0]` (0.5 == balanced).
+ */
+float getShortProbeBarrierDistance(Coordinate loc0, Dir dir, unsigned probeDistance) {
+  float sensorVal = getShortProbeBarrierSteps(loc0, dir, probeDistance);
+  sensorVal = (sensorVal / 2.0) / probeDistance;  ///< convert to 0.0..1.0
   return sensorVal;
 }
 
@@ -390,7 +401,7 @@ float Individual::getSensor(Sensor sensorNum, unsigned simStep) const {
   }
 
   if (std::isnan(sensorVal) || sensorVal < -0.01 || sensorVal > 1.01) {
-    fmt::print("sensorVal={} for {}\n", static_cast<int>(sensorVal), Utils::sensorName((Sensor)sensorNum));
+    BIOSIM_PRINT_THROTTLED("sensorVal={} for {}", static_cast<int>(sensorVal), Utils::sensorName((Sensor)sensorNum));
     sensorVal = std::max(0.0f, std::min(sensorVal, 1.0f));  ///< clip
   }
 
@@ -399,6 +410,75 @@ float Individual::getSensor(Sensor sensorNum, unsigned simStep) const {
   return sensorVal;
 }
 
+/**
+ * @brief Number of distinct values a sensor can return.
+ * @param sensor Sensor to classify.
+ * @return Level count, or 0 for sensors that are continuous or also depend on
+ *         age, time, randomness, neighbors or a mutable probe distance.
+ *
+ * Must agree with getSensorLevel(): FeedForwardMemo relies on getSensor()
+ * being a function of the level for every sensor with a non-zero count.
+ */
+unsigned Individual::sensorLevelCount(Sensor sensor) {
+  const unsigned sizeX = parameterMngrSingleton.gridSize_X;
+  const unsigned sizeY = parameterMngrSingleton.gridSize_Y;
+  switch (sensor) {
+    case Sensor::LOC_X:
+      return sizeX;
+    case Sensor::LOC_Y:
+      return sizeY;
+    case Sensor::BOUNDARY_DIST_X:
+      return (sizeX - 1) / 2 + 1;
+    case Sensor::BOUNDARY_DIST_Y:
+      return (sizeY - 1) / 2 + 1;
+    case Sensor::BOUNDARY_DIST:
+      return std::min((sizeX - 1) / 2, (sizeY - 1) / 2) + 1;
+    case Sensor::LAST_MOVE_DIR_X:
+    case Sensor::LAST_MOVE_DIR_Y:
+      return 3;
+    case Sensor::BARRIER_FWD:
+    case Sensor::BARRIER_LR:
+      return 2 * parameterMngrSingleton.shortProbeBarrierDistance + 1;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Index of a discrete sensor's current value.
+ * @param sensor Sensor with a non-zero sensorLevelCount().
+ * @return Level in `[0, sensorLevelCount(sensor))`.
+ *
+ * Reads the same state as the matching getSensor() branch, without the
+ * conversion to sensor space.
+ */
+unsigned Individual::getSensorLevel(Sensor sensor) const {
+  switch (sensor) {
+    case Sensor::LOC_X:
+      return loc.x;
+    case Sensor::LOC_Y:
+      return loc.y;
+    case Sensor::BOUNDARY_DIST_X:
+      return std::min<int>(loc.x, (parameterMngrSingleton.gridSize_X - loc.x) - 1);
+    case Sensor::BOUNDARY_DIST_Y:
+      return std::min<int>(loc.y, (parameterMngrSingleton.gridSize_Y - loc.y) - 1);
+    case Sensor::BOUNDARY_DIST:
+      return std::min(getSensorLevel(Sensor::BOUNDARY_DIST_X), getSensorLevel(Sensor::BOUNDARY_DIST_Y));
+    case Sensor::LAST_MOVE_DIR_X:
+      return lastMoveDir.asNormalizedCoord().x + 1;
+    case Sensor::LAST_MOVE_DIR_Y:
+      return lastMoveDir.asNormalizedCoord().y + 1;
+    case Sensor::BARRIER_FWD:
+      return getShortProbeBarrierSteps(loc, lastMoveDir, parameterMngrSingleton.shortProbeBarrierDistance);
+    case Sensor::BARRIER_LR:
+      return getShortProbeBarrierSteps(loc, lastMoveDir.rotate90DegCW(),
+                                       parameterMngrSingleton.shortProbeBarrierDistance);
+    default:
+      assert(false);
+      return 0;
+  }
+}
+
 }  // namespace Agents
 }  // namespace Core
 }  // namespace v1
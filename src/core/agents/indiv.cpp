@@ -30,6 +30,7 @@ namespace Agents {
  * - Responsiveness at 0.5 (midrange, may be adjusted by action activation function)
  * - Random initial movement direction
  * - Challenge bits cleared (no accomplishments yet)
+ * - Color index derived from the genome, so frame capture never reads the genome
  *
  * @param index_ Unique identifier and index into peeps[] container
  * @param loc_ Starting grid coordinates for this individual
@@ -55,6 +56,7 @@ void Individual::initialize(uint16_t index_, Coordinate loc_, Genome&& genome_)
   longProbeDist = parameterMngrSingleton.longProbeDistance;
   challengeBits = (unsigned)false;  // No challenges accomplished yet
   genome = std::move(genome_);
+  colorIndex = makeGeneticColor(genome);  // Frame capture reads this instead of the genome
   createWiringFromGenome();
 }
 
@@ -14,6 +14,7 @@
 
 #include "../../core/genetics/genome-neurons.h"
 #include "../../types/basicTypes.h"
+#include "feedForwardMemo.h"
 
 #include <algorithm>
 #include <array>
@@ -39,6 +40,7 @@ namespace Agents {
  */
 struct Individual {
   bool alive;           ///< Whether the individual is currently alive
+  uint8_t colorIndex;   ///< makeGeneticColor() of the genome, set at birth; drawn via agentColor()
   uint16_t index;       ///< Index into peeps[] container
   Coordinate loc;       ///< Current location in grid[][]
   Coordinate birthLoc;  ///< Location where individual was born
@@ -51,6 +53,7 @@ struct Individual {
   unsigned longProbeDist;  ///< Distance for long-range forward obstruction probes
   Dir lastMoveDir;         ///< Direction of last movement action
   unsigned challengeBits;  ///< Bitfield tracking challenge accomplishments
+  FeedForwardMemo memo;    ///< Action levels by input state, for nets with a small discrete input space
 
   /**
    * @brief Execute one neural network forward pass
@@ -71,6 +74,21 @@ struct Individual {
    */
   float getSensor(Sensor sensor, unsigned simStep) const;
 
+  /**
+   * @brief Number of distinct values a sensor can return
+   * @param sensor Sensor type
+   * @return Level count, or 0 if the sensor is not discrete (or depends on
+   *         per-individual state other than location and last move direction)
+   */
+  static unsigned sensorLevelCount(Sensor sensor);
+
+  /**
+   * @brief Index of a discrete sensor's current value
+   * @param sensor Sensor with a non-zero sensorLevelCount()
+   * @return 0..sensorLevelCount(sensor)-1; getSensor() is a function of it
+   */
+  unsigned getSensorLevel(Sensor sensor) const;
+
   /**
    * @brief Initialize a new individual
    * @param index Index in peeps[] container
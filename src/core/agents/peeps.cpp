@@ -94,6 +94,28 @@ void Peeps::queueForDeath(const Individual& individual) {
   }
 }
 
+/**
+ * @brief Queue an individual for death by its environment
+ *
+ * Used by challenge hazards (radioactive walls) from the parallel agent step.
+ * The entry shares the death queue and its critical section with
+ * queueForDeath(), and is drained the same way; it is only kept out of
+ * murderQueueSize(), so murder statistics count individuals killed by others.
+ *
+ * @param individual The individual to mark for death (must be alive)
+ *
+ * @see queueForDeath()
+ */
+void Peeps::queueForEnvironmentDeath(const Individual& individual) {
+  assert(individual.alive);
+
+#pragma omp critical
+  {
+    deathQueue.push_back(individual.index);
+    ++environmentDeaths;
+  }
+}
+
 /**
  * @brief Process all queued deaths at the end of a simulation step
  *
@@ -123,6 +145,7 @@ void Peeps::drainDeathQueue() {
     indiv.alive = false;
   }
   deathQueue.clear();
+  environmentDeaths = 0;
 }
 
 /**
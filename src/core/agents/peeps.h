@@ -85,6 +85,15 @@ class Peeps {
    */
   void queueForDeath(const Individual& indiv);
 
+  /**
+   * @brief Queue an Individual killed by its environment (a challenge hazard)
+   * @param indiv Individual to mark for death
+   *
+   * Like queueForDeath(), but not counted by murderQueueSize().
+   * Thread-safe for concurrent queuing.
+   */
+  void queueForEnvironmentDeath(const Individual& indiv);
+
   /**
    * @brief Process all queued deaths
    *
@@ -117,6 +126,12 @@ class Peeps {
    */
   unsigned deathQueueSize() const { return deathQueue.size(); }
 
+  /**
+   * @brief Get the number of queued deaths caused by other Individuals
+   * @return deathQueueSize() without the queueForEnvironmentDeath() entries
+   */
+  unsigned murderQueueSize() const { return deathQueue.size() - environmentDeaths; }
+
   /**
    * @brief Get Individual at grid location (non-const)
    * @param loc Grid coordinate
@@ -152,6 +167,7 @@ class Peeps {
  private:
   std::vector<Individual> individuals;                     ///< All Individuals (index 0 reserved)
   std::vector<uint16_t> deathQueue;                        ///< Indices of Individuals to kill
+  unsigned environmentDeaths = 0;                          ///< deathQueue entries from queueForEnvironmentDeath()
   std::vector<std::pair<uint16_t, Coordinate>> moveQueue;  ///< (index, destination) pairs
 };
 
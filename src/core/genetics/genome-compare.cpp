@@ -242,6 +242,94 @@ float genomeSimilarity(const Genome& g1, const Genome& g2) {
   }
 }
 
+namespace {
+
+/// Number of pairs drawn by sampleDiversityPairs(); 0 if population < 2
+unsigned diversitySampleCount() {
+  if (parameterMngrSingleton.population < 2) {
+    return 0;
+  }
+  /// count limits the number of genomes sampled for performance reasons.
+  return std::min(1000U, parameterMngrSingleton.population);  ///< TODO p.analysisSampleSize;
+}
+
+/// First index of a sampled pair; its partner is the next index
+unsigned drawDiversityPair() {
+  return randomUint(1, parameterMngrSingleton.population - 1);  ///< skip first and last elements
+}
+
+}  // namespace
+
+/**
+ * @brief Draw the genome pairs used to estimate genetic diversity
+ *
+ * Consumes the same random numbers as geneticDiversity() and copies the sampled
+ * genomes into one gene buffer, so that the comparison can be done later on
+ * another thread. The indices are drawn first so the buffer is sized once.
+ *
+ * @return Genomes laid out as (a0, b0, a1, b1, ...); empty if population < 2
+ */
+DiversitySample sampleDiversityPairs() {
+  DiversitySample sample;
+  const unsigned count = diversitySampleCount();
+  if (count == 0) {
+    return sample;
+  }
+
+  std::vector<unsigned> firstIndices(count);
+  size_t geneCount = 0;
+  for (unsigned& index0 : firstIndices) {
+    index0 = drawDiversityPair();
+    geneCount += peeps[index0].genome.size() + peeps[index0 + 1].genome.size();
+  }
+
+  sample.genes.reserve(geneCount);
+  sample.starts.reserve(2 * count + 1);
+  for (unsigned index0 : firstIndices) {
+    for (unsigned index : {index0, index0 + 1}) {
+      const Genome& genome = peeps[index].genome;
+      sample.starts.push_back(static_cast<uint32_t>(sample.genes.size()));
+      sample.genes.insert(sample.genes.end(), genome.begin(), genome.end());
+    }
+  }
+  sample.starts.push_back(static_cast<uint32_t>(sample.genes.size()));
+  return sample;
+}
+
+/**
+ * @brief Draw the same random numbers as sampleDiversityPairs() and discard them
+ */
+void skipDiversityPairs() {
+  for (unsigned count = diversitySampleCount(); count > 0; --count) {
+    drawDiversityPair();
+  }
+}
+
+/**
+ * @brief Genetic diversity of pairs drawn by sampleDiversityPairs()
+ * @param sample Genomes laid out as (a0, b0, a1, b1, ...)
+ * @return 1.0 - mean pair similarity; 0.0 if there are no pairs
+ */
+float geneticDiversity(const DiversitySample& sample) {
+  const size_t pairCount = sample.pairCount();
+  if (pairCount == 0) {
+    return 0.0;
+  }
+
+  // genomeSimilarity() takes whole genomes; these two are reused for every pair
+  Genome genome0;
+  Genome genome1;
+  float similaritySum = 0.0f;
+  for (size_t pair = 0; pair < pairCount; ++pair) {
+    const auto genomeBegin = [&](size_t n) { return sample.genes.begin() + sample.starts[n]; };
+    genome0.assign(genomeBegin(2 * pair), genomeBegin(2 * pair + 1));
+    genome1.assign(genomeBegin(2 * pair + 1), genomeBegin(2 * pair + 2));
+    similaritySum += genomeSimilarity(genome0, genome1);
+  }
+  float diversity = 1.0f - (similaritySum / pairCount);
+  return diversity;
+}
+
 /**
  * @brief Calculate genetic diversity across the population
  *
@@ -267,25 +355,7 @@ float genomeSimilarity(const Genome& g1, const Genome& g2) {
  * @see genomeSimilarity() for the underlying comparison algorithm
  */
 float geneticDiversity() {
-  if (parameterMngrSingleton.population < 2) {
-    return 0.0;
-  }
-
-  /// count limits the number of genomes sampled for performance reasons.
-  unsigned count = std::min(1000U,
-                            parameterMngrSingleton.population);  ///< TODO p.analysisSampleSize;
-  int numSamples = 0;
-  float similaritySum = 0.0f;
-
-  while (count > 0) {
-    unsigned index0 = randomUint(1, parameterMngrSingleton.population - 1);  ///< skip first and last elements
-    unsigned index1 = index0 + 1;
-    similaritySum += genomeSimilarity(peeps[index0].genome, peeps[index1].genome);
-    --count;
-    ++numSamples;
-  }
-  float diversity = 1.0f - (similaritySum / numSamples);
-  return diversity;
+  return geneticDiversity(sampleDiversityPairs());
 }
 
 }  // namespace Genetics
@@ -175,6 +175,57 @@ extern float genomeSimilarity(const Genome& g1, const Genome& g2);
  */
 extern float geneticDiversity();
 
+/**
+ * @struct DiversitySample
+ * @brief Genome pairs drawn for geneticDiversity(), stored in one flat gene buffer
+ *
+ * Genome n occupies genes[starts[n]] .. genes[starts[n + 1] - 1]; genomes are
+ * laid out as (a0, b0, a1, b1, ...).
+ */
+struct DiversitySample {
+  std::vector<Gene> genes;       ///< Sampled genomes, back to back
+  std::vector<uint32_t> starts;  ///< Offset of each genome in genes, plus the end offset
+
+  /** @brief Number of sampled pairs */
+  size_t pairCount() const { return starts.empty() ? 0 : (starts.size() - 1) / 2; }
+
+  /** @brief Heap bytes held by the sample */
+  size_t bytes() const { return genes.capacity() * sizeof(Gene) + starts.capacity() * sizeof(uint32_t); }
+};
+
+/**
+ * @brief Sample genome pairs for geneticDiversity() without comparing them
+ * @return Copies of the sampled genomes in one flat buffer
+ *
+ * Uses the same random draws as geneticDiversity(), so the comparison can run
+ * later on another thread without changing the RNG sequence.
+ */
+extern DiversitySample sampleDiversityPairs();
+
+/**
+ * @brief Consume the random draws of sampleDiversityPairs() without copying genomes
+ *
+ * Used when no metrics log is written, so the run stays identical to one that
+ * samples diversity.
+ */
+extern void skipDiversityPairs();
+
+/**
+ * @brief Calculate genetic diversity from pairs returned by sampleDiversityPairs()
+ * @param sample Sampled genome pairs
+ * @return Diversity score in range [0.0, 1.0]
+ */
+extern float geneticDiversity(const DiversitySample& sample);
+
+/**
+ * @brief Derive the 8-bit color index used to draw an individual
+ * @param genome Individual's genome (must not be empty)
+ * @return Color index; clones share the same value
+ *
+ * Computed once per individual by Individual::initialize().
+ */
+extern uint8_t makeGeneticColor(const Genome& genome);
+
 }  // namespace Genetics
 }  // namespace Core
 }  // namespace v1
@@ -183,15 +234,19 @@ extern float geneticDiversity();
 // Backward compatibility aliases
 namespace BioSim {
 using Core::Genetics::ACTION;
+using Core::Genetics::DiversitySample;
 using Core::Genetics::Gene;
 using Core::Genetics::geneticDiversity;
 using Core::Genetics::Genome;
 using Core::Genetics::genomeSimilarity;
 using Core::Genetics::initialNeuronOutput;
+using Core::Genetics::makeGeneticColor;
 using Core::Genetics::makeRandomGene;
 using Core::Genetics::makeRandomGenome;
 using Core::Genetics::NeuralNet;
 using Core::Genetics::NEURON;
+using Core::Genetics::sampleDiversityPairs;
+using Core::Genetics::skipDiversityPairs;
 using Core::Genetics::SENSOR;
 using Core::Genetics::unitTestConnectNeuralNetWiringFromGenome;
 }  // namespace BioSim
@@ -350,6 +350,7 @@ void cullUselessNeurons(ConnectionList& connections, NodeMap& nodeMap) {
  * 4. **Remapping**: Assign sequential 0-based indices to surviving neurons
  * 5. **Wiring**: Build final connection list with optimized ordering
  * 6. **Neuron Creation**: Initialize neuron state array
+ * 7. **Memo Analysis**: Enable feedForward() memoization for small discrete input spaces
  *
  * ## Connection Ordering Optimization
  * Connections are ordered for efficient feedforward processing:
@@ -438,6 +439,9 @@ void Individual::createWiringFromGenome() {
     nnet.neurons.back().output = Genetics::initialNeuronOutput();
     nnet.neurons.back().driven = (nodeMap[neuronNum].numInputsFromSensorsOrOtherNeurons != 0);
   }
+
+  /// Nets whose inputs take few discrete values get a memo table for feedForward()
+  memo.analyze(nnet);
 }
 
 }  // namespace Agents
@@ -715,6 +719,36 @@ Genome generateChildGenome(const std::vector<Genome>& parentGenomes) {
   return genome;
 }
 
+/**
+ * @brief Generates a deterministic 8-bit color value from an individual's genome
+ *
+ * Creates a pseudo-hash of the genome by extracting bit patterns from key gene properties
+ * (first and last gene's source/sink types and indices). This produces visually distinct
+ * colors for different genome structures while keeping the same color for clones.
+ *
+ * Bit layout (LSB to MSB):
+ * - Bit 0: Genome length parity (odd=1, even=0)
+ * - Bit 1: First gene source type
+ * - Bit 2: Last gene source type
+ * - Bit 3: First gene sink type
+ * - Bit 4: Last gene sink type
+ * - Bit 5: First gene source number (LSB only)
+ * - Bit 6: First gene sink number (LSB only)
+ * - Bit 7: Last gene source number (LSB only)
+ *
+ * @param genome The individual's genome (vector of Gene structs)
+ * @return 8-bit color index value (0-255) used as seed for RGB color generation
+ *
+ * @note This is NOT a cryptographic hash - collisions are acceptable and visually tolerable
+ * @note The mapping to RGB (agentColor() in imageWriter.cpp) avoids overly bright colors
+ * @note Identical genomes (clones) will have identical colors, aiding visual tracking
+ */
+uint8_t makeGeneticColor(const Genome& genome) {
+  return ((genome.size() & 1) | ((genome.front().sourceType) << 1) | ((genome.back().sourceType) << 2) |
+          ((genome.front().sinkType) << 3) | ((genome.back().sinkType) << 4) | ((genome.front().sourceNum & 1) << 5) |
+          ((genome.front().sinkNum & 1) << 6) | ((genome.back().sourceNum & 1) << 7));
+}
+
 }  // namespace Genetics
 }  // namespace Core
 }  // namespace v1
@@ -0,0 +1,303 @@
+/**
+ * @file benchmarkRunner.cpp
+ * @brief Implementation of the end-to-end benchmark run mode
+ *
+ * Each scenario is a full simulator() run in this process. Peak RSS is reset
+ * between scenarios where the platform allows it (Linux), so each scenario
+ * reports its own high-water mark rather than the process-wide maximum.
+ */
+
+#include "benchmarkRunner.h"
+
+#include "../../utils/logger.h"
+#include "../../utils/resourceUsage.h"
+#include "simulator.h"
+
+#include <spdlog/fmt/fmt.h>
+#include <toml.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+using Types::Params;
+using Utils::Logger;
+
+namespace {
+
+/// Barrier layout used for the "with barriers" variant (floating islands)
+constexpr unsigned BENCHMARK_BARRIER_TYPE = 5;
+
+/**
+ * @brief Challenge IDs and the short names used in scenario identifiers
+ */
+struct ChallengeEntry {
+  unsigned id;
+  const char* name;
+};
+
+constexpr ChallengeEntry BENCHMARK_CHALLENGES[] = {
+    {CHALLENGE_CIRCLE, "circle"},
+    {CHALLENGE_RIGHT_HALF, "right-half"},
+    {CHALLENGE_RIGHT_QUARTER, "right-quarter"},
+    {CHALLENGE_STRING, "string"},
+    {CHALLENGE_CENTER_WEIGHTED, "center-weighted"},
+    {CHALLENGE_CENTER_UNWEIGHTED, "center-unweighted"},
+    {CHALLENGE_CORNER, "corner"},
+    {CHALLENGE_CORNER_WEIGHTED, "corner-weighted"},
+    {CHALLENGE_MIGRATE_DISTANCE, "migrate-distance"},
+    {CHALLENGE_CENTER_SPARSE, "center-sparse"},
+    {CHALLENGE_LEFT_EIGHTH, "left-eighth"},
+    {CHALLENGE_RADIOACTIVE_WALLS, "radioactive-walls"},
+    {CHALLENGE_AGAINST_ANY_WALL, "against-any-wall"},
+    {CHALLENGE_TOUCH_ANY_WALL, "touch-any-wall"},
+    {CHALLENGE_EAST_WEST_EIGHTHS, "east-west-eighths"},
+    {CHALLENGE_NEAR_BARRIER, "near-barrier"},
+    {CHALLENGE_PAIRS, "pairs"},
+    {CHALLENGE_LOCATION_SEQUENCE, "location-sequence"},
+    {CHALLENGE_ALTRUISM, "altruism"},
+    {CHALLENGE_ALTRUISM_SACRIFICE, "altruism-sacrifice"},
+};
+
+/// Metric keys as written to the baseline file
+constexpr const char* METRIC_AGENT_STEPS = "agent_steps_per_sec";
+constexpr const char* METRIC_GENERATIONS = "generations_per_sec";
+constexpr const char* METRIC_PEAK_RSS = "peak_rss_bytes";
+
+double percentChange(double baseline, double current) {
+  return baseline != 0.0 ? (current - baseline) / baseline * 100.0 : 0.0;
+}
+
+double megabytes(size_t bytes) {
+  return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+}  // namespace
+
+std::vector<BenchmarkScenario> BenchmarkRunner::standardScenarios() {
+  std::vector<BenchmarkScenario> scenarios;
+
+  for (const auto& challenge : BENCHMARK_CHALLENGES) {
+    const unsigned id = challenge.id;
+    scenarios.push_back({fmt::format("{}-open", challenge.name), [id](Params& p) {
+                           p.challenge = id;
+                           p.barrierType = 0;
+                         }});
+    scenarios.push_back({fmt::format("{}-barriers", challenge.name), [id](Params& p) {
+                           p.challenge = id;
+                           p.barrierType = BENCHMARK_BARRIER_TYPE;
+                         }});
+  }
+
+  // Dense world with wide signal sensing: stresses Signals::increment/fade and
+  // the SIGNAL0* sensors rather than selection
+  scenarios.push_back({"signal-heavy", [](Params& p) {
+                         p.challenge = CHALLENGE_CORNER_WEIGHTED;
+                         p.barrierType = 0;
+                         p.signalLayers = 2;
+                         p.signalSensorRadius = 4;
+                         p.population = std::max(p.population, (p.gridSize_X * p.gridSize_Y) / 4u);
+                       }});
+
+  return scenarios;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run(const Params& baseParams, const std::string& filter,
+                                                  unsigned generations) {
+  std::vector<BenchmarkResult> results;
+
+  for (const auto& scenario : standardScenarios()) {
+    if (!filter.empty() && scenario.name.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    Params params = baseParams;
+    scenario.apply(params);
+    params.saveVideo = false;
+    params.updateGraphLog = false;
+    params.displaySampleGenomes = 0;
+    params.genomeAnalysisStride = generations + 1;
+    params.deterministic = true;
+    params.maxGenerations = generations;
+
+    Logger::header("\n⏱  Benchmark scenario: {}", scenario.name);
+    Logger::info("Benchmark scenario {} (challenge={}, barrierType={}, population={})", scenario.name,
+                 params.challenge, params.barrierType, params.population);
+
+    Utils::resetPeakResidentSetBytes();
+    BenchmarkResult result;
+    result.scenario = scenario.name;
+    result.stats = simulator(params, generations);
+    result.peakRssBytes = Utils::peakResidentSetBytes();
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+void BenchmarkRunner::printReport(const std::vector<BenchmarkResult>& results) {
+  Logger::header("\n📊 Benchmark Results");
+  fmt::print("{:<28} {:>14} {:>9} {:>10} {:>8} {:>8} {:>8} {:>8}\n", "scenario", "agent-steps/s", "gen/s",
+             "peak MB", "step%", "eos%", "eog%", "spawn%");
+
+  for (const auto& result : results) {
+    const auto& stats = result.stats;
+    auto share = [&stats](Phase phase) {
+      return stats.wallSeconds > 0.0 ? stats.phaseTime(phase) / stats.wallSeconds * 100.0 : 0.0;
+    };
+    fmt::print("{:<28} {:>14.0f} {:>9.2f} {:>10.1f} {:>8.1f} {:>8.1f} {:>8.1f} {:>8.1f}\n", result.scenario,
+               stats.agentStepsPerSecond(), stats.generationsPerSecond(), megabytes(result.peakRssBytes),
+               share(Phase::AGENT_STEP), share(Phase::END_OF_STEP), share(Phase::END_OF_GENERATION),
+               share(Phase::SPAWN_GENERATION));
+  }
+  fmt::print("\nPhases: step = parallel agent step, eos = endOfSimulationStep, "
+             "eog = endOfGeneration, spawn = spawnNewGeneration\n");
+}
+
+void BenchmarkRunner::saveBaseline(const std::vector<BenchmarkResult>& results, const Params& baseParams,
+                                   const std::string& path) {
+  std::ofstream file(path);
+  if (!file) {
+    throw std::runtime_error("Failed to open file for writing: " + path);
+  }
+
+  file << "# BioSim4 benchmark baseline (TOML format)\n";
+  file << "# Generated by biosim4 --benchmark --benchmark-out\n\n";
+
+  file << "[meta]\n";
+  file << "sizeX = " << baseParams.gridSize_X << "\n";
+  file << "sizeY = " << baseParams.gridSize_Y << "\n";
+  file << "population = " << baseParams.population << "\n";
+  file << "stepsPerGeneration = " << baseParams.stepsPerGeneration << "\n";
+  file << "numThreads = " << baseParams.numThreads << "\n\n";
+
+  for (const auto& result : results) {
+    const auto& stats = result.stats;
+    file << fmt::format("[scenarios.{}]\n", result.scenario);
+    file << fmt::format("generations = {}\n", stats.generations);
+    file << fmt::format("agent_steps = {}\n", stats.agentSteps);
+    file << fmt::format("wall_seconds = {:e}\n", stats.wallSeconds);
+    file << fmt::format("{} = {:e}\n", METRIC_AGENT_STEPS, stats.agentStepsPerSecond());
+    file << fmt::format("{} = {:e}\n", METRIC_GENERATIONS, stats.generationsPerSecond());
+    file << fmt::format("{} = {}\n\n", METRIC_PEAK_RSS, result.peakRssBytes);
+
+    file << fmt::format("[scenarios.{}.phase_seconds]\n", result.scenario);
+    for (unsigned phase = 0; phase < NUM_PHASES; ++phase) {
+      file << fmt::format("{} = {:e}\n", phaseName(static_cast<Phase>(phase)), stats.phaseSeconds[phase]);
+    }
+    file << "\n";
+
+    if (stats.video.workers > 0) {
+      file << fmt::format("[scenarios.{}.video_pipeline]\n", result.scenario);
+      file << fmt::format("workers = {}\n", stats.video.workers);
+      file << fmt::format("frames = {}\n", stats.video.frames);
+      file << fmt::format("skipped_steps = {}\n", stats.video.skippedSteps);
+      file << fmt::format("triggered_frames = {}\n", stats.video.triggeredFrames);
+      file << fmt::format("videos = {}\n", stats.video.videos);
+      file << fmt::format("frames_per_second = {:e}\n", stats.video.framesPerSecond());
+      file << fmt::format("utilization = {:e}\n", stats.video.utilization());
+      file << fmt::format("stalled_captures = {}\n", stats.video.stalledCaptures);
+      file << fmt::format("stall_seconds = {:e}\n", stats.video.stallSeconds);
+      file << fmt::format("peak_buffered_bytes = {}\n\n", stats.video.peakBufferedBytes);
+    }
+  }
+
+  Logger::success("Benchmark baseline written to {}", path);
+}
+
+std::vector<BenchmarkComparison> BenchmarkRunner::compareToBaseline(const std::vector<BenchmarkResult>& results,
+                                                                    const Params& baseParams, const std::string& path,
+                                                                    const BenchmarkThresholds& thresholds) {
+  std::vector<BenchmarkComparison> comparisons;
+
+  toml::value data;
+  try {
+    data = toml::parse(path);
+  } catch (const std::exception& e) {
+    throw std::runtime_error("Failed to parse benchmark baseline " + path + ": " + e.what());
+  }
+
+  if (data.contains("meta")) {
+    const auto& meta = toml::find(data, "meta");
+    auto differs = [&meta](const char* key, unsigned value) {
+      return toml::find_or<int64_t>(meta, key, -1) != static_cast<int64_t>(value);
+    };
+    if (differs("sizeX", baseParams.gridSize_X) || differs("sizeY", baseParams.gridSize_Y) ||
+        differs("population", baseParams.population) ||
+        differs("stepsPerGeneration", baseParams.stepsPerGeneration) ||
+        differs("numThreads", baseParams.numThreads)) {
+      Logger::warning("Baseline {} was recorded with different world/population/thread settings", path);
+    }
+  }
+
+  if (!data.contains("scenarios")) {
+    Logger::warning("Baseline {} contains no scenarios", path);
+    return comparisons;
+  }
+  const auto& scenarios = toml::find(data, "scenarios");
+
+  for (const auto& result : results) {
+    if (!scenarios.contains(result.scenario)) {
+      Logger::warning("Scenario {} not in baseline, skipping", result.scenario);
+      continue;
+    }
+    const auto& entry = toml::find(scenarios, result.scenario);
+
+    auto addThroughput = [&](const char* metric, double current) {
+      BenchmarkComparison cmp;
+      cmp.scenario = result.scenario;
+      cmp.metric = metric;
+      cmp.baseline = toml::find<double>(entry, metric);
+      cmp.current = current;
+      cmp.changePercent = percentChange(cmp.baseline, cmp.current);
+      cmp.regression = cmp.changePercent < -thresholds.maxSlowdownPercent;
+      comparisons.push_back(cmp);
+    };
+    addThroughput(METRIC_AGENT_STEPS, result.stats.agentStepsPerSecond());
+    addThroughput(METRIC_GENERATIONS, result.stats.generationsPerSecond());
+
+    BenchmarkComparison rss;
+    rss.scenario = result.scenario;
+    rss.metric = METRIC_PEAK_RSS;
+    rss.baseline = static_cast<double>(toml::find<int64_t>(entry, METRIC_PEAK_RSS));
+    rss.current = static_cast<double>(result.peakRssBytes);
+    rss.changePercent = percentChange(rss.baseline, rss.current);
+    rss.regression = rss.changePercent > thresholds.maxRssGrowthPercent;
+    comparisons.push_back(rss);
+  }
+
+  return comparisons;
+}
+
+bool BenchmarkRunner::printComparison(const std::vector<BenchmarkComparison>& comparisons) {
+  Logger::header("\n📈 Comparison against baseline");
+  fmt::print("{:<28} {:<22} {:>14} {:>14} {:>9}\n", "scenario", "metric", "baseline", "current", "change");
+
+  unsigned regressions = 0;
+  for (const auto& cmp : comparisons) {
+    fmt::print("{:<28} {:<22} {:>14.4g} {:>14.4g} {:>+8.1f}%{}\n", cmp.scenario, cmp.metric, cmp.baseline, cmp.current,
+               cmp.changePercent, cmp.regression ? "  ✗ REGRESSION" : "");
+    if (cmp.regression) {
+      ++regressions;
+    }
+  }
+
+  if (regressions > 0) {
+    Logger::error("{} benchmark metric(s) regressed beyond threshold", regressions);
+    Logger::log_error("Benchmark: {} metric(s) regressed beyond threshold", regressions);
+  } else {
+    Logger::success("No regressions against baseline");
+  }
+  return regressions > 0;
+}
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
@@ -0,0 +1,154 @@
+#ifndef BIOSIM4_SRC_CORE_SIMULATION_BENCHMARKRUNNER_H_
+#define BIOSIM4_SRC_CORE_SIMULATION_BENCHMARKRUNNER_H_
+
+/**
+ * @file benchmarkRunner.h
+ * @brief End-to-end throughput benchmark mode (`biosim4 --benchmark`)
+ *
+ * Runs a fixed set of scenarios (every challenge with and without barriers,
+ * plus a signal-heavy world) through the real simulator() with the
+ * deterministic RNG, and reports agent-steps/s, generations/s, peak RSS and
+ * the per-phase time split. Results can be saved as a TOML baseline and later
+ * runs compared against it with regression thresholds.
+ */
+
+#include "../../types/params.h"
+#include "simulationStats.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+/**
+ * @struct BenchmarkScenario
+ * @brief One standardized workload: a name and the overrides it applies
+ */
+struct BenchmarkScenario {
+  std::string name;                           ///< Stable identifier used in reports and baselines
+  std::function<void(Types::Params&)> apply;  ///< Overrides applied on top of the base params
+};
+
+/**
+ * @struct BenchmarkResult
+ * @brief Measurements for one scenario
+ */
+struct BenchmarkResult {
+  std::string scenario;     ///< Scenario name
+  SimulationStats stats;    ///< Throughput and per-phase timing
+  size_t peakRssBytes = 0;  ///< Peak resident set size during the scenario
+};
+
+/**
+ * @struct BenchmarkThresholds
+ * @brief Allowed change versus the baseline before a run counts as a regression
+ */
+struct BenchmarkThresholds {
+  double maxSlowdownPercent = 10.0;   ///< Max drop in agent-steps/s or generations/s
+  double maxRssGrowthPercent = 10.0;  ///< Max growth in peak RSS
+};
+
+/**
+ * @struct BenchmarkComparison
+ * @brief One gated metric of one scenario compared against the baseline
+ */
+struct BenchmarkComparison {
+  std::string scenario;        ///< Scenario name
+  std::string metric;          ///< Metric key (as stored in the baseline file)
+  double baseline = 0.0;       ///< Baseline value
+  double current = 0.0;        ///< Value measured in this run
+  double changePercent = 0.0;  ///< Signed change; positive = better for throughput, worse for RSS
+  bool regression = false;     ///< True if the change exceeds its threshold
+};
+
+/**
+ * @class BenchmarkRunner
+ * @brief Runs, reports, saves and compares standardized benchmark scenarios
+ */
+class BenchmarkRunner {
+ public:
+  /**
+   * @brief The standard scenario set
+   *
+   * Every challenge on an open arena and with floating-island barriers, plus
+   * "signal-heavy" (dense population, two pheromone layers, wide sensor radius).
+   */
+  static std::vector<BenchmarkScenario> standardScenarios();
+
+  /**
+   * @brief Run all scenarios whose name contains @p filter
+   *
+   * The base params are taken as-is (so presets and --set apply) except that
+   * video, graph logging and genome dumps are disabled and the deterministic
+   * RNG is forced on.
+   *
+   * @param baseParams Parameters every scenario starts from
+   * @param filter Substring a scenario name must contain (empty = all)
+   * @param generations Generations to execute per scenario (including restarts)
+   * @return One result per executed scenario, in scenario order
+   */
+  static std::vector<BenchmarkResult> run(const Types::Params& baseParams, const std::string& filter,
+                                          unsigned generations);
+
+  /**
+   * @brief Print the throughput / memory / phase table
+   * @param results Results from run()
+   */
+  static void printReport(const std::vector<BenchmarkResult>& results);
+
+  /**
+   * @brief Write results as a TOML baseline file
+   * @param results Results from run()
+   * @param baseParams Base params (recorded so mismatched baselines can be detected)
+   * @param path Output file path
+   * @throws std::runtime_error if the file cannot be written
+   */
+  static void saveBaseline(const std::vector<BenchmarkResult>& results, const Types::Params& baseParams,
+                           const std::string& path);
+
+  /**
+   * @brief Compare results against a baseline file
+   *
+   * Scenarios missing from the baseline are skipped. A warning is printed if
+   * the baseline was recorded with a different world size, population, step
+   * count or thread count.
+   *
+   * @param results Results from run()
+   * @param baseParams Base params of this run
+   * @param path Baseline file written by saveBaseline()
+   * @param thresholds Regression limits
+   * @return One entry per gated metric per scenario
+   * @throws std::runtime_error if the baseline cannot be parsed
+   */
+  static std::vector<BenchmarkComparison> compareToBaseline(const std::vector<BenchmarkResult>& results,
+                                                            const Types::Params& baseParams, const std::string& path,
+                                                            const BenchmarkThresholds& thresholds);
+
+  /**
+   * @brief Print the comparison table
+   * @param comparisons Output of compareToBaseline()
+   * @return true if any metric regressed
+   */
+  static bool printComparison(const std::vector<BenchmarkComparison>& comparisons);
+};
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
+
+// Backward compatibility aliases
+namespace BioSim {
+using Core::Simulation::BenchmarkComparison;
+using Core::Simulation::BenchmarkResult;
+using Core::Simulation::BenchmarkRunner;
+using Core::Simulation::BenchmarkScenario;
+using Core::Simulation::BenchmarkThresholds;
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_CORE_SIMULATION_BENCHMARKRUNNER_H_
@@ -0,0 +1,115 @@
+/**
+ * @file challengeEffects.cpp
+ * @brief Per-step challenge effects, evaluated inside the parallel agent step
+ *
+ * These are the agentStep() hooks of the challenges that act during a
+ * generation rather than only at its end. Each runs right after an agent has
+ * queued its actions, on the thread that stepped the agent, so it may only
+ * write to that agent and queue deaths. Locations do not change until the
+ * move queue is drained, so the hooks see the same world as a pass over the
+ * population at the end of the step would.
+ */
+
+#include "challenges.h"
+#include "simulator.h"
+
+#include <cmath>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+using Agents::Individual;
+
+/**
+ * @brief CHALLENGE_RADIOACTIVE_WALLS per-step effect: radiation deaths
+ *
+ * Radioactive wall challenge implements time-varying environmental hazard:
+ * - First half of generation: West wall (X=0) is radioactive
+ * - Second half of generation: East wall (X=gridSize_X-1) is radioactive
+ *
+ * Death probability follows inverse distance relationship:
+ *   P(death) = 1 / distance_from_wall
+ *
+ * Radioactivity has exponential falloff, reaching zero at arena midline.
+ * This creates selective pressure for individuals to migrate away from
+ * the currently active radioactive wall.
+ *
+ * The dice come from the stepping thread's randomUint, and deaths are queued
+ * as environment deaths so they are not counted as murders.
+ */
+void RadioactiveWallsChallenge::agentStep(Individual& indiv, unsigned simStep) {
+  // Determine which wall is currently radioactive based on generation progress
+  int16_t radioactiveX =
+      (simStep < parameterMngrSingleton.stepsPerGeneration / 2) ? 0 : parameterMngrSingleton.gridSize_X - 1;
+
+  // Calculate Manhattan distance from the radioactive wall
+  int16_t distanceFromRadioactiveWall = std::abs(indiv.loc.x - radioactiveX);
+
+  // Only apply radiation within half-arena radius (exponential falloff zone)
+  if (distanceFromRadioactiveWall < parameterMngrSingleton.gridSize_X / 2) {
+    // Death probability = 1/distance (closer = more dangerous)
+    float chanceOfDeath = 1.0 / distanceFromRadioactiveWall;
+
+    // Roll dice to determine if individual dies from radiation exposure
+    if (randomUint() / (float)RANDOM_UINT_MAX < chanceOfDeath) {
+      peeps.queueForEnvironmentDeath(indiv);
+    }
+  }
+}
+
+/**
+ * @brief CHALLENGE_TOUCH_ANY_WALL per-step effect: flag wall contact
+ *
+ * Touch-any-wall challenge rewards individuals that reach arena boundaries.
+ * Sets challengeFlag=true for any individual touching a wall (X or Y boundary).
+ * At generation end, flagged individuals are selected for reproduction.
+ * This creates selective pressure for navigation to arena edges.
+ */
+void TouchAnyWallChallenge::agentStep(Individual& indiv, unsigned /*simStep*/) {
+  // Check if individual is touching any of the four arena boundaries
+  if (indiv.loc.x == 0 || indiv.loc.x == parameterMngrSingleton.gridSize_X - 1 || indiv.loc.y == 0 ||
+      indiv.loc.y == parameterMngrSingleton.gridSize_Y - 1) {
+    indiv.challengeBits = true;  // Mark as successful for reproduction
+  }
+}
+
+/**
+ * @brief CHALLENGE_LOCATION_SEQUENCE per-step effect: record barrier visits
+ *
+ * Location sequence challenge requires individuals to visit barrier centers
+ * in a specific sequential order. Each barrier has a corresponding bit in
+ * challengeBits, and bits are set only when barriers are visited in order.
+ *
+ * Implementation details:
+ * - Barrier centers are defined in grid.getBarrierCenters()
+ * - Proximity threshold: radius = 9.0 grid units
+ * - Bit n is set only if bits 0..(n-1) are already set (enforces ordering)
+ * - Loop breaks after checking first unvisited barrier (optimization)
+ *
+ * This creates selective pressure for path planning and sequential navigation.
+ */
+void LocationSequenceChallenge::agentStep(Individual& indiv, unsigned /*simStep*/) {
+  float radius = 9.0;  // Proximity threshold for "visiting" a barrier center
+
+  // Check each barrier in sequence (order matters!)
+  for (unsigned n = 0; n < grid.getBarrierCenters().size(); ++n) {
+    unsigned bit = 1 << n;  // Bit mask for barrier n
+
+    // Only check unvisited barriers (bit not yet set)
+    if ((indiv.challengeBits & bit) == 0) {
+      // Check if individual is within proximity radius of barrier center
+      if ((indiv.loc - grid.getBarrierCenters()[n]).length() <= radius) {
+        indiv.challengeBits |= bit;  // Set bit to mark this barrier as visited
+      }
+      // Break after first unvisited barrier (enforces sequential order)
+      break;
+    }
+  }
+}
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
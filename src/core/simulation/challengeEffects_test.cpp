@@ -0,0 +1,139 @@
+/**
+ * @file challengeEffects_test.cpp
+ * @brief Tests for the per-step challenge hooks.
+ */
+
+#include "challenges.h"
+#include "simulator.h"
+
+#include <gtest/gtest.h>
+
+namespace BioSim {
+
+using Core::Simulation::LocationSequenceChallenge;
+using Core::Simulation::RadioactiveWallsChallenge;
+using Core::Simulation::TouchAnyWallChallenge;
+
+namespace {
+
+constexpr uint16_t SIZE_X = 64;
+constexpr uint16_t SIZE_Y = 120;
+
+/** @brief Empty world of SIZE_X x SIZE_Y with the given barrier type */
+void initWorld(unsigned barrierType) {
+  initParamsForTesting(SIZE_X, SIZE_Y);
+  grid.initialize(SIZE_X, SIZE_Y);
+  grid.createBarrier(barrierType);
+  peeps.initialize(parameterMngrSingleton.population);
+}
+
+/** @brief Place living individual `index` on the grid at (x, y) */
+Individual& place(uint16_t index, int16_t x, int16_t y) {
+  Individual& indiv = peeps[index];
+  indiv.index = index;
+  indiv.alive = true;
+  indiv.challengeBits = 0;
+  indiv.loc = Coordinate(x, y);
+  grid.set(indiv.loc, index);
+  return indiv;
+}
+
+}  // namespace
+
+TEST(ChallengeEffectsTest, TouchAnyWallFlagsEveryBoundaryAndKeepsTheFlag) {
+  initWorld(0);
+
+  Individual& indiv = place(1, 10, 10);
+  TouchAnyWallChallenge::agentStep(indiv, 0);
+  EXPECT_EQ(indiv.challengeBits, 0u);
+
+  const Coordinate walls[] = {Coordinate(0, 10), Coordinate(SIZE_X - 1, 10), Coordinate(10, 0),
+                              Coordinate(10, SIZE_Y - 1)};
+  for (const Coordinate& wall : walls) {
+    indiv.challengeBits = 0;
+    indiv.loc = wall;
+    TouchAnyWallChallenge::agentStep(indiv, 0);
+    EXPECT_NE(indiv.challengeBits, 0u) << "wall at " << wall.x << "," << wall.y;
+  }
+
+  // Leaving the wall does not clear the flag
+  indiv.loc = Coordinate(10, 10);
+  TouchAnyWallChallenge::agentStep(indiv, 1);
+  EXPECT_NE(indiv.challengeBits, 0u);
+}
+
+TEST(ChallengeEffectsTest, LocationSequenceOnlyCountsBarriersVisitedInOrder) {
+  // Barrier type 6: five spots at (SIZE_X / 2, 20 * n), n = 1..5
+  initWorld(6);
+  ASSERT_EQ(grid.getBarrierCenters().size(), 5u);
+  ASSERT_EQ(grid.getBarrierCenters()[1], Coordinate(SIZE_X / 2, 40));
+
+  Individual& indiv = place(1, 40, 40);
+
+  // Next to the second spot before the first: the loop stops at the first unvisited spot
+  LocationSequenceChallenge::agentStep(indiv, 0);
+  EXPECT_EQ(indiv.challengeBits, 0u);
+
+  indiv.loc = Coordinate(40, 20);
+  LocationSequenceChallenge::agentStep(indiv, 1);
+  EXPECT_EQ(indiv.challengeBits, 0b1u);
+
+  // Skipping ahead to the third spot still counts nothing
+  indiv.loc = Coordinate(40, 60);
+  LocationSequenceChallenge::agentStep(indiv, 2);
+  EXPECT_EQ(indiv.challengeBits, 0b1u);
+
+  indiv.loc = Coordinate(40, 40);
+  LocationSequenceChallenge::agentStep(indiv, 3);
+  EXPECT_EQ(indiv.challengeBits, 0b11u);
+
+  indiv.loc = Coordinate(40, 60);
+  LocationSequenceChallenge::agentStep(indiv, 4);
+  EXPECT_EQ(indiv.challengeBits, 0b111u);
+
+  // Away from every spot nothing changes
+  indiv.loc = Coordinate(5, 5);
+  LocationSequenceChallenge::agentStep(indiv, 5);
+  EXPECT_EQ(indiv.challengeBits, 0b111u);
+}
+
+TEST(ChallengeEffectsTest, RadioactiveWallDeathsAreEnvironmentDeaths) {
+  initWorld(0);
+  const unsigned halfway = parameterMngrSingleton.stepsPerGeneration / 2;
+
+  Individual& westWall = place(1, 0, 10);
+  Individual& eastWall = place(2, SIZE_X - 1, 20);
+  Individual& eastHalf = place(3, SIZE_X - 10, 30);
+  Individual& victim = place(4, 10, 40);
+
+  // West wall in the first half of the generation, east wall in the second;
+  // on the wall itself death is certain, beyond the midline impossible
+  RadioactiveWallsChallenge::agentStep(eastWall, 0);
+  RadioactiveWallsChallenge::agentStep(eastHalf, 0);
+  EXPECT_EQ(peeps.deathQueueSize(), 0u);
+  RadioactiveWallsChallenge::agentStep(westWall, 0);
+  EXPECT_EQ(peeps.deathQueueSize(), 1u);
+  RadioactiveWallsChallenge::agentStep(victim, halfway);
+  EXPECT_EQ(peeps.deathQueueSize(), 1u);
+  RadioactiveWallsChallenge::agentStep(eastWall, halfway);
+  EXPECT_EQ(peeps.deathQueueSize(), 2u);
+
+  // Radiation is not murder
+  EXPECT_EQ(peeps.murderQueueSize(), 0u);
+  peeps.queueForDeath(victim);
+  EXPECT_EQ(peeps.deathQueueSize(), 3u);
+  EXPECT_EQ(peeps.murderQueueSize(), 1u);
+
+  peeps.drainDeathQueue();
+  EXPECT_FALSE(peeps[1].alive);
+  EXPECT_FALSE(peeps[2].alive);
+  EXPECT_TRUE(peeps[3].alive);
+  EXPECT_FALSE(peeps[4].alive);
+  EXPECT_TRUE(grid.isEmptyAt(Coordinate(0, 10)));
+  EXPECT_TRUE(grid.isEmptyAt(Coordinate(SIZE_X - 1, 20)));
+  EXPECT_EQ(grid.at(Coordinate(SIZE_X - 10, 30)), 3u);
+  EXPECT_EQ(peeps.deathQueueSize(), 0u);
+  EXPECT_EQ(peeps.murderQueueSize(), 0u);
+}
+
+}  // namespace BioSim
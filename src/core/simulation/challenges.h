@@ -0,0 +1,221 @@
+#ifndef BIOSIM4_SRC_CORE_SIMULATION_CHALLENGES_H_
+#define BIOSIM4_SRC_CORE_SIMULATION_CHALLENGES_H_
+
+/**
+ * @file challenges.h
+ * @brief Compile-time registry of survival challenges
+ *
+ * Every challenge is a type with a CHALLENGE_* id and two hooks:
+ * - `survival(indiv)`: end-of-generation hook, the survival criterion
+ *   (see survival-criteria.cpp)
+ * - `agentStep(indiv, simStep)`: per-step hook run inside the parallel agent
+ *   step for each living agent, right after its actions are queued
+ *   (see challengeEffects.cpp)
+ *
+ * ChallengeBase supplies a no-op agentStep(). visitChallenge() turns the runtime
+ * challenge id into its type once; callers keep a function pointer to code
+ * instantiated for that type, so the per-agent loops never test the id.
+ *
+ * Adding a challenge means defining its type and appending it to Challenges;
+ * the code generated for the other challenges does not change.
+ */
+
+#include "../agents/indiv.h"
+#include "simulator.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+/**
+ * @struct ChallengeBase
+ * @brief Defaults for the optional parts of a challenge
+ */
+struct ChallengeBase {
+  static constexpr bool usesNeighborCounts = false;  ///< survival() reads neighborCounts
+
+  /// Per-step hook, called concurrently for different agents
+  static void agentStep(Agents::Individual& /*indiv*/, unsigned /*simStep*/) {}
+};
+
+/// Challenges judged only by where the individual ends the generation
+struct CircleChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_CIRCLE;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct RightHalfChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_RIGHT_HALF;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct RightQuarterChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_RIGHT_QUARTER;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct LeftEighthChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_LEFT_EIGHTH;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct CenterWeightedChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_CENTER_WEIGHTED;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct CenterUnweightedChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_CENTER_UNWEIGHTED;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct CornerChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_CORNER;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct CornerWeightedChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_CORNER_WEIGHTED;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct AgainstAnyWallChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_AGAINST_ANY_WALL;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct MigrateDistanceChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_MIGRATE_DISTANCE;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct EastWestEighthsChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_EAST_WEST_EIGHTHS;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct NearBarrierChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_NEAR_BARRIER;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct AltruismChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_ALTRUISM;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct AltruismSacrificeChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_ALTRUISM_SACRIFICE;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+/// Density challenges: survival() reads neighborCounts
+struct StringChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_STRING;
+  static constexpr bool usesNeighborCounts = true;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct CenterSparseChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_CENTER_SPARSE;
+  static constexpr bool usesNeighborCounts = true;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+struct PairsChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_PAIRS;
+  static constexpr bool usesNeighborCounts = true;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+};
+
+/// Challenges with effects during the generation (see challengeEffects.cpp)
+struct RadioactiveWallsChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_RADIOACTIVE_WALLS;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+  static void agentStep(Agents::Individual& indiv, unsigned simStep);
+};
+
+struct TouchAnyWallChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_TOUCH_ANY_WALL;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+  static void agentStep(Agents::Individual& indiv, unsigned simStep);
+};
+
+struct LocationSequenceChallenge : ChallengeBase {
+  static constexpr unsigned id = CHALLENGE_LOCATION_SEQUENCE;
+  static std::pair<bool, float> survival(const Agents::Individual& indiv);
+  static void agentStep(Agents::Individual& indiv, unsigned simStep);
+};
+
+/// Type list of challenges
+template <typename... Types>
+struct ChallengeList {};
+
+/// Every challenge the simulator knows
+using Challenges =
+    ChallengeList<CircleChallenge, RightHalfChallenge, RightQuarterChallenge, StringChallenge, CenterWeightedChallenge,
+                  CenterUnweightedChallenge, CornerChallenge, CornerWeightedChallenge, MigrateDistanceChallenge,
+                  CenterSparseChallenge, LeftEighthChallenge, RadioactiveWallsChallenge, AgainstAnyWallChallenge,
+                  TouchAnyWallChallenge, EastWestEighthsChallenge, NearBarrierChallenge, PairsChallenge,
+                  LocationSequenceChallenge, AltruismChallenge, AltruismSacrificeChallenge>;
+
+/// Empty value that carries a challenge type into a generic lambda
+template <typename Challenge>
+struct ChallengeTag {
+  using type = Challenge;
+};
+
+namespace Detail {
+
+template <typename Visitor, typename First, typename... Rest>
+decltype(auto) visitChallenge(unsigned challenge, Visitor&& visitor, ChallengeList<First, Rest...>) {
+  if (challenge == First::id) {
+    return visitor(ChallengeTag<First>{});
+  }
+  if constexpr (sizeof...(Rest) > 0) {
+    return visitChallenge(challenge, std::forward<Visitor>(visitor), ChallengeList<Rest...>{});
+  } else {
+    throw std::invalid_argument("Unknown challenge " + std::to_string(challenge));
+  }
+}
+
+}  // namespace Detail
+
+/**
+ * @brief Call a visitor with the type of a challenge
+ *
+ * Meant to be called once per selection, not per agent: the visitor typically
+ * returns a pointer to a function template instantiated for the challenge.
+ *
+ * @param challenge CHALLENGE_* id
+ * @param visitor Generic callable taking a ChallengeTag; every instantiation must return the same type
+ * @return What the visitor returned
+ * @throws std::invalid_argument if no challenge has this id
+ */
+template <typename Visitor>
+decltype(auto) visitChallenge(unsigned challenge, Visitor&& visitor) {
+  return Detail::visitChallenge(challenge, std::forward<Visitor>(visitor), Challenges{});
+}
+
+/// Survival criterion of one challenge; dead individuals always fail
+using SurvivalCriterion = std::pair<bool, float> (*)(const Agents::Individual& indiv);
+
+/**
+ * @brief Select a challenge's survival criterion
+ * @param challenge CHALLENGE_* id
+ * @return Criterion instantiated for that challenge
+ * @throws std::invalid_argument if no challenge has this id
+ */
+SurvivalCriterion survivalCriterion(unsigned challenge);
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_CORE_SIMULATION_CHALLENGES_H_
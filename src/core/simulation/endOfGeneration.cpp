@@ -6,6 +6,7 @@
  * is called once per generation to perform cleanup and output tasks.
  */
 
+#include "../../io/metrics/metricsWriter.h"
 #include "../../io/video/imageWriter.h"
 #include "simulator.h"
 
@@ -20,6 +21,7 @@ inline namespace v1 {
 namespace Core {
 namespace Simulation {
 
+using IO::Metrics::metricsWriter;
 using IO::Video::imageWriter;
 
 /**
@@ -34,7 +36,7 @@ using IO::Video::imageWriter;
  * - Saves videos during parameter change periods for comparison
  *
  * **Log Updates:**
- * - Updates graphical statistics logs via external command execution
+ * - Flushes the metrics log, then updates graphical statistics via external command execution
  * - Applies update stride to control log refresh frequency
  *
  * @param generation The generation number that has just completed (0-based).
@@ -81,6 +83,8 @@ void endOfGeneration(unsigned generation) {
     /// Check if graphical logs should be updated this generation
     if (parameterMngrSingleton.updateGraphLog &&
         (generation == 1 || ((generation % parameterMngrSingleton.updateGraphLogStride) == 0))) {
+      /// The plot reads the metrics log, so wait for the writer thread to catch up
+      metricsWriter.flush();
 #pragma GCC diagnostic ignored "-Wunused-result"
       /// Execute external command to refresh graphical statistics (e.g., gnuplot)
       std::system(parameterMngrSingleton.graphLogUpdateCommand.c_str());
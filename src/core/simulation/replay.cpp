@@ -0,0 +1,249 @@
+/**
+ * @file replay.cpp
+ * @brief Checkpoint file format and the replay recorder
+ *
+ * replayGeneration() lives in simulator.cpp next to simulator(), whose
+ * generation loop it mirrors.
+ */
+
+#include "replay.h"
+
+#include "../../utils/logger.h"
+
+#include <omp.h>
+#include <spdlog/fmt/fmt.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <type_traits>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+using Genetics::Gene;
+using Genetics::Genome;
+using Utils::Logger;
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[8] = {'B', '4', 'R', 'E', 'P', 'L', 'A', 'Y'};
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+/**
+ * @struct CheckpointHeader
+ * @brief Fixed-size start of a checkpoint file
+ */
+struct CheckpointHeader {
+  char magic[8];                ///< CHECKPOINT_MAGIC
+  uint32_t version;             ///< CHECKPOINT_VERSION
+  uint32_t generation;          ///< Generation the checkpoint starts
+  uint32_t population;          ///< Individuals per generation
+  uint16_t gridSizeX;           ///< Grid width
+  uint16_t gridSizeY;           ///< Grid height
+  uint32_t stepsPerGeneration;  ///< Steps per generation
+  uint32_t challenge;           ///< Active challenge
+  uint32_t barrierType;         ///< Barrier layout
+  uint32_t threadCount;         ///< Thread stream states that follow the spawn state
+  uint32_t parentCount;         ///< Parent genomes that follow the stream states
+};
+
+static_assert(sizeof(CheckpointHeader) == 44, "CheckpointHeader must not contain padding");
+static_assert(std::is_trivially_copyable_v<Gene>, "Genes are written as raw bytes");
+static_assert(std::is_trivially_copyable_v<RandomUintGenerator::State>, "Stream states are written as raw bytes");
+
+/** @brief Closes a FILE* when it goes out of scope */
+struct FileCloser {
+  void operator()(std::FILE* file) const { std::fclose(file); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+bool writeBytes(std::FILE* file, const void* data, size_t size) {
+  return size == 0 || std::fwrite(data, size, 1, file) == 1;
+}
+
+bool readBytes(std::FILE* file, void* data, size_t size) {
+  return size == 0 || std::fread(data, size, 1, file) == 1;
+}
+
+}  // namespace
+
+ReplayRecorder replayRecorder;
+
+bool GenerationCheckpoint::matches(const Types::Params& p, std::string& reason) const {
+  if (population != p.population) {
+    reason = fmt::format("population {} (run uses {})", population, p.population);
+  } else if (gridSizeX != p.gridSize_X || gridSizeY != p.gridSize_Y) {
+    reason = fmt::format("grid {}x{} (run uses {}x{})", gridSizeX, gridSizeY, p.gridSize_X, p.gridSize_Y);
+  } else if (stepsPerGeneration != p.stepsPerGeneration) {
+    reason = fmt::format("stepsPerGeneration {} (run uses {})", stepsPerGeneration, p.stepsPerGeneration);
+  } else if (challenge != p.challenge) {
+    reason = fmt::format("challenge {} (run uses {})", challenge, p.challenge);
+  } else if (barrierType != p.barrierType) {
+    reason = fmt::format("barrierType {} (run uses {})", barrierType, p.barrierType);
+  } else {
+    return true;
+  }
+  return false;
+}
+
+std::string checkpointPath(const std::string& replayDir, unsigned generation) {
+  return (std::filesystem::path(replayDir) / fmt::format("gen-{:06d}.b4r", generation)).string();
+}
+
+bool saveCheckpoint(const std::string& path, const GenerationCheckpoint& checkpoint) {
+  // Write to a temporary name first so an interrupted run never leaves a truncated checkpoint
+  const std::string tempPath = path + ".tmp";
+  {
+    FilePtr file(std::fopen(tempPath.c_str(), "wb"));
+    if (!file) {
+      Logger::warning("Cannot write replay checkpoint {}", tempPath);
+      return false;
+    }
+
+    CheckpointHeader header{};
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_VERSION;
+    header.generation = checkpoint.generation;
+    header.population = checkpoint.population;
+    header.gridSizeX = checkpoint.gridSizeX;
+    header.gridSizeY = checkpoint.gridSizeY;
+    header.stepsPerGeneration = checkpoint.stepsPerGeneration;
+    header.challenge = checkpoint.challenge;
+    header.barrierType = checkpoint.barrierType;
+    header.threadCount = static_cast<uint32_t>(checkpoint.threadRng.size());
+    header.parentCount = static_cast<uint32_t>(checkpoint.parents.size());
+
+    bool ok = writeBytes(file.get(), &header, sizeof(header)) &&
+              writeBytes(file.get(), &checkpoint.spawnRng, sizeof(checkpoint.spawnRng)) &&
+              writeBytes(file.get(), checkpoint.threadRng.data(),
+                         checkpoint.threadRng.size() * sizeof(RandomUintGenerator::State));
+    for (const Genome& genome : checkpoint.parents) {
+      const uint32_t geneCount = static_cast<uint32_t>(genome.size());
+      ok = ok && writeBytes(file.get(), &geneCount, sizeof(geneCount)) &&
+           writeBytes(file.get(), genome.data(), genome.size() * sizeof(Gene));
+    }
+    if (!ok || std::fflush(file.get()) != 0) {
+      Logger::warning("Failed writing replay checkpoint {}", tempPath);
+      file.reset();
+      std::remove(tempPath.c_str());
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, path, ec);
+  if (ec) {
+    Logger::warning("Cannot replace replay checkpoint {}: {}", path, ec.message());
+    std::remove(tempPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool loadCheckpoint(const std::string& path, GenerationCheckpoint& checkpoint) {
+  FilePtr file(std::fopen(path.c_str(), "rb"));
+  if (!file) {
+    Logger::error("Cannot open replay checkpoint {}", path);
+    return false;
+  }
+
+  CheckpointHeader header{};
+  if (!readBytes(file.get(), &header, sizeof(header)) ||
+      std::memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0) {
+    Logger::error("{} is not a replay checkpoint", path);
+    return false;
+  }
+  if (header.version != CHECKPOINT_VERSION) {
+    Logger::error("{}: unsupported checkpoint version {}", path, header.version);
+    return false;
+  }
+
+  // Bound every count by the file size before allocating
+  std::error_code ec;
+  const uintmax_t fileSize = std::filesystem::file_size(path, ec);
+  const uintmax_t stateBytes = (uintmax_t(header.threadCount) + 1) * sizeof(RandomUintGenerator::State);
+  if (ec || sizeof(header) + stateBytes + uintmax_t(header.parentCount) * sizeof(uint32_t) > fileSize) {
+    Logger::error("{}: truncated replay checkpoint", path);
+    return false;
+  }
+
+  checkpoint.generation = header.generation;
+  checkpoint.population = header.population;
+  checkpoint.gridSizeX = header.gridSizeX;
+  checkpoint.gridSizeY = header.gridSizeY;
+  checkpoint.stepsPerGeneration = header.stepsPerGeneration;
+  checkpoint.challenge = header.challenge;
+  checkpoint.barrierType = header.barrierType;
+  checkpoint.threadRng.resize(header.threadCount);
+  checkpoint.parents.assign(header.parentCount, Genome{});
+
+  bool ok = readBytes(file.get(), &checkpoint.spawnRng, sizeof(checkpoint.spawnRng)) &&
+            readBytes(file.get(), checkpoint.threadRng.data(),
+                      checkpoint.threadRng.size() * sizeof(RandomUintGenerator::State));
+  uintmax_t offset = sizeof(header) + stateBytes;
+  for (Genome& genome : checkpoint.parents) {
+    uint32_t geneCount = 0;
+    ok = ok && readBytes(file.get(), &geneCount, sizeof(geneCount));
+    offset += sizeof(geneCount) + uintmax_t(geneCount) * sizeof(Gene);
+    if (!ok || offset > fileSize) {
+      ok = false;
+      break;
+    }
+    genome.resize(geneCount);
+    ok = readBytes(file.get(), genome.data(), genome.size() * sizeof(Gene));
+  }
+  if (!ok) {
+    Logger::error("{}: truncated replay checkpoint", path);
+    return false;
+  }
+  return true;
+}
+
+void ReplayRecorder::start(const Types::Params& params) {
+  std::error_code ec;
+  std::filesystem::create_directories(params.replayDir, ec);
+  if (ec) {
+    Logger::warning("Cannot create replay directory {}: {}; checkpoints disabled", params.replayDir, ec.message());
+    active_ = false;
+    return;
+  }
+  active_ = true;
+  replayDir_ = params.replayDir;
+  pending_ = GenerationCheckpoint{};
+  pending_.population = params.population;
+  pending_.gridSizeX = params.gridSize_X;
+  pending_.gridSizeY = params.gridSize_Y;
+  pending_.stepsPerGeneration = params.stepsPerGeneration;
+  pending_.challenge = params.challenge;
+  pending_.barrierType = params.barrierType;
+  const unsigned threads = params.numThreads > 0 ? params.numThreads : static_cast<unsigned>(omp_get_max_threads());
+  pending_.threadRng.assign(threads, RandomUintGenerator::State{});
+}
+
+void ReplayRecorder::beginGeneration(unsigned generation, const std::vector<Genome>& parents) {
+  pending_.generation = generation;
+  pending_.spawnRng = randomUint.state();
+  pending_.parents = parents;
+}
+
+void ReplayRecorder::captureThread(unsigned threadNum) {
+  if (threadNum < pending_.threadRng.size()) {
+    pending_.threadRng[threadNum] = randomUint.state();
+  }
+}
+
+void ReplayRecorder::commit() {
+  if (!saveCheckpoint(checkpointPath(replayDir_, pending_.generation), pending_)) {
+    Logger::warning("Replay checkpoints disabled");
+    active_ = false;
+  }
+}
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
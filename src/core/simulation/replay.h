@@ -0,0 +1,145 @@
+#ifndef BIOSIM4_SRC_CORE_SIMULATION_REPLAY_H_
+#define BIOSIM4_SRC_CORE_SIMULATION_REPLAY_H_
+
+/**
+ * @file replay.h
+ * @brief Per-generation replay checkpoints
+ *
+ * A generation is fully determined by its parent genomes and the random
+ * streams it consumes: the stream of the thread that spawns it (placement,
+ * mutation, barriers) and the per-thread streams used while it runs. With
+ * replayCheckpoints enabled, the simulator saves exactly that, a few KB per
+ * generation, to `<replayDir>/gen-NNNNNN.b4r`. `biosim4 --replay N` loads the
+ * checkpoint and re-simulates generation N with video enabled for it alone,
+ * so long runs no longer need videoStride = 1 "just in case".
+ *
+ * Replay is bit-exact for runs with numThreads = 1. With more threads, the
+ * order in which moves and deaths are queued depends on thread timing, so a
+ * replay starts from the identical population but its trajectory may diverge.
+ *
+ * File layout (host byte order): a CheckpointHeader, the spawn stream state,
+ * one stream state per thread, then for each parent a uint32 gene count
+ * followed by the raw genes. Parents are stored in fitness order.
+ */
+
+#include "../../types/params.h"
+#include "../../utils/random.h"
+#include "../genetics/genome-neurons.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+/**
+ * @struct GenerationCheckpoint
+ * @brief Everything needed to re-simulate one generation
+ */
+struct GenerationCheckpoint {
+  uint32_t generation = 0;                            ///< Generation the checkpoint starts
+  uint32_t population = 0;                            ///< Individuals per generation
+  uint16_t gridSizeX = 0;                             ///< Grid width
+  uint16_t gridSizeY = 0;                             ///< Grid height
+  uint32_t stepsPerGeneration = 0;                    ///< Steps per generation
+  uint32_t challenge = 0;                             ///< Active challenge
+  uint32_t barrierType = 0;                           ///< Barrier layout
+  RandomUintGenerator::State spawnRng{};              ///< Spawning thread's stream before the population was built
+  std::vector<RandomUintGenerator::State> threadRng;  ///< Each simulation thread's stream at step 0
+  std::vector<Genetics::Genome> parents;              ///< Parent genomes in fitness order (empty = random genomes)
+
+  /**
+   * @brief Check that the checkpoint was recorded with compatible parameters
+   * @param p Parameters of the replay run
+   * @param reason Receives a description of the first mismatch
+   * @return true if the world and population match
+   */
+  bool matches(const Types::Params& p, std::string& reason) const;
+};
+
+/** @brief Checkpoint file of one generation: `<replayDir>/gen-NNNNNN.b4r` */
+std::string checkpointPath(const std::string& replayDir, unsigned generation);
+
+/**
+ * @brief Write a checkpoint file
+ * @return false (after logging) if the file could not be written
+ */
+bool saveCheckpoint(const std::string& path, const GenerationCheckpoint& checkpoint);
+
+/**
+ * @brief Read a checkpoint file
+ * @return false (after logging) if the file is missing, truncated or not a checkpoint
+ */
+bool loadCheckpoint(const std::string& path, GenerationCheckpoint& checkpoint);
+
+/**
+ * @class ReplayRecorder
+ * @brief Collects one generation's checkpoint while the simulator runs
+ *
+ * beginGeneration() runs on the spawning thread right before the population
+ * is built. Once the parallel region reaches the new generation, every thread
+ * calls captureThread() with its own stream, and one thread calls commit()
+ * after a barrier. Each thread writes only its own slot, so no lock is needed.
+ */
+class ReplayRecorder {
+ public:
+  /**
+   * @brief Enable recording for a run
+   * @param params Run parameters (replayDir, numThreads, world size)
+   */
+  void start(const Types::Params& params);
+
+  /** @brief Recording is enabled for the current run */
+  bool active() const { return active_; }
+
+  /**
+   * @brief Capture the calling thread's stream and the parents of a generation
+   * @param generation Generation about to be spawned
+   * @param parents Its parent genomes (empty for a random generation 0)
+   */
+  void beginGeneration(unsigned generation, const std::vector<Genetics::Genome>& parents);
+
+  /**
+   * @brief Capture the calling thread's stream for the pending generation
+   * @param threadNum OpenMP thread number of the caller
+   */
+  void captureThread(unsigned threadNum);
+
+  /** @brief Write the pending checkpoint (overwrites an earlier run of the same generation) */
+  void commit();
+
+ private:
+  bool active_ = false;           ///< start() was called
+  std::string replayDir_;         ///< Output directory
+  GenerationCheckpoint pending_;  ///< Checkpoint of the generation being started
+};
+
+/**
+ * @brief Global replay recorder (defined in replay.cpp)
+ */
+extern ReplayRecorder replayRecorder;
+
+/**
+ * @brief Re-simulate one generation from its checkpoint with video enabled
+ *
+ * Loads `<replayDir>/gen-NNNNNN.b4r`, rebuilds the population from the saved
+ * parents and random streams, and runs the generation once with every step
+ * captured to video. Nothing else is written: no metrics, graph log or
+ * further checkpoints.
+ *
+ * @param params Parameters of the recording run
+ * @param generation Generation to replay
+ * @return Number of individuals that passed the selection criterion, or -1
+ *         if the checkpoint is missing or does not match the parameters
+ */
+int replayGeneration(const Types::Params& params, unsigned generation);
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_CORE_SIMULATION_REPLAY_H_
@@ -0,0 +1,189 @@
+/**
+ * @file replay_test.cpp
+ * @brief Round-trip tests for replay checkpoint files.
+ */
+
+#include "../../io/config/configManager.h"
+#include "../../io/metrics/metricsEndpoint.h"
+#include "../../io/trace/traceFormat.h"
+#include "../../io/trace/traceReader.h"
+#include "../../io/video/imageWriter.h"
+#include "replay.h"
+#include "simulator.h"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+
+using Core::Simulation::checkpointPath;
+using Core::Simulation::GenerationCheckpoint;
+using Core::Simulation::loadCheckpoint;
+using Core::Simulation::replayGeneration;
+using Core::Simulation::saveCheckpoint;
+using IO::Trace::generationTracePath;
+using IO::Trace::TraceReader;
+using IO::Video::ImageFrameData;
+
+namespace {
+
+/** @brief Empty directory of its own for one test, under the temp directory and this process id */
+std::filesystem::path testDirectory(const std::string& test) {
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / ("biosim4-replay-" + std::to_string(::getpid())) / test;
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  return dir;
+}
+
+/** @brief Every frame of a finished trace */
+std::vector<ImageFrameData> readTrace(const std::string& path) {
+  std::vector<ImageFrameData> frames;
+  TraceReader reader;
+  if (reader.open(path)) {
+    frames.resize(reader.frameCount());
+    for (size_t i = 0; i < frames.size(); ++i) {
+      if (!reader.readFrame(i, frames[i])) {
+        frames.clear();
+        break;
+      }
+    }
+  }
+  return frames;
+}
+
+Genome makeParent(unsigned length, int16_t weight) {
+  Genome genome(length);
+  for (unsigned i = 0; i < length; ++i) {
+    genome[i].sourceNum = i % 128;
+    genome[i].sinkNum = (i * 3) % 128;
+    genome[i].sinkType = i % 2;
+    genome[i].weight = static_cast<int16_t>(weight + i);
+  }
+  return genome;
+}
+
+}  // namespace
+
+TEST(ReplayTest, CheckpointRoundTripsStreamsAndParents) {
+  const std::filesystem::path dir = testDirectory("CheckpointRoundTrips");
+  const std::string path = checkpointPath(dir.string(), 42);
+  EXPECT_EQ(std::filesystem::path(path).filename(), "gen-000042.b4r");
+
+  GenerationCheckpoint saved;
+  saved.generation = 42;
+  saved.population = 300;
+  saved.gridSizeX = 64;
+  saved.gridSizeY = 32;
+  saved.stepsPerGeneration = 100;
+  saved.challenge = 6;
+  saved.barrierType = 2;
+  saved.spawnRng = {1, 2, 3, 4, 5, 6, 7, 8};
+  saved.threadRng = {{11, 12, 13, 14, 15, 16, 17, 18}, {21, 22, 23, 24, 25, 26, 27, 28}};
+  saved.parents = {makeParent(24, -100), makeParent(7, 300), Genome{}};
+  ASSERT_TRUE(saveCheckpoint(path, saved));
+
+  GenerationCheckpoint loaded;
+  ASSERT_TRUE(loadCheckpoint(path, loaded));
+  EXPECT_EQ(loaded.generation, 42u);
+  EXPECT_EQ(loaded.gridSizeY, 32);
+  EXPECT_EQ(loaded.barrierType, 2u);
+  EXPECT_EQ(std::memcmp(&loaded.spawnRng, &saved.spawnRng, sizeof(saved.spawnRng)), 0);
+  ASSERT_EQ(loaded.threadRng.size(), 2u);
+  EXPECT_EQ(loaded.threadRng[1].d, 28u);
+  ASSERT_EQ(loaded.parents.size(), saved.parents.size());
+  for (size_t i = 0; i < saved.parents.size(); ++i) {
+    ASSERT_EQ(loaded.parents[i].size(), saved.parents[i].size());
+    EXPECT_EQ(std::memcmp(loaded.parents[i].data(), saved.parents[i].data(), saved.parents[i].size() * sizeof(Gene)),
+              0);
+  }
+
+  // A checkpoint cut off inside the parent genomes is rejected
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+  EXPECT_FALSE(loadCheckpoint(path, loaded));
+  std::filesystem::remove_all(dir);
+}
+
+TEST(ReplayTest, StreamStateResumesTheSameSequence) {
+  RandomUintGenerator rng;
+  rng.setState({123456789, 362436069, 521288629, 7654321, 0xf1ea5eed, 3, 4, 5});
+  for (int i = 0; i < 10; ++i) {
+    rng();
+  }
+  const RandomUintGenerator::State saved = rng.state();
+  const uint32_t expected[3] = {rng(), rng(), rng()};
+
+  RandomUintGenerator resumed;
+  resumed.setState(saved);
+  for (uint32_t value : expected) {
+    EXPECT_EQ(resumed(), value);
+  }
+}
+
+TEST(ReplayTest, SingleThreadReplayReproducesTheRecordedGeneration) {
+  const std::filesystem::path dir = testDirectory("SingleThreadReplay");
+
+  // Record two small generations single-threaded, with a trace of every step
+  Types::Params params = IO::Config::ConfigManager().getParams();
+  params.gridSize_X = 48;
+  params.gridSize_Y = 48;
+  params.population = 120;
+  params.stepsPerGeneration = 40;
+  params.maxGenerations = 2;
+  params.numThreads = 1;
+  params.challenge = CHALLENGE_RIGHT_HALF;
+  params.barrierType = 0;
+  params.deterministic = true;
+  params.saveVideo = true;
+  params.videoStride = 1;
+  params.videoAsync = false;
+  params.videoTrace = true;
+  params.updateGraphLog = false;
+  params.metricsFormat = "none";
+  params.metricsEndpoint = "";
+  params.videoLiveRing = "";
+  params.displaySampleGenomes = 0;
+  params.replayCheckpoints = true;
+  params.replayDir = (dir / "replay").string();
+  params.logDir = (dir / "logs").string();
+  params.imageDir = (dir / "recorded").string();
+  std::filesystem::create_directories(params.logDir);
+  std::filesystem::create_directories(params.imageDir);
+  simulator(params);
+
+  // The last generation simulated is the one to replay; liveMetrics holds its survivors
+  const unsigned generation = IO::Metrics::liveMetrics.generation.load();
+  const unsigned recordedSurvivors = IO::Metrics::liveMetrics.survivors.load();
+  const std::vector<ImageFrameData> recorded = readTrace(generationTracePath(params.imageDir, generation));
+  ASSERT_EQ(recorded.size(), params.stepsPerGeneration);
+
+  params.imageDir = (dir / "replayed").string();
+  std::filesystem::create_directories(params.imageDir);
+  EXPECT_EQ(replayGeneration(params, generation), static_cast<int>(recordedSurvivors));
+  const std::vector<ImageFrameData> replayed = readTrace(generationTracePath(params.imageDir, generation));
+  ASSERT_EQ(replayed.size(), recorded.size());
+
+  // Same agents at the same places in every step, and the final population matches the last frame
+  for (size_t step = 0; step < recorded.size(); ++step) {
+    EXPECT_EQ(replayed[step].simStep, recorded[step].simStep);
+    ASSERT_EQ(replayed[step].indivLocs, recorded[step].indivLocs) << "step " << step;
+    EXPECT_EQ(replayed[step].indivColors, recorded[step].indivColors) << "step " << step;
+  }
+  std::vector<Coordinate> finalLocs;
+  for (unsigned index = 1; index <= params.population; ++index) {
+    if (peeps[index].alive) {
+      finalLocs.push_back(peeps[index].loc);
+    }
+  }
+  EXPECT_EQ(finalLocs, recorded.back().indivLocs);
+
+  std::filesystem::remove_all(dir);
+}
+
+}  // namespace BioSim
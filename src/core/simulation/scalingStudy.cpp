@@ -0,0 +1,171 @@
+/**
+ * @file scalingStudy.cpp
+ * @brief Implementation of the thread-scaling study mode
+ */
+
+#include "scalingStudy.h"
+
+#include "../../utils/logger.h"
+#include "simulator.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+using Types::Params;
+using Utils::Logger;
+
+namespace {
+
+double ratio(double numerator, double denominator) {
+  return denominator > 0.0 ? numerator / denominator : 0.0;
+}
+
+/**
+ * Speedup of @p seconds in @p stats over @p serialSeconds in @p serial, per
+ * agent-step. Runs at different thread counts follow different trajectories,
+ * so raw times would mix parallel speedup with differences in work done.
+ */
+double workSpeedup(double serialSeconds, const SimulationStats& serial, double seconds, const SimulationStats& stats) {
+  return ratio(ratio(serialSeconds, static_cast<double>(serial.agentSteps)),
+               ratio(seconds, static_cast<double>(stats.agentSteps)));
+}
+
+}  // namespace
+
+std::vector<unsigned> ScalingStudy::threadCounts(unsigned maxThreads) {
+  std::vector<unsigned> counts;
+  for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(std::max(maxThreads, 1u));
+  return counts;
+}
+
+double ScalingStudy::karpFlatt(double speedup, unsigned threads) {
+  if (threads <= 1 || speedup <= 0.0) {
+    return 0.0;
+  }
+  const double p = static_cast<double>(threads);
+  return (1.0 / speedup - 1.0 / p) / (1.0 - 1.0 / p);
+}
+
+std::vector<ScalingPoint> ScalingStudy::run(const Params& baseParams, unsigned maxThreads, unsigned generations) {
+  std::vector<ScalingPoint> points;
+
+  for (unsigned threads : threadCounts(maxThreads)) {
+    Params params = baseParams;
+    params.numThreads = threads;
+    params.saveVideo = false;
+    params.updateGraphLog = false;
+    params.displaySampleGenomes = 0;
+    params.genomeAnalysisStride = generations + 1;
+    params.deterministic = true;
+    params.maxGenerations = generations;
+
+    Logger::header("\n🧵 Scaling run: {} thread(s)", threads);
+    Logger::info("Scaling study run with {} threads", threads);
+
+    ScalingPoint point;
+    point.threads = threads;
+    point.stats = simulator(params, generations);
+    points.push_back(point);
+  }
+
+  return points;
+}
+
+void ScalingStudy::printReport(const std::vector<ScalingPoint>& points) {
+  if (points.empty()) {
+    return;
+  }
+  const auto& serial = points.front().stats;
+
+  Logger::header("\n📊 Thread Scaling (total)");
+  fmt::print("{:>8} {:>14} {:>12} {:>14} {:>9} {:>11} {:>12}\n", "threads", "agent-steps", "wall s",
+             "agent-steps/s", "speedup", "efficiency", "serial frac");
+  for (const auto& point : points) {
+    const double speedup = workSpeedup(serial.wallSeconds, serial, point.stats.wallSeconds, point.stats);
+    fmt::print("{:>8} {:>14} {:>12.3f} {:>14.0f} {:>9.2f} {:>10.1f}% {:>12.3f}\n", point.threads,
+               point.stats.agentSteps, point.stats.wallSeconds, point.stats.agentStepsPerSecond(), speedup,
+               speedup / point.threads * 100.0, karpFlatt(speedup, point.threads));
+  }
+
+  for (unsigned phase = 0; phase < NUM_PHASES; ++phase) {
+    Logger::header("\n📊 Thread Scaling: {}", phaseName(static_cast<Phase>(phase)));
+    fmt::print("{:>8} {:>14} {:>12} {:>9} {:>11} {:>12}\n", "threads", "agent-steps", "wall s", "speedup",
+               "efficiency", "serial frac");
+    for (const auto& point : points) {
+      const double speedup =
+          workSpeedup(serial.phaseSeconds[phase], serial, point.stats.phaseSeconds[phase], point.stats);
+      fmt::print("{:>8} {:>14} {:>12.3f} {:>9.2f} {:>10.1f}% {:>12.3f}\n", point.threads, point.stats.agentSteps,
+                 point.stats.phaseSeconds[phase], speedup, speedup / point.threads * 100.0,
+                 karpFlatt(speedup, point.threads));
+    }
+  }
+}
+
+void ScalingStudy::writeJson(const std::vector<ScalingPoint>& points, const Params& baseParams,
+                             const std::string& path) {
+  std::ofstream file(path);
+  if (!file) {
+    throw std::runtime_error("Failed to open file for writing: " + path);
+  }
+  if (points.empty()) {
+    file << "{}\n";
+    return;
+  }
+  const auto& serial = points.front().stats;
+
+  file << "{\n";
+  file << fmt::format(
+      "  \"config\": {{\"sizeX\": {}, \"sizeY\": {}, \"population\": {}, \"stepsPerGeneration\": {}, "
+      "\"challenge\": {}, \"barrierType\": {}, \"RNGSeed\": {}}},\n",
+      baseParams.gridSize_X, baseParams.gridSize_Y, baseParams.population, baseParams.stepsPerGeneration,
+      baseParams.challenge, baseParams.barrierType, baseParams.RNGSeed);
+  file << "  \"runs\": [\n";
+
+  for (size_t n = 0; n < points.size(); ++n) {
+    const auto& point = points[n];
+    const double speedup = workSpeedup(serial.wallSeconds, serial, point.stats.wallSeconds, point.stats);
+
+    file << "    {\n";
+    file << fmt::format("      \"threads\": {},\n", point.threads);
+    file << fmt::format("      \"generations\": {},\n", point.stats.generations);
+    file << fmt::format("      \"agentSteps\": {},\n", point.stats.agentSteps);
+    file << fmt::format("      \"wallSeconds\": {:.6f},\n", point.stats.wallSeconds);
+    file << fmt::format("      \"agentStepsPerSecond\": {:.1f},\n", point.stats.agentStepsPerSecond());
+    file << fmt::format("      \"speedup\": {:.4f},\n", speedup);
+    file << fmt::format("      \"efficiency\": {:.4f},\n", speedup / point.threads);
+    file << fmt::format("      \"serialFraction\": {:.4f},\n", karpFlatt(speedup, point.threads));
+    file << "      \"phases\": {\n";
+    for (unsigned phase = 0; phase < NUM_PHASES; ++phase) {
+      const double phaseSpeedup =
+          workSpeedup(serial.phaseSeconds[phase], serial, point.stats.phaseSeconds[phase], point.stats);
+      file << fmt::format(
+          "        \"{}\": {{\"seconds\": {:.6f}, \"speedup\": {:.4f}, \"efficiency\": {:.4f}, "
+          "\"serialFraction\": {:.4f}}}{}\n",
+          phaseName(static_cast<Phase>(phase)), point.stats.phaseSeconds[phase], phaseSpeedup,
+          phaseSpeedup / point.threads, karpFlatt(phaseSpeedup, point.threads), phase + 1 < NUM_PHASES ? "," : "");
+    }
+    file << "      }\n";
+    file << (n + 1 < points.size() ? "    },\n" : "    }\n");
+  }
+
+  file << "  ]\n";
+  file << "}\n";
+
+  Logger::success("Scaling study written to {}", path);
+}
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
@@ -0,0 +1,102 @@
+#ifndef BIOSIM4_SRC_CORE_SIMULATION_SCALINGSTUDY_H_
+#define BIOSIM4_SRC_CORE_SIMULATION_SCALINGSTUDY_H_
+
+/**
+ * @file scalingStudy.h
+ * @brief Thread-scaling study mode (`biosim4 --scaling`)
+ *
+ * Repeats one configuration at 1, 2, 4, ... N threads with the deterministic
+ * RNG and reports, overall and per phase of the main loop:
+ * - speedup        S(p) = t(1) / t(p), with t the seconds per agent-step
+ * - efficiency     E(p) = S(p) / p
+ * - serial fraction (Karp-Flatt) e(p) = (1/S(p) - 1/p) / (1 - 1/p)
+ *
+ * Results are not compared between thread counts: the move queue order and the
+ * per-thread RNG streams depend on scheduling, so runs follow different
+ * trajectories and do different amounts of work. Times are therefore divided
+ * by each run's agent-steps, which are reported alongside.
+ */
+
+#include "../../types/params.h"
+#include "simulationStats.h"
+
+#include <string>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+/**
+ * @struct ScalingPoint
+ * @brief Measurements for one thread count
+ */
+struct ScalingPoint {
+  unsigned threads = 0;   ///< OpenMP threads used
+  SimulationStats stats;  ///< Throughput and per-phase timing
+};
+
+/**
+ * @class ScalingStudy
+ * @brief Runs and reports thread-scaling measurements
+ */
+class ScalingStudy {
+ public:
+  /**
+   * @brief Thread counts to test: powers of two up to @p maxThreads, plus @p maxThreads itself
+   * @param maxThreads Largest thread count (>= 1)
+   * @return Ascending list starting at 1
+   */
+  static std::vector<unsigned> threadCounts(unsigned maxThreads);
+
+  /**
+   * @brief Run the configuration once per thread count
+   *
+   * Video, graph logging and genome dumps are disabled and the deterministic
+   * RNG is forced on; everything else comes from @p baseParams.
+   *
+   * @param baseParams Configuration to study
+   * @param maxThreads Largest thread count
+   * @param generations Generations per run (including extinction restarts)
+   * @return One point per thread count, ascending
+   */
+  static std::vector<ScalingPoint> run(const Types::Params& baseParams, unsigned maxThreads, unsigned generations);
+
+  /**
+   * @brief Print speedup / efficiency / Karp-Flatt tables (total and per phase)
+   * @param points Output of run()
+   */
+  static void printReport(const std::vector<ScalingPoint>& points);
+
+  /**
+   * @brief Write the study as JSON
+   * @param points Output of run()
+   * @param baseParams Configuration that was studied
+   * @param path Output file path
+   * @throws std::runtime_error if the file cannot be written
+   */
+  static void writeJson(const std::vector<ScalingPoint>& points, const Types::Params& baseParams,
+                        const std::string& path);
+
+  /**
+   * @brief Karp-Flatt experimentally determined serial fraction
+   * @param speedup Measured speedup S(p)
+   * @param threads Thread count p (> 1)
+   * @return e(p); 0 for p <= 1 or non-positive speedup
+   */
+  static double karpFlatt(double speedup, unsigned threads);
+};
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
+
+// Backward compatibility aliases
+namespace BioSim {
+using Core::Simulation::ScalingPoint;
+using Core::Simulation::ScalingStudy;
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_CORE_SIMULATION_SCALINGSTUDY_H_
@@ -0,0 +1,114 @@
+#ifndef BIOSIM4_SRC_CORE_SIMULATION_SIMULATIONSTATS_H_
+#define BIOSIM4_SRC_CORE_SIMULATION_SIMULATIONSTATS_H_
+
+/**
+ * @file simulationStats.h
+ * @brief Throughput and per-phase timing collected by simulator()
+ *
+ * The simulator always records these counters (the cost is a few clock reads
+ * per simulation step). They are consumed by the benchmark run mode and are
+ * available to any caller of simulator().
+ */
+
+#include <array>
+#include <cstdint>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+
+/**
+ * @enum Phase
+ * @brief Sections of the main loop that are timed separately
+ */
+enum class Phase : unsigned {
+  AGENT_STEP,         ///< Parallel sense/think/act loop over all individuals
+  END_OF_STEP,        ///< Serial endOfSimulationStep() (death/move queues, signal fade, live ring, video frame)
+  END_OF_GENERATION,  ///< Serial endOfGeneration() (hand the video to an encoder worker, graph log)
+  SPAWN_GENERATION,   ///< spawnNewGeneration() (selection, metrics row, reproduction)
+  NUM_PHASES,         ///< Marker: number of timed phases
+};
+
+constexpr unsigned NUM_PHASES = static_cast<unsigned>(Phase::NUM_PHASES);
+
+/**
+ * @brief Short identifier for a phase, used in reports and baseline files
+ * @param phase Phase to name
+ * @return Lower-case, hyphenated phase name
+ */
+constexpr const char* phaseName(Phase phase) {
+  switch (phase) {
+    case Phase::AGENT_STEP:
+      return "agent-step";
+    case Phase::END_OF_STEP:
+      return "end-of-step";
+    case Phase::END_OF_GENERATION:
+      return "end-of-generation";
+    case Phase::SPAWN_GENERATION:
+      return "spawn-generation";
+    default:
+      return "unknown";
+  }
+}
+
+/**
+ * @struct VideoPipelineStats
+ * @brief Throughput of the video encoder pool (see ImageWriter)
+ */
+struct VideoPipelineStats {
+  unsigned workers = 0;            ///< Encoder threads (0 = video ran synchronously)
+  unsigned slots = 0;              ///< Frame snapshots the pool could buffer
+  uint64_t frames = 0;             ///< Frames rendered and encoded
+  uint64_t skippedSteps = 0;       ///< Steps of recorded generations left out by the CapturePolicy
+  uint64_t triggeredFrames = 0;    ///< Frames between keyframes kept because a capture trigger fired
+  uint64_t videos = 0;             ///< Videos (or traces) finished
+  double busySeconds = 0.0;        ///< Time workers spent rendering and encoding, summed over workers
+  double wallSeconds = 0.0;        ///< Lifetime of the pool
+  uint64_t stalledCaptures = 0;    ///< Captures that waited for a free slot
+  double stallSeconds = 0.0;       ///< Time the simulation waited for a free slot
+  uint64_t peakBufferedBytes = 0;  ///< Most snapshot memory waiting to be encoded at once
+  uint64_t memoryBudgetBytes = 0;  ///< videoEncodeMemoryMB in bytes (0 = no limit)
+
+  /// @brief Frames per second of pool lifetime
+  double framesPerSecond() const { return wallSeconds > 0.0 ? frames / wallSeconds : 0.0; }
+  /// @brief Share of the pool's worker time spent busy (0..1)
+  double utilization() const { return wallSeconds > 0.0 && workers > 0 ? busySeconds / (wallSeconds * workers) : 0.0; }
+};
+
+/**
+ * @struct SimulationStats
+ * @brief Work done and wall time spent by one call to simulator()
+ */
+struct SimulationStats {
+  unsigned generations = 0;                       ///< Generations executed (including extinction restarts)
+  uint64_t simSteps = 0;                          ///< Simulation steps executed
+  uint64_t agentSteps = 0;                        ///< Individual steps executed (living agents only)
+  double wallSeconds = 0.0;                       ///< Wall time of the main loop
+  std::array<double, NUM_PHASES> phaseSeconds{};  ///< Wall time per Phase
+  VideoPipelineStats video;                       ///< Encoder pool throughput (all zero without video)
+
+  /// @brief Add elapsed wall time to a phase
+  void addPhaseTime(Phase phase, double seconds) { phaseSeconds[static_cast<unsigned>(phase)] += seconds; }
+
+  /// @brief Wall time spent in a phase
+  double phaseTime(Phase phase) const { return phaseSeconds[static_cast<unsigned>(phase)]; }
+
+  /// @brief Individual steps per second of wall time
+  double agentStepsPerSecond() const { return wallSeconds > 0.0 ? agentSteps / wallSeconds : 0.0; }
+
+  /// @brief Generations per second of wall time
+  double generationsPerSecond() const { return wallSeconds > 0.0 ? generations / wallSeconds : 0.0; }
+};
+
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
+
+// Backward compatibility aliases
+namespace BioSim {
+using Core::Simulation::SimulationStats;
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_CORE_SIMULATION_SIMULATIONSTATS_H_
@@ -13,6 +13,10 @@
  * - pheromones: Signal layers overlaying the grid
  * - peeps: Container of all Individual creatures
  * - imageWriter: Video frame capture system
+ * - metricsWriter: Per-generation metrics log (background thread)
+ * - replayRecorder: Optional per-generation replay checkpoints (see replay.h)
+ * - liveRing: Optional shared-memory ring of world states for external viewers
+ * - liveMetrics / metricsEndpoint: Live counters, optionally served over HTTP
  *
  * Thread safety is achieved through a deferred execution model where mutations
  * to shared state (movements, deaths, signal updates) are queued during parallel
@@ -24,10 +28,17 @@
 
 #include "simulator.h"
 
+#include "challenges.h"
+#include "replay.h"
+#include "../../io/live/liveRing.h"
+#include "../../io/metrics/metricsEndpoint.h"
+#include "../../io/metrics/metricsWriter.h"
 #include "../../io/video/imageWriter.h"
 #include "../../utils/analysis.h"
 #include "../../utils/logger.h"
+#include "../../utils/resourceUsage.h"
 
+#include <omp.h>
 #include <spdlog/fmt/fmt.h>
 
 #include <algorithm>
@@ -57,6 +68,10 @@ namespace Simulation {
 using Agents::Individual;
 using Agents::Peeps;
 using Genetics::Action;
+using IO::Live::liveRing;
+using IO::Metrics::liveMetrics;
+using IO::Metrics::metricsEndpoint;
+using IO::Metrics::metricsWriter;
 using IO::Video::imageWriter;
 using Types::Params;
 using Utils::Logger;
@@ -66,13 +81,20 @@ using Utils::Logger;
 /// @brief Initialize the starting population with random genomes and positions
 extern void initializeGeneration0();
 
+/// @brief Initialize a population from parent genomes (replays only; the simulator goes through spawnNewGeneration)
+extern void initializeNewGeneration(const std::vector<Genome>& parentGenomes, unsigned generation);
+
+/// @brief Rebuild what the survival criterion reads before a replayed generation's survivors are counted
+extern void prepareSurvivalCriterion(unsigned challenge);
+
 /**
  * @brief Create the next generation from survivors
  * @param generation Current generation number
  * @param murderCount Number of individuals that died during the generation
+ * @param metrics Receives the generation's population columns for the metrics log
  * @return Number of survivors who reproduced
  */
-extern unsigned spawnNewGeneration(unsigned generation, unsigned murderCount);
+extern unsigned spawnNewGeneration(unsigned generation, unsigned murderCount, IO::Metrics::GenerationMetrics& metrics);
 
 }  // namespace Simulation
 }  // namespace Core
@@ -88,14 +110,6 @@ namespace Utils {
  * @see Implementation in analysis.cpp
  */
 extern void displaySampleGenomes(unsigned count);
-
-/**
- * @brief Append entry to per-generation log file (epoch-log.txt)
- * @param generation Current generation number
- * @param numberSurvivors Count of individuals passing selection
- * @param murderCount Number of individuals killed by KILL_FORWARD action
- */
-extern void appendEpochLog(unsigned generation, unsigned numberSurvivors, unsigned murderCount);
 }  // namespace Utils
 }  // namespace v1
 }  // namespace BioSim
@@ -157,6 +171,15 @@ Grid grid;
  * signals.increment(), read-only elsewhere
  */
 Signals pheromones;
+
+/**
+ * @brief Global 8-neighbor counts of the grid, for density-based survival criteria
+ *
+ * Rebuilt by prepareSurvivalCriterion() before those criteria are evaluated.
+ *
+ * @note Read-only while survival criteria are evaluated in parallel
+ */
+NeighborCounts neighborCounts;
 }  // namespace World
 
 namespace Agents {
@@ -235,6 +258,19 @@ void initParamsForTesting(uint16_t gridSizeX, uint16_t gridSizeY) {
   g_params.maxNumberNeurons = 5;
 }
 
+/**
+ * @brief Install a complete parameter set for tests and benchmarks
+ *
+ * Unlike the grid-size overload, this replaces every field of g_params, so
+ * fixtures that exercise sensors, mutation or rendering get fully defined
+ * (and therefore reproducible) configuration.
+ *
+ * @param params Parameter set to copy into the global g_params
+ */
+void initParamsForTesting(const Types::Params& params) {
+  g_params = params;
+}
+
 /**
  * @brief Execute one simulation step for a single individual
  *
@@ -244,6 +280,7 @@ void initParamsForTesting(uint16_t gridSizeX, uint16_t gridSizeY) {
  * 1. Increment the individual's age counter
  * 2. Feed sensor inputs through the neural network (feedForward)
  * 3. Queue actions for deferred execution (executeActions)
+ * 4. Run the challenge's agentStep() hook
  *
  * Actions like movement, death, and signal emission are queued rather than
  * executed immediately. This deferred execution model allows all threads to
@@ -262,6 +299,10 @@ void initParamsForTesting(uint16_t gridSizeX, uint16_t gridSizeY) {
  * population × stepsPerGeneration times per generation and is parallelized
  * via OpenMP's `#pragma omp for` directive.
  *
+ * The function is instantiated once per challenge, so the challenge hook is
+ * inlined; the simulator selects the instance with agentStepFunction().
+ *
+ * @tparam Challenge Challenge type from challenges.h
  * @param individual Reference to the Individual struct being simulated
  * @param simulationStep Current step within generation (0 to stepsPerGeneration-1)
  *
@@ -269,10 +310,27 @@ void initParamsForTesting(uint16_t gridSizeX, uint16_t gridSizeY) {
  * @see executeActions() for action queue processing
  * @see endOfSimulationStep() for deferred action application
  */
+template <typename Challenge>
 void simulationStepOneIndividual(Individual& individual, unsigned simulationStep) {
   ++individual.age;
   auto actionLevels = individual.feedForward(simulationStep);
   Agents::executeActions(individual, actionLevels);
+  Challenge::agentStep(individual, simulationStep);
+}
+
+/// simulationStepOneIndividual() for one challenge
+using AgentStepFunction = void (*)(Individual& individual, unsigned simulationStep);
+
+/**
+ * @brief Select the per-agent step of a challenge
+ * @param challenge CHALLENGE_* id
+ * @return simulationStepOneIndividual() instantiated for the challenge
+ * @throws std::invalid_argument if no challenge has this id
+ */
+static AgentStepFunction agentStepFunction(unsigned challenge) {
+  return visitChallenge(challenge, [](auto tag) -> AgentStepFunction {
+    return &simulationStepOneIndividual<typename decltype(tag)::type>;
+  });
 }
 
 /**
@@ -304,7 +362,8 @@ void simulationStepOneIndividual(Individual& individual, unsigned simulationStep
  * 2. Copy provided params to global g_params (for parameterMngrSingleton compatibility)
  * 3. Initialize random number generator (randomUint)
  * 4. Initialize global singletons (grid, pheromones, imageWriter, peeps)
- * 5. Create generation 0 with random genomes and placements
+ * 5. Start the metrics writer (truncates the epoch log)
+ * 6. Create generation 0 with random genomes and placements
  *
  * **Global Data Structures:**
  * - `grid`: 2D spatial world (16-bit indices, 0=empty, 1..N=creature IDs)
@@ -326,7 +385,18 @@ void simulationStepOneIndividual(Individual& individual, unsigned simulationStep
  * Sample genomes are displayed to stdout at intervals (genomeAnalysisStride).
  * Pipe output to tools/graph-nnet.py for neural network visualization.
  *
+ * **Instrumentation:**
+ * Wall time is accumulated per Phase at the existing synchronization points
+ * (each `omp single` ends with an implicit barrier, so the time between two
+ * single sections is the parallel agent step). Living-agent steps are counted
+ * with an OpenMP reduction. The result is returned as SimulationStats, and the
+ * per-generation share is submitted to metricsWriter together with the
+ * population columns filled in by spawnNewGeneration().
+ *
  * @param params Pre-configured simulation parameters from ConfigManager
+ * @param generationBudget Maximum generations to execute including extinction
+ *        restarts (0 = unlimited)
+ * @return Work done and per-phase wall time for this run
  *
  * @note This function does not return until maxGenerations is reached or runMode changes
  *
@@ -336,7 +406,12 @@ void simulationStepOneIndividual(Individual& individual, unsigned simulationStep
  * @see spawnNewGeneration() for reproduction logic
  * @see initializeGeneration0() for initial population creation
  */
-void simulator(const Types::Params& params) {
+SimulationStats simulator(const Types::Params& params, unsigned generationBudget) {
+  using Clock = std::chrono::steady_clock;
+  auto secondsBetween = [](Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double>(end - start).count();
+  };
+
   // Display available sensors and actions for debugging/verification
   ::BioSim::Utils::printSensorsActions();
 
@@ -344,6 +419,9 @@ void simulator(const Types::Params& params) {
   g_params = params;
   const auto& p = parameterMngrSingleton;  // Local reference for convenience
 
+  // Challenge code is selected once; an unknown challenge fails here
+  const AgentStepFunction stepOneIndividual = agentStepFunction(p.challenge);
+
   // Seed the global random number generator (per-thread instances seeded later)
   randomUint.initialize();
 
@@ -353,12 +431,45 @@ void simulator(const Types::Params& params) {
   imageWriter.init(p.signalLayers, p.gridSize_X, p.gridSize_Y);
   peeps.initialize(p.population);
 
+  IO::Metrics::MetricsConfig metricsConfig;
+  metricsConfig.format = IO::Metrics::parseMetricsFormat(p.metricsFormat);
+  metricsConfig.logDir = p.logDir;
+  metricsConfig.queueCapacity = p.metricsQueueCapacity;
+  metricsConfig.queueMemoryBytes = size_t(p.metricsQueueMemoryMB) * 1024 * 1024;
+  metricsConfig.flushEveryRows = p.metricsFlushRows;
+  metricsConfig.flushIntervalMs = p.metricsFlushIntervalMs;
+  metricsWriter.start(metricsConfig);
+
+  // Live counters are always published; the endpoint serving them is optional
+  liveMetrics.reset(p.population);
+  if (!p.metricsEndpoint.empty()) {
+    metricsEndpoint.start(p.metricsEndpoint);
+  }
+  if (!p.videoLiveRing.empty()) {
+    liveRing.open(p.videoLiveRing, p.videoLiveRingSlots, p.gridSize_X, p.gridSize_Y, p.signalLayers, p.population);
+  }
+
+  // Checkpoints: this thread's stream now builds generation 0
+  if (p.replayCheckpoints) {
+    replayRecorder.start(p);
+  }
+  if (replayRecorder.active()) {
+    replayRecorder.beginGeneration(0, {});
+  }
+
   // Create the initial population with random genomes and positions
   unsigned currentGeneration = 0;
   initializeGeneration0();
   Types::runMode = Types::RunMode::RUN;
   unsigned murderCount;  // Tracks deaths during generation (for logging)
 
+  SimulationStats stats;
+  uint64_t agentSteps = 0;  // Reduction target for living-agent steps
+  const Clock::time_point runStart = Clock::now();
+  Clock::time_point phaseStart = runStart;                // Written only inside omp single sections
+  std::array<double, NUM_PHASES> generationPhaseStart{};  // Phase totals when the current generation started
+  uint64_t generationAgentStepStart = 0;                  // agentSteps when the current generation started
+
   // OpenMP parallel region: shared data is read-only, mutations via deferred queues
 #pragma omp parallel num_threads(p.numThreads) default(shared)
   {
@@ -366,26 +477,59 @@ void simulator(const Types::Params& params) {
     randomUint.initialize();
 
     // Outer loop: iterate through generations until stopping condition
-    while (Types::runMode == Types::RunMode::RUN && currentGeneration < p.maxGenerations) {
+    while (Types::runMode == Types::RunMode::RUN && currentGeneration < p.maxGenerations &&
+           (generationBudget == 0 || stats.generations < generationBudget)) {
+      // Checkpoint the streams every thread starts this generation with (the
+      // flag only changes inside the single below, after the barrier)
+      const bool recordCheckpoint = replayRecorder.active();
+      if (recordCheckpoint) {
+        replayRecorder.captureThread(omp_get_thread_num());
+#pragma omp barrier
+      }
+
       // Reset death counter for this generation (single-threaded initialization)
 #pragma omp single
-      murderCount = 0;
+      {
+        if (recordCheckpoint) {
+          replayRecorder.commit();
+        }
+        murderCount = 0;
+        generationPhaseStart = stats.phaseSeconds;
+        generationAgentStepStart = agentSteps;
+        phaseStart = Clock::now();
+      }
 
       // Middle loop: fixed number of simulation steps per generation
       for (unsigned simulationStep = 0; simulationStep < p.stepsPerGeneration; ++simulationStep) {
         // Inner loop (parallelized): execute one step for each living creature
         // Note: index 0 is reserved in peeps, valid indices start at 1
-#pragma omp for schedule(auto)
+#pragma omp for schedule(auto) reduction(+ : agentSteps)
         for (unsigned individual = 1; individual <= p.population; ++individual)
-          if (peeps[individual].alive)
-            simulationStepOneIndividual(peeps[individual], simulationStep);
+          if (peeps[individual].alive) {
+            stepOneIndividual(peeps[individual], simulationStep);
+            ++agentSteps;
+          }
 
         // Single-threaded section: apply queued actions (movements, deaths, signals)
         // This ensures thread-safe mutation of shared data structures
 #pragma omp single
         {
-          murderCount += peeps.deathQueueSize();
+          const Clock::time_point stepEnd = Clock::now();
+          stats.addPhaseTime(Phase::AGENT_STEP, secondsBetween(phaseStart, stepEnd));
+
+          murderCount += peeps.murderQueueSize();
           endOfSimulationStep(simulationStep, currentGeneration);
+          ++stats.simSteps;
+
+          phaseStart = Clock::now();
+          stats.addPhaseTime(Phase::END_OF_STEP, secondsBetween(stepEnd, phaseStart));
+
+          liveMetrics.simStep.store(simulationStep, std::memory_order_relaxed);
+          liveMetrics.agentStepsTotal.store(agentSteps, std::memory_order_relaxed);
+          for (unsigned phase = 0; phase < NUM_PHASES; ++phase) {
+            liveMetrics.phaseSeconds[phase].store(stats.phaseSeconds[phase], std::memory_order_relaxed);
+          }
+          liveMetrics.touch();
         }
       }
 
@@ -393,10 +537,37 @@ void simulator(const Types::Params& params) {
 #pragma omp single
       {
         // End-of-generation tasks: video output, logging, statistics
+        const Clock::time_point generationEnd = Clock::now();
         endOfGeneration(currentGeneration);
+        const Clock::time_point spawnStart = Clock::now();
+        stats.addPhaseTime(Phase::END_OF_GENERATION, secondsBetween(generationEnd, spawnStart));
 
         // Apply selection pressure and create next generation from survivors
-        unsigned numberSurvivors = spawnNewGeneration(currentGeneration, murderCount);
+        IO::Metrics::GenerationMetrics metrics;
+        unsigned numberSurvivors = spawnNewGeneration(currentGeneration, murderCount, metrics);
+        stats.addPhaseTime(Phase::SPAWN_GENERATION, secondsBetween(spawnStart, Clock::now()));
+        ++stats.generations;
+
+        // Hand the row to the metrics writer thread (never blocks on I/O)
+        auto phaseDelta = [&](Phase phase) {
+          return stats.phaseTime(phase) - generationPhaseStart[static_cast<unsigned>(phase)];
+        };
+        metrics.agentSteps = agentSteps - generationAgentStepStart;
+        metrics.agentStepSeconds = phaseDelta(Phase::AGENT_STEP);
+        metrics.endOfStepSeconds = phaseDelta(Phase::END_OF_STEP);
+        metrics.endOfGenerationSeconds = phaseDelta(Phase::END_OF_GENERATION);
+        metrics.spawnSeconds = phaseDelta(Phase::SPAWN_GENERATION);
+        metrics.residentSetBytes = ::BioSim::Utils::currentResidentSetBytes();
+
+        liveMetrics.generation.store(currentGeneration, std::memory_order_relaxed);
+        liveMetrics.generationsTotal.store(stats.generations, std::memory_order_relaxed);
+        liveMetrics.survivors.store(numberSurvivors, std::memory_order_relaxed);
+        liveMetrics.murders.store(metrics.murders, std::memory_order_relaxed);
+        liveMetrics.averageGenomeLength.store(metrics.averageGenomeLength, std::memory_order_relaxed);
+        liveMetrics.agentStepsPerSecond.store(
+            metrics.agentStepSeconds > 0.0 ? metrics.agentSteps / metrics.agentStepSeconds : 0.0,
+            std::memory_order_relaxed);
+        metricsWriter.submit(std::move(metrics));
 
         // Periodically display sample genomes for analysis/debugging
         if (numberSurvivors > 0 && (currentGeneration % p.genomeAnalysisStride == 0))
@@ -411,11 +582,98 @@ void simulator(const Types::Params& params) {
     }
   }
 
+  stats.agentSteps = agentSteps;
+  stats.wallSeconds = secondsBetween(runStart, Clock::now());
+  imageWriter.shutdown();  // Finish videos still queued on the encoder pool
+  stats.video = imageWriter.pipelineStats();
+  metricsWriter.stop();
+  liveMetrics.running.store(false, std::memory_order_relaxed);
+  metricsEndpoint.stop();
+  liveRing.close();
+
   // Final genome report for debugging/analysis
   ::BioSim::Utils::displaySampleGenomes(3);
 
   Logger::print("Simulator exit.");
   Logger::info("Simulation completed successfully");
+  Logger::info("Executed {} generations, {} agent-steps in {:.3f}s ({:.0f} agent-steps/s)", stats.generations,
+               stats.agentSteps, stats.wallSeconds, stats.agentStepsPerSecond());
+  return stats;
+}
+
+int replayGeneration(const Types::Params& params, unsigned generation) {
+  GenerationCheckpoint checkpoint;
+  if (!loadCheckpoint(checkpointPath(params.replayDir, generation), checkpoint)) {
+    return -1;
+  }
+  std::string mismatch;
+  if (!checkpoint.matches(params, mismatch)) {
+    Logger::error("Checkpoint of generation {} was recorded with {}", generation, mismatch);
+    return -1;
+  }
+
+  // Video for every step of this generation only; nothing else is written
+  g_params = params;
+  g_params.saveVideo = true;
+  g_params.videoStride = 1;
+  g_params.updateGraphLog = false;
+  g_params.replayCheckpoints = false;
+  g_params.numThreads = std::max<unsigned>(1, static_cast<unsigned>(checkpoint.threadRng.size()));
+  const auto& p = parameterMngrSingleton;
+  if (p.numThreads > 1) {
+    Logger::warning("Generation {} was recorded with {} threads; the replay starts from the same population "
+                    "but may diverge from the original run (exact replay needs numThreads = 1)",
+                    generation, p.numThreads);
+  }
+
+  grid.initialize(p.gridSize_X, p.gridSize_Y);
+  pheromones.initialize(p.signalLayers, p.gridSize_X, p.gridSize_Y);
+  imageWriter.init(p.signalLayers, p.gridSize_X, p.gridSize_Y);
+  peeps.initialize(p.population);
+
+  // Rebuild the population from the stream the spawning thread used originally
+  randomUint.setState(checkpoint.spawnRng);
+  if (checkpoint.parents.empty()) {
+    initializeGeneration0();
+  } else {
+    initializeNewGeneration(checkpoint.parents, generation);
+  }
+  Types::runMode = Types::RunMode::RUN;
+  const AgentStepFunction stepOneIndividual = agentStepFunction(p.challenge);
+
+  const auto start = std::chrono::steady_clock::now();
+#pragma omp parallel num_threads(p.numThreads) default(shared)
+  {
+    randomUint.setState(checkpoint.threadRng[omp_get_thread_num()]);
+
+    for (unsigned simulationStep = 0; simulationStep < p.stepsPerGeneration; ++simulationStep) {
+#pragma omp for schedule(auto)
+      for (unsigned individual = 1; individual <= p.population; ++individual)
+        if (peeps[individual].alive) {
+          stepOneIndividual(peeps[individual], simulationStep);
+        }
+
+#pragma omp single
+      endOfSimulationStep(simulationStep, generation);
+    }
+  }
+  endOfGeneration(generation);
+
+  int survivors = 0;
+  prepareSurvivalCriterion(p.challenge);
+  const SurvivalCriterion passed = survivalCriterion(p.challenge);
+  for (unsigned index = 1; index <= p.population; ++index) {
+    if (passed(peeps[index]).first && !peeps[index].nnet.connections.empty()) {
+      ++survivors;
+    }
+  }
+  imageWriter.shutdown();  // Finish the video queued on the encoder pool
+  Types::runMode = Types::RunMode::STOP;
+
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  Logger::info("Replayed generation {} in {:.2f}s: {} survivors, video in {}", generation, seconds, survivors,
+               p.imageDir);
+  return survivors;
 }
 
 }  // namespace Simulation
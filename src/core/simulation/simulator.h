@@ -9,13 +9,15 @@
  * challenge type constants. Also see simulator.cpp for implementation.
  */
 
-#include "../../types/basicTypes.h"  ///< types Dir, Coordinate, Polar
-#include "../../types/params.h"      ///< Configuration parameters
-#include "../../utils/random.h"      ///< Random number generation
-#include "../agents/indiv.h"         ///< Individual agent data structure
-#include "../agents/peeps.h"         ///< Population container
-#include "../world/grid.h"           ///< 2D world where the individuals live
-#include "../world/signals.h"        ///< Pheromone layers
+#include "../../types/basicTypes.h"   ///< types Dir, Coordinate, Polar
+#include "../../types/params.h"       ///< Configuration parameters
+#include "../../utils/random.h"       ///< Random number generation
+#include "../agents/indiv.h"          ///< Individual agent data structure
+#include "../agents/peeps.h"          ///< Population container
+#include "../world/grid.h"            ///< 2D world where the individuals live
+#include "../world/neighborCounts.h"  ///< Per-cell 8-neighbor agent counts
+#include "../world/signals.h"         ///< Pheromone layers
+#include "simulationStats.h"          ///< Throughput and per-phase timing
 
 #include <functional>
 
@@ -47,11 +49,22 @@ constexpr unsigned CHALLENGE_ALTRUISM_SACRIFICE = 18;
 
 extern const Types::Params& parameterMngrSingleton;
 
-void simulator(const Types::Params& params);
+/**
+ * @brief Run the simulation until maxGenerations (or runMode stops it)
+ * @param params Simulation parameters
+ * @param generationBudget Stop after this many executed generations, counting
+ *        extinction restarts (0 = unlimited). Used by benchmark runs so that
+ *        hard challenges cannot restart generation 0 forever.
+ * @return Work done and per-phase wall time
+ */
+SimulationStats simulator(const Types::Params& params, unsigned generationBudget = 0);
 
 // Test helper function to initialize global params
 void initParamsForTesting(uint16_t gridSizeX = 128, uint16_t gridSizeY = 128);
 
+// Test/benchmark helper: install a complete parameter set as the global params
+void initParamsForTesting(const Types::Params& params);
+
 using World::visitNeighborhood;
 
 }  // namespace Simulation
@@ -60,6 +73,7 @@ using World::visitNeighborhood;
 namespace World {
 extern Grid grid;
 extern Signals pheromones;
+extern NeighborCounts neighborCounts;
 }  // namespace World
 
 namespace Agents {
@@ -94,6 +108,7 @@ using Core::Simulation::initParamsForTesting;
 using Core::Simulation::parameterMngrSingleton;
 using Core::Simulation::simulator;
 using Core::World::grid;
+using Core::World::neighborCounts;
 using Core::World::pheromones;
 using Core::World::visitNeighborhood;
 
@@ -9,6 +9,11 @@
  * - Special handling for the altruism challenge with kinship selection
  */
 
+#include "../../io/metrics/metricsWriter.h"
+#include "../../utils/analysis.h"
+#include "../../utils/logger.h"
+#include "challenges.h"
+#include "replay.h"
 #include "simulator.h"
 
 #include <spdlog/fmt/fmt.h>
@@ -17,6 +22,7 @@
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <vector>
 
 namespace BioSim {
@@ -26,7 +32,7 @@ namespace Simulation {
 
 using Agents::Individual;
 
-extern std::pair<bool, float> passedSurvivalCriterion(const Individual& indiv, unsigned challenge);
+extern void prepareSurvivalCriterion(unsigned challenge);
 
 }  // namespace Simulation
 }  // namespace Core
@@ -44,20 +50,104 @@ extern Genome generateChildGenome(const std::vector<Genome>& parentGenomes);
 }  // namespace v1
 }  // namespace BioSim
 
-// Forward declaration from Utils namespace
-namespace BioSim {
-inline namespace v1 {
-namespace Utils {
-extern void appendEpochLog(unsigned generation, unsigned numberSurvivors, unsigned murderCount);
-}
-}  // namespace v1
-}  // namespace BioSim
-
 namespace BioSim {
 inline namespace v1 {
 namespace Core {
 namespace Simulation {
 
+namespace {
+
+constexpr float NOT_SELECTED = -1.0f;  ///< Score slot of an individual that does not become a parent
+constexpr float SACRIFICED = -2.0f;    ///< Score slot of an altruist that died in the sacrificial area
+constexpr unsigned SCORE_BLOCK = 256;  ///< Individuals scored and compacted by one task
+
+/// Survival score by individual index (scores are >= 0), reused across generations
+std::vector<float> survivalScores;
+
+/// Parents found in each block of SCORE_BLOCK indices, prefix-summed into output offsets
+std::vector<unsigned> blockOffsets;
+
+/**
+ * @brief Score one individual for selection
+ *
+ * Only reads the individual and the grid, so the whole population can be
+ * scored concurrently.
+ *
+ * @param criterion Survival criterion of the challenge
+ * @param sacrifice Sacrificial-area criterion (altruism challenge), or nullptr
+ * @return The survival score, NOT_SELECTED, or SACRIFICED (altruism challenge only)
+ */
+float selectionScore(const Individual& indiv, SurvivalCriterion criterion, SurvivalCriterion sacrifice) {
+  // An individual without neural connections never passes on its genome
+  if (indiv.nnet.connections.empty()) {
+    return NOT_SELECTED;
+  }
+  const std::pair<bool, float> passed = criterion(indiv);
+  if (passed.first) {
+    return passed.second;
+  }
+  if (sacrifice != nullptr && sacrifice(indiv).first) {
+    return SACRIFICED;
+  }
+  return NOT_SELECTED;
+}
+
+}  // namespace
+
+/**
+ * @brief Score the population in parallel and compact the parents
+ *
+ * The population is split into blocks of SCORE_BLOCK indices. One taskloop
+ * scores each block into survivalScores and counts its parents; after a
+ * prefix sum over the block counts a second taskloop copies every block's
+ * parents to its own output range. Parents therefore come out in index order,
+ * whatever the number of threads.
+ *
+ * Called from inside the simulator's `omp single`, so the tasks run on the
+ * threads waiting at the end of it; outside a parallel region the loops simply
+ * run on the calling thread.
+ *
+ * @param challenge Challenge to score against
+ * @param parents Receives <index, score> of every individual that passed, in index order
+ */
+void scorePopulation(unsigned challenge, std::vector<std::pair<uint16_t, float>>& parents) {
+  const unsigned population = parameterMngrSingleton.population;
+  const unsigned numBlocks = (population + SCORE_BLOCK - 1) / SCORE_BLOCK;
+  survivalScores.resize(population + 1);
+  blockOffsets.assign(numBlocks + 1, 0);
+  prepareSurvivalCriterion(challenge);
+  const SurvivalCriterion criterion = survivalCriterion(challenge);
+  const SurvivalCriterion sacrifice =
+      challenge == CHALLENGE_ALTRUISM ? survivalCriterion(CHALLENGE_ALTRUISM_SACRIFICE) : nullptr;
+
+#pragma omp taskloop grainsize(1) default(shared)
+  for (unsigned block = 0; block < numBlocks; ++block) {
+    const unsigned first = 1 + block * SCORE_BLOCK;
+    const unsigned last = std::min(first + SCORE_BLOCK - 1, population);
+    unsigned count = 0;
+    for (unsigned index = first; index <= last; ++index) {
+      survivalScores[index] = selectionScore(peeps[index], criterion, sacrifice);
+      count += survivalScores[index] >= 0.0f ? 1 : 0;
+    }
+    blockOffsets[block + 1] = count;
+  }
+
+  std::partial_sum(blockOffsets.begin(), blockOffsets.end(), blockOffsets.begin());
+  parents.resize(blockOffsets[numBlocks]);
+
+#pragma omp taskloop grainsize(1) default(shared)
+  for (unsigned block = 0; block < numBlocks; ++block) {
+    const unsigned first = 1 + block * SCORE_BLOCK;
+    const unsigned last = std::min(first + SCORE_BLOCK - 1, population);
+    unsigned out = blockOffsets[block];
+    for (unsigned index = first; index <= last; ++index) {
+      if (survivalScores[index] >= 0.0f) {
+        parents[out++] = {static_cast<uint16_t>(index), survivalScores[index]};
+      }
+    }
+  }
+}
+
 /**
  * @brief Initialize generation 0 with random genomes at random locations
  *
@@ -125,7 +215,7 @@ void initializeNewGeneration(const std::vector<Genome>& parentGenomes, unsigned
  * @brief Perform natural selection and spawn the next generation
  *
  * This is the main generation transition function that:
- * 1. Evaluates which individuals passed survival criteria
+ * 1. Evaluates which individuals passed survival criteria (in parallel, see scorePopulation())
  * 2. Collects surviving genomes as the parent pool
  * 3. Handles special logic for the altruism challenge (kinship selection)
  * 4. Sorts parents by fitness score
@@ -138,13 +228,16 @@ void initializeNewGeneration(const std::vector<Genome>& parentGenomes, unsigned
  *
  * @param generation Current generation number
  * @param murderCount Number of individuals killed by other individuals this generation
+ * @param metrics Receives the generation's survivor, murder, genome-length and
+ *                diversity-sample columns (timing is filled in by the caller)
  *
  * @return Number of individuals that survived and will reproduce (parent count)
  *
- * @pre Must be called in single-thread mode between simulation generations
+ * @pre Must be called by one thread between simulation generations (inside the
+ *      simulator's `omp single`; the rest of the team runs the scoring tasks)
  * @pre Deferred death queue and move queue must be fully processed
  * @post New generation initialized with either parent-derived or random genomes
- * @post Generation statistics logged to epoch log
+ * @post @p metrics describes the generation that just ended
  *
  * @note Performance consideration: When many individuals survive, rebuilding
  *       all genomes and neural nets is inefficient. Could be optimized to reuse
@@ -155,12 +248,11 @@ void initializeNewGeneration(const std::vector<Genome>& parentGenomes, unsigned
  *
  * @see initializeNewGeneration() for parent-based spawning
  * @see initializeGeneration0() for random spawning when no survivors
- * @see passedSurvivalCriterion() for survival evaluation logic
+ * @see survivalCriterion() for survival evaluation logic
  */
-unsigned spawnNewGeneration(unsigned generation, unsigned murderCount) {
+unsigned spawnNewGeneration(unsigned generation, unsigned murderCount, IO::Metrics::GenerationMetrics& metrics) {
   unsigned sacrificedCount = 0;  ///< Number of individuals in sacrificial area (altruism challenge)
 
-  extern std::pair<bool, float> passedSurvivalCriterion(const Individual& indiv, unsigned challenge);
   extern void displaySignalUse();
 
   // Container holds indexes and survival scores (0.0..1.0) of survivors
@@ -170,42 +262,24 @@ unsigned spawnNewGeneration(unsigned generation, unsigned murderCount) {
   // Container will hold the genomes of the survivors
   std::vector<Genome> parentGenomes;
 
-  if (parameterMngrSingleton.challenge != CHALLENGE_ALTRUISM) {
-    // STANDARD CHALLENGES: Direct survival criterion evaluation
-    // Build list of individuals who will become parents, saving their scores
-    // for later sorting. Indices start at 1.
-    for (uint16_t index = 1; index <= parameterMngrSingleton.population; ++index) {
-      std::pair<bool, float> passed = passedSurvivalCriterion(peeps[index], parameterMngrSingleton.challenge);
-      // Save the parent genome only if it results in valid neural connections
-      // @todo Optimization: Could use std::move instead of copy if parents
-      //       no longer need their genome, though impact likely negligible
-      if (passed.first && !peeps[index].nnet.connections.empty()) {
-        parents.push_back({index, passed.second});
-      }
-    }
-  } else {
+  // Score everyone in parallel; parents come back in index order with their
+  // scores. For the altruism challenge these are the individuals in the
+  // spawning area, and those in the sacrificial area are marked SACRIFICED.
+  scorePopulation(parameterMngrSingleton.challenge, parents);
+
+  if (parameterMngrSingleton.challenge == CHALLENGE_ALTRUISM) {
     // ALTRUISM CHALLENGE: Kin selection with sacrificial and spawning areas
-    // Test if agents are in the sacrificial area (give life for others) or
-    // spawning area (reproduce). Count sacrifices and save spawners with scores.
-    // Indices start at 1.
+    // Count the sacrifices (or remember them for kinship). Indices start at 1.
 
     bool considerKinship = true;
     std::vector<uint16_t> sacrificesIndexes;  ///< Individuals who gave their lives
 
     for (uint16_t index = 1; index <= parameterMngrSingleton.population; ++index) {
-      // Test for spawning area
-      std::pair<bool, float> passed = passedSurvivalCriterion(peeps[index], CHALLENGE_ALTRUISM);
-      if (passed.first && !peeps[index].nnet.connections.empty()) {
-        parents.push_back({index, passed.second});
-      } else {
-        // Test for sacrificial area
-        passed = passedSurvivalCriterion(peeps[index], CHALLENGE_ALTRUISM_SACRIFICE);
-        if (passed.first && !peeps[index].nnet.connections.empty()) {
-          if (considerKinship) {
-            sacrificesIndexes.push_back(index);
-          } else {
-            ++sacrificedCount;
-          }
+      if (survivalScores[index] == SACRIFICED) {
+        if (considerKinship) {
+          sacrificesIndexes.push_back(index);
+        } else {
+          ++sacrificedCount;
         }
       }
     }
@@ -237,21 +311,27 @@ unsigned spawnNewGeneration(unsigned generation, unsigned murderCount) {
             }
           }
         }
-        fmt::print("{} passed, {} sacrificed, {} saved\n", parents.size(), sacrificesIndexes.size(),
-                   survivingKin.size());
+        BIOSIM_PRINT_THROTTLED("{} passed, {} sacrificed, {} saved", parents.size(), sacrificesIndexes.size(),
+                               survivingKin.size());
+        BIOSIM_LOG_DEBUG("Gen {} altruism: {} passed, {} sacrificed, {} saved", generation, parents.size(),
+                         sacrificesIndexes.size(), survivingKin.size());
         parents = std::move(survivingKin);
       }
     } else {
       // Limit the parent list based on sacrifice count
       unsigned numberSaved = sacrificedCount * altruismFactor;
-      fmt::print("{} passed, {} sacrificed, {} saved\n", parents.size(), sacrificedCount, numberSaved);
+      BIOSIM_PRINT_THROTTLED("{} passed, {} sacrificed, {} saved", parents.size(), sacrificedCount, numberSaved);
+      BIOSIM_LOG_DEBUG("Gen {} altruism: {} passed, {} sacrificed, {} saved", generation, parents.size(),
+                       sacrificedCount, numberSaved);
       if (!parents.empty() && numberSaved < parents.size()) {
         parents.erase(parents.begin() + numberSaved, parents.end());
       }
     }
   }
 
-  // Sort parent indices by fitness scores (descending order - highest first)
+  // Sort parent indices by fitness scores (descending order - highest first).
+  // The input is in index order for any thread count, so ties resolve as in
+  // the serial loop.
   std::sort(parents.begin(), parents.end(),
             [](const std::pair<uint16_t, float>& parent1, const std::pair<uint16_t, float>& parent2) {
               return parent1.second > parent2.second;
@@ -263,12 +343,35 @@ unsigned spawnNewGeneration(unsigned generation, unsigned murderCount) {
     parentGenomes.push_back(peeps[parent.first].genome);
   }
 
-  fmt::print("Gen {}, {} survivors\n", generation, parentGenomes.size());
-  ::BioSim::Utils::appendEpochLog(generation, parentGenomes.size(), murderCount);
+  BIOSIM_PRINT_THROTTLED("Gen {}, {} survivors", generation, parentGenomes.size());
+  BIOSIM_LOG_INFO("Gen {}, {} survivors", generation, parentGenomes.size());
+
+  // Fill the metrics row before the population is replaced. Diversity is only
+  // sampled here; the metrics writer thread does the genome comparisons. With
+  // no metrics log the draws are still made, so the run does not change.
+  metrics.generation = generation;
+  metrics.survivors = parentGenomes.size();
+  metrics.murders = murderCount;
+  metrics.alive = 0;
+  for (unsigned index = 1; index <= parameterMngrSingleton.population; ++index) {
+    metrics.alive += peeps[index].alive ? 1 : 0;
+  }
+  if (metricsWriter.enabled()) {
+    metrics.diversitySample = Genetics::sampleDiversityPairs();
+  } else {
+    Genetics::skipDiversityPairs();
+  }
+  metrics.averageGenomeLength = ::BioSim::Utils::averageGenomeLength();
+
   // displaySignalUse(); // Uncomment for debugging signal layer usage
 
   // At this point we have zero or more parent genomes
 
+  // The checkpoint captures this thread's stream before any of it is used for placement and mutation
+  if (replayRecorder.active()) {
+    replayRecorder.beginGeneration(parentGenomes.empty() ? 0 : generation + 1, parentGenomes);
+  }
+
   if (!parentGenomes.empty()) {
     // Spawn a new generation from surviving parents
     initializeNewGeneration(parentGenomes, generation + 1);
@@ -0,0 +1,101 @@
+/**
+ * @file spawnNewGeneration_test.cpp
+ * @brief Tests for parallel parent selection.
+ */
+
+#include "challenges.h"
+#include "simulator.h"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+extern void initializeGeneration0();
+extern void prepareSurvivalCriterion(unsigned challenge);
+extern void scorePopulation(unsigned challenge, std::vector<std::pair<uint16_t, float>>& parents);
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+
+using Core::Simulation::initializeGeneration0;
+using Core::Simulation::prepareSurvivalCriterion;
+using Core::Simulation::scorePopulation;
+using Core::Simulation::survivalCriterion;
+
+namespace {
+
+using Parents = std::vector<std::pair<uint16_t, float>>;
+
+constexpr uint16_t GRID_SIZE = 64;
+constexpr unsigned POPULATION = 1500;  ///< Several score blocks, the last one partial
+
+/** @brief Seeded generation 0 with every seventh individual dead */
+void initPopulation() {
+  initParamsForTesting(GRID_SIZE, GRID_SIZE);
+  Types::Params params = parameterMngrSingleton;
+  params.population = POPULATION;
+  params.genomeInitialLengthMin = 24;
+  params.genomeInitialLengthMax = 24;
+  params.genomeMaxLength = 300;
+  params.longProbeDistance = 16;
+  params.responsiveness = 0.5;
+  params.barrierType = 0;
+  params.deterministic = true;
+  params.RNGSeed = 12345678;
+  initParamsForTesting(params);
+  randomUint.initialize();
+
+  grid.initialize(GRID_SIZE, GRID_SIZE);
+  pheromones.initialize(params.signalLayers, GRID_SIZE, GRID_SIZE);
+  peeps.initialize(POPULATION);
+  initializeGeneration0();
+  for (unsigned index = 7; index <= POPULATION; index += 7) {
+    peeps[index].alive = false;
+  }
+}
+
+/** @brief The plain loop scorePopulation() replaced */
+Parents serialParents(unsigned challenge) {
+  prepareSurvivalCriterion(challenge);
+  const auto criterion = survivalCriterion(challenge);
+  Parents parents;
+  for (unsigned index = 1; index <= POPULATION; ++index) {
+    if (peeps[index].nnet.connections.empty()) {
+      continue;
+    }
+    const std::pair<bool, float> passed = criterion(peeps[index]);
+    if (passed.first) {
+      parents.emplace_back(static_cast<uint16_t>(index), passed.second);
+    }
+  }
+  return parents;
+}
+
+}  // namespace
+
+TEST(SpawnNewGenerationTest, ParallelScoringMatchesTheSerialLoop) {
+  initPopulation();
+
+  for (unsigned challenge : {CHALLENGE_CIRCLE, CHALLENGE_RIGHT_HALF, CHALLENGE_CORNER_WEIGHTED, CHALLENGE_STRING,
+                             CHALLENGE_CENTER_SPARSE, CHALLENGE_AGAINST_ANY_WALL, CHALLENGE_ALTRUISM}) {
+    const Parents expected = serialParents(challenge);
+
+    Parents singleThread;
+    scorePopulation(challenge, singleThread);
+
+    Parents tasks;
+#pragma omp parallel num_threads(4)
+#pragma omp single
+    scorePopulation(challenge, tasks);
+
+    ASSERT_EQ(singleThread, expected) << "challenge " << challenge;
+    ASSERT_EQ(tasks, expected) << "challenge " << challenge;
+  }
+}
+
+}  // namespace BioSim
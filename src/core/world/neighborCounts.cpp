@@ -0,0 +1,54 @@
+/**
+ * @file neighborCounts.cpp
+ * @brief Parallel construction of the per-cell 8-neighbor count field
+ */
+
+#include "neighborCounts.h"
+
+#include <algorithm>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace World {
+
+namespace {
+
+constexpr unsigned COLUMN_BLOCK = 16;  ///< Grid columns counted by one task
+
+inline unsigned isAgent(uint16_t cell) {
+  return cell != EMPTY && cell != BARRIER ? 1 : 0;
+}
+
+}  // namespace
+
+void NeighborCounts::build(const Grid& grid) {
+  const unsigned numColumns = grid.sizeX();
+  const unsigned numRows = grid.sizeY();
+  sizeY = numRows;
+  counts.resize(numColumns * numRows);
+
+#pragma omp taskloop grainsize(COLUMN_BLOCK) default(shared)
+  for (unsigned x = 0; x < numColumns; ++x) {
+    const unsigned firstColumn = x > 0 ? x - 1 : 0;
+    const unsigned lastColumn = std::min(x + 1, numColumns - 1);
+    uint8_t* out = &counts[x * numRows];
+    for (unsigned y = 0; y < numRows; ++y) {
+      const unsigned firstRow = y > 0 ? y - 1 : 0;
+      const unsigned lastRow = std::min(y + 1, numRows - 1);
+      unsigned count = 0;
+      for (unsigned column = firstColumn; column <= lastColumn; ++column) {
+        const Grid::Column& cells = grid[column];
+        for (unsigned row = firstRow; row <= lastRow; ++row) {
+          count += isAgent(cells[row]);
+        }
+      }
+      out[y] = static_cast<uint8_t>(count - isAgent(grid[x][y]));
+    }
+  }
+}
+
+}  // namespace World
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
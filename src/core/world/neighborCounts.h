@@ -0,0 +1,66 @@
+#ifndef BIOSIM4_SRC_CORE_WORLD_NEIGHBORCOUNTS_H_
+#define BIOSIM4_SRC_CORE_WORLD_NEIGHBORCOUNTS_H_
+
+/**
+ * @file neighborCounts.h
+ * @brief Per-cell count of agents in the surrounding 8 cells
+ *
+ * Density-based survival criteria (CHALLENGE_STRING, CHALLENGE_CENTER_SPARSE,
+ * CHALLENGE_PAIRS) ask how many agents surround a location. NeighborCounts
+ * answers that for every cell at once: build() makes one pass over the grid,
+ * after which each query is a single array read.
+ */
+
+#include "../../types/basicTypes.h"
+#include "grid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace World {
+
+/**
+ * @class NeighborCounts
+ * @brief Snapshot of the number of occupied 8-neighbors of each grid cell
+ *
+ * Only agents are counted (barriers and empty cells are not), the cell itself
+ * is excluded, and neighbors outside the grid do not exist. The counts are
+ * those of the grid at the last build() and are not updated as agents move.
+ */
+class NeighborCounts {
+ public:
+  /**
+   * @brief Recount every cell from the grid's current occupancy
+   *
+   * Columns are counted by an OpenMP taskloop: called from a single thread
+   * inside a parallel region, the rest of the team shares the work; anywhere
+   * else it runs on the calling thread.
+   *
+   * @param grid Grid to count (read only)
+   */
+  void build(const Grid& grid);
+
+  /**
+   * @brief Number of agents in the 8 cells around a location
+   * @param loc In-bounds grid coordinate
+   * @return 0..8
+   */
+  unsigned at(Coordinate loc) const { return counts[loc.x * sizeY + loc.y]; }
+
+ private:
+  std::vector<uint8_t> counts;  ///< Column-major, like Grid
+  uint16_t sizeY = 0;           ///< Rows per column
+};
+
+}  // namespace World
+}  // namespace Core
+}  // namespace v1
+
+using Core::World::NeighborCounts;
+
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_CORE_WORLD_NEIGHBORCOUNTS_H_
@@ -0,0 +1,45 @@
+/**
+ * @file neighborCounts_test.cpp
+ * @brief Tests for the per-cell 8-neighbor count field.
+ */
+
+#include "../simulation/simulator.h"
+#include "neighborCounts.h"
+
+#include <gtest/gtest.h>
+
+namespace BioSim {
+
+TEST(NeighborCountsTest, MatchesNeighborhoodScanIncludingEdgesAndBarriers) {
+  initParamsForTesting(13, 9);
+  Grid world;
+  world.initialize(13, 9);
+  uint16_t index = 1;
+  for (int16_t x = 0; x < 13; ++x) {
+    for (int16_t y = 0; y < 9; ++y) {
+      const unsigned pattern = (x * 7 + y * 3 + x * y) % 5;
+      if (pattern == 0) {
+        world.set(x, y, BARRIER);
+      } else if (pattern < 3) {
+        world.set(x, y, index++);
+      }
+    }
+  }
+
+  NeighborCounts counts;
+  counts.build(world);
+  for (int16_t x = 0; x < 13; ++x) {
+    for (int16_t y = 0; y < 9; ++y) {
+      const Coordinate loc{x, y};
+      unsigned expected = 0;
+      visitNeighborhood(loc, 1.5, [&](Coordinate neighbor) {
+        if (neighbor != loc && world.isOccupiedAt(neighbor)) {
+          ++expected;
+        }
+      });
+      EXPECT_EQ(counts.at(loc), expected) << "at " << x << ", " << y;
+    }
+  }
+}
+
+}  // namespace BioSim
@@ -72,6 +72,17 @@ struct Signals {
      */
     uint8_t operator[](uint16_t rowNum) const { return data[rowNum]; }
 
+    /**
+     * @brief Contiguous cell storage, for bulk copies
+     * @return Pointer to the first of size() cells
+     */
+    const uint8_t* cells() const { return data.data(); }
+
+    /**
+     * @brief Number of cells (rows) in the column
+     */
+    size_t size() const { return data.size(); }
+
     /**
      * @brief Clear all cells to 0
      */
@@ -6,6 +6,7 @@
 #include "configManager.h"
 
 #include "../../utils/logger.h"
+#include "../metrics/metricsWriter.h"
 
 #include <spdlog/fmt/fmt.h>
 
@@ -21,6 +22,18 @@ inline namespace v1 {
 namespace IO {
 namespace Config {
 
+namespace {
+
+/// Rejects a negative config value before it is stored in an unsigned field.
+unsigned nonNegative(int value, const char* key) {
+  if (value < 0) {
+    throw std::invalid_argument(std::string(key) + " must be >= 0, got " + std::to_string(value));
+  }
+  return static_cast<unsigned>(value);
+}
+
+}  // namespace
+
 ConfigManager::ConfigManager() {
   // Initialize with built-in defaults (from legacy ParamManager)
   params_ = Params{};  // Uses default initialization
@@ -60,6 +73,24 @@ ConfigManager::ConfigManager() {
   params_.saveVideo = true;
   params_.videoStride = 25;
   params_.videoSaveFirstFrames = 2;
+  params_.videoAsync = true;
+  params_.videoQueueFrames = 8;
+  params_.videoEncodeWorkers = 2;
+  params_.videoEncodeMemoryMB = 512;
+  params_.renderBackend = "software";
+  params_.videoEncoderProfile = "medium";
+  params_.videoEncoderThreads = 1;
+  params_.videoTrace = false;
+  params_.videoTraceSignals = false;
+  params_.videoLiveRing = "";
+  params_.videoLiveRingSlots = 8;
+  params_.videoFrameStride = 1;
+  params_.videoDeathTrigger = 0.0;
+  params_.videoSurvivorTrigger = 0.0;
+  params_.videoRoiX = 0;
+  params_.videoRoiY = 0;
+  params_.videoRoiWidth = 0;
+  params_.videoRoiHeight = 0;
   params_.displayScale = 8;
   params_.agentSize = 4;
   params_.genomeAnalysisStride = params_.videoStride;
@@ -67,6 +98,16 @@ ConfigManager::ConfigManager() {
   params_.genomeComparisonMethod = 1;
   params_.updateGraphLog = true;
   params_.updateGraphLogStride = params_.videoStride;
+  params_.metricsFormat = "csv";
+  params_.metricsQueueCapacity = 1024;
+  params_.metricsQueueMemoryMB = 64;
+  params_.metricsFlushRows = 16;
+  params_.metricsFlushIntervalMs = 1000;
+  params_.metricsEndpoint = "";
+  params_.logQueueSize = 8192;
+  params_.logConsoleIntervalMs = 1000;
+  params_.replayCheckpoints = false;
+  params_.replayDir = "./output/replay/";
   params_.deterministic = false;
   params_.RNGSeed = 12345678;
   params_.parameterChangeGenerationNumber = 0;
@@ -178,6 +219,42 @@ bool ConfigManager::loadFromToml(const std::filesystem::path& path) {
         params_.videoStride = toml::find<int>(vid, "videoStride");
       if (vid.contains("videoSaveFirstFrames"))
         params_.videoSaveFirstFrames = toml::find<int>(vid, "videoSaveFirstFrames");
+      if (vid.contains("videoAsync"))
+        params_.videoAsync = toml::find<bool>(vid, "videoAsync");
+      if (vid.contains("videoQueueFrames"))
+        params_.videoQueueFrames = toml::find<int>(vid, "videoQueueFrames");
+      if (vid.contains("videoEncodeWorkers"))
+        params_.videoEncodeWorkers = toml::find<int>(vid, "videoEncodeWorkers");
+      if (vid.contains("videoEncodeMemoryMB"))
+        params_.videoEncodeMemoryMB = toml::find<int>(vid, "videoEncodeMemoryMB");
+      if (vid.contains("renderBackend"))
+        params_.renderBackend = toml::find<std::string>(vid, "renderBackend");
+      if (vid.contains("videoEncoderProfile"))
+        params_.videoEncoderProfile = toml::find<std::string>(vid, "videoEncoderProfile");
+      if (vid.contains("videoEncoderThreads"))
+        params_.videoEncoderThreads = toml::find<int>(vid, "videoEncoderThreads");
+      if (vid.contains("videoTrace"))
+        params_.videoTrace = toml::find<bool>(vid, "videoTrace");
+      if (vid.contains("videoTraceSignals"))
+        params_.videoTraceSignals = toml::find<bool>(vid, "videoTraceSignals");
+      if (vid.contains("videoLiveRing"))
+        params_.videoLiveRing = toml::find<std::string>(vid, "videoLiveRing");
+      if (vid.contains("videoLiveRingSlots"))
+        params_.videoLiveRingSlots = toml::find<int>(vid, "videoLiveRingSlots");
+      if (vid.contains("videoFrameStride"))
+        params_.videoFrameStride = toml::find<int>(vid, "videoFrameStride");
+      if (vid.contains("videoDeathTrigger"))
+        params_.videoDeathTrigger = toml::find<double>(vid, "videoDeathTrigger");
+      if (vid.contains("videoSurvivorTrigger"))
+        params_.videoSurvivorTrigger = toml::find<double>(vid, "videoSurvivorTrigger");
+      if (vid.contains("videoRoiX"))
+        params_.videoRoiX = nonNegative(toml::find<int>(vid, "videoRoiX"), "videoRoiX");
+      if (vid.contains("videoRoiY"))
+        params_.videoRoiY = nonNegative(toml::find<int>(vid, "videoRoiY"), "videoRoiY");
+      if (vid.contains("videoRoiWidth"))
+        params_.videoRoiWidth = nonNegative(toml::find<int>(vid, "videoRoiWidth"), "videoRoiWidth");
+      if (vid.contains("videoRoiHeight"))
+        params_.videoRoiHeight = nonNegative(toml::find<int>(vid, "videoRoiHeight"), "videoRoiHeight");
       if (vid.contains("displayScale"))
         params_.displayScale = toml::find<int>(vid, "displayScale");
     }
@@ -189,6 +266,41 @@ bool ConfigManager::loadFromToml(const std::filesystem::path& path) {
         params_.numThreads = toml::find<int>(perf, "numThreads");
     }
 
+    // [metrics] section
+    if (data.contains("metrics")) {
+      const auto& met = toml::find(data, "metrics");
+      if (met.contains("format"))
+        params_.metricsFormat = toml::find<std::string>(met, "format");
+      if (met.contains("queueCapacity"))
+        params_.metricsQueueCapacity = toml::find<int>(met, "queueCapacity");
+      if (met.contains("queueMemoryMB"))
+        params_.metricsQueueMemoryMB = toml::find<int>(met, "queueMemoryMB");
+      if (met.contains("flushRows"))
+        params_.metricsFlushRows = toml::find<int>(met, "flushRows");
+      if (met.contains("flushIntervalMs"))
+        params_.metricsFlushIntervalMs = toml::find<int>(met, "flushIntervalMs");
+      if (met.contains("endpoint"))
+        params_.metricsEndpoint = toml::find<std::string>(met, "endpoint");
+    }
+
+    // [logging] section
+    if (data.contains("logging")) {
+      const auto& log = toml::find(data, "logging");
+      if (log.contains("queueSize"))
+        params_.logQueueSize = toml::find<int>(log, "queueSize");
+      if (log.contains("consoleIntervalMs"))
+        params_.logConsoleIntervalMs = toml::find<int>(log, "consoleIntervalMs");
+    }
+
+    // [replay] section
+    if (data.contains("replay")) {
+      const auto& rep = toml::find(data, "replay");
+      if (rep.contains("checkpoints"))
+        params_.replayCheckpoints = toml::find<bool>(rep, "checkpoints");
+      if (rep.contains("dir"))
+        params_.replayDir = toml::find<std::string>(rep, "dir");
+    }
+
     // [challenge] section
     if (data.contains("challenge")) {
       const auto& chal = toml::find(data, "challenge");
@@ -336,6 +448,48 @@ bool ConfigManager::setParameterInternal(const std::string& key, const std::stri
       params_.videoStride = std::stoi(value);
     } else if (key == "videoSaveFirstFrames") {
       params_.videoSaveFirstFrames = std::stoi(value);
+    } else if (key == "videoAsync") {
+      std::string v = value;
+      std::transform(v.begin(), v.end(), v.begin(), ::tolower);
+      params_.videoAsync = (v == "true" || v == "1" || v == "yes");
+    } else if (key == "videoQueueFrames") {
+      params_.videoQueueFrames = std::stoi(value);
+    } else if (key == "videoEncodeWorkers") {
+      params_.videoEncodeWorkers = std::stoi(value);
+    } else if (key == "videoEncodeMemoryMB") {
+      params_.videoEncodeMemoryMB = std::stoi(value);
+    } else if (key == "renderBackend") {
+      params_.renderBackend = value;
+    } else if (key == "videoEncoderProfile") {
+      params_.videoEncoderProfile = value;
+    } else if (key == "videoEncoderThreads") {
+      params_.videoEncoderThreads = std::stoi(value);
+    } else if (key == "videoTrace") {
+      std::string v = value;
+      std::transform(v.begin(), v.end(), v.begin(), ::tolower);
+      params_.videoTrace = (v == "true" || v == "1" || v == "yes");
+    } else if (key == "videoTraceSignals") {
+      std::string v = value;
+      std::transform(v.begin(), v.end(), v.begin(), ::tolower);
+      params_.videoTraceSignals = (v == "true" || v == "1" || v == "yes");
+    } else if (key == "videoLiveRing") {
+      params_.videoLiveRing = value;
+    } else if (key == "videoLiveRingSlots") {
+      params_.videoLiveRingSlots = std::stoi(value);
+    } else if (key == "videoFrameStride") {
+      params_.videoFrameStride = std::stoi(value);
+    } else if (key == "videoDeathTrigger") {
+      params_.videoDeathTrigger = std::stof(value);
+    } else if (key == "videoSurvivorTrigger") {
+      params_.videoSurvivorTrigger = std::stof(value);
+    } else if (key == "videoRoiX") {
+      params_.videoRoiX = nonNegative(std::stoi(value), "videoRoiX");
+    } else if (key == "videoRoiY") {
+      params_.videoRoiY = nonNegative(std::stoi(value), "videoRoiY");
+    } else if (key == "videoRoiWidth") {
+      params_.videoRoiWidth = nonNegative(std::stoi(value), "videoRoiWidth");
+    } else if (key == "videoRoiHeight") {
+      params_.videoRoiHeight = nonNegative(std::stoi(value), "videoRoiHeight");
     } else if (key == "displayScale") {
       params_.displayScale = std::stoi(value);
     }
@@ -343,6 +497,34 @@ bool ConfigManager::setParameterInternal(const std::string& key, const std::stri
     else if (key == "numThreads") {
       params_.numThreads = std::stoi(value);
     }
+    // Metrics parameters
+    else if (key == "metricsFormat") {
+      params_.metricsFormat = value;
+    } else if (key == "metricsQueueCapacity") {
+      params_.metricsQueueCapacity = std::stoi(value);
+    } else if (key == "metricsQueueMemoryMB") {
+      params_.metricsQueueMemoryMB = std::stoi(value);
+    } else if (key == "metricsFlushRows") {
+      params_.metricsFlushRows = std::stoi(value);
+    } else if (key == "metricsFlushIntervalMs") {
+      params_.metricsFlushIntervalMs = std::stoi(value);
+    } else if (key == "metricsEndpoint") {
+      params_.metricsEndpoint = value;
+    }
+    // Logging parameters
+    else if (key == "logQueueSize") {
+      params_.logQueueSize = std::stoi(value);
+    } else if (key == "logConsoleIntervalMs") {
+      params_.logConsoleIntervalMs = std::stoi(value);
+    }
+    // Replay parameters
+    else if (key == "replayCheckpoints") {
+      std::string v = value;
+      std::transform(v.begin(), v.end(), v.begin(), ::tolower);
+      params_.replayCheckpoints = (v == "true" || v == "1" || v == "yes");
+    } else if (key == "replayDir") {
+      params_.replayDir = value;
+    }
     // Challenge parameter
     else if (key == "challenge") {
       params_.challenge = std::stoi(value);
@@ -403,6 +585,55 @@ void ConfigManager::validate() const {
   if (params_.displayScale < 1 || params_.displayScale > 32) {
     throw std::invalid_argument("displayScale must be 1-32, got " + std::to_string(params_.displayScale));
   }
+  if (params_.videoQueueFrames < 1) {
+    throw std::invalid_argument("videoQueueFrames must be >= 1");
+  }
+  if (params_.videoEncodeWorkers < 1) {
+    throw std::invalid_argument("videoEncodeWorkers must be >= 1");
+  }
+  if (params_.videoLiveRingSlots < 2) {
+    throw std::invalid_argument("videoLiveRingSlots must be >= 2, got " + std::to_string(params_.videoLiveRingSlots));
+  }
+  if (params_.videoFrameStride < 1) {
+    throw std::invalid_argument("videoFrameStride must be >= 1");
+  }
+  if (params_.videoDeathTrigger < 0.0f || params_.videoDeathTrigger > 1.0f) {
+    throw std::invalid_argument("videoDeathTrigger must be 0.0-1.0");
+  }
+  if (params_.videoSurvivorTrigger < 0.0f || params_.videoSurvivorTrigger > 1.0f) {
+    throw std::invalid_argument("videoSurvivorTrigger must be 0.0-1.0");
+  }
+  if ((params_.videoRoiWidth == 0) != (params_.videoRoiHeight == 0)) {
+    throw std::invalid_argument("videoRoiWidth and videoRoiHeight must both be 0 or both be set");
+  }
+  // Compare each part separately: summing the unsigned origin and extent could wrap.
+  if (params_.videoRoiWidth > 0 &&
+      !(params_.videoRoiX < params_.gridSize_X && params_.videoRoiWidth <= params_.gridSize_X - params_.videoRoiX &&
+        params_.videoRoiY < params_.gridSize_Y && params_.videoRoiHeight <= params_.gridSize_Y - params_.videoRoiY)) {
+    throw std::invalid_argument("videoRoi must lie within the " + std::to_string(params_.gridSize_X) + " x " +
+                                std::to_string(params_.gridSize_Y) + " grid");
+  }
+  if (params_.renderBackend != "software" && params_.renderBackend != "raylib") {
+    throw std::invalid_argument("renderBackend must be 'software' or 'raylib', got '" + params_.renderBackend + "'");
+  }
+  if (params_.videoEncoderProfile != "medium" && params_.videoEncoderProfile != "superfast" &&
+      params_.videoEncoderProfile != "ultrafast" && params_.videoEncoderProfile != "lossless" &&
+      params_.videoEncoderProfile != "raw") {
+    throw std::invalid_argument(
+        "videoEncoderProfile must be 'medium', 'superfast', 'ultrafast', 'lossless' or 'raw', got '" +
+        params_.videoEncoderProfile + "'");
+  }
+
+  // Metrics validation
+  IO::Metrics::parseMetricsFormat(params_.metricsFormat);
+  if (params_.metricsQueueCapacity < 1) {
+    throw std::invalid_argument("metricsQueueCapacity must be >= 1");
+  }
+
+  // Logging validation
+  if (params_.logQueueSize < 1) {
+    throw std::invalid_argument("logQueueSize must be >= 1");
+  }
 }
 
 void ConfigManager::applyEnvironmentOverrides() {
@@ -466,11 +697,45 @@ void ConfigManager::exportToFile(const std::string& path) const {
   file << "saveVideo = " << (params_.saveVideo ? "true" : "false") << "\n";
   file << "videoStride = " << params_.videoStride << "\n";
   file << "videoSaveFirstFrames = " << params_.videoSaveFirstFrames << "\n";
+  file << "videoAsync = " << (params_.videoAsync ? "true" : "false") << "\n";
+  file << "videoQueueFrames = " << params_.videoQueueFrames << "\n";
+  file << "videoEncodeWorkers = " << params_.videoEncodeWorkers << "\n";
+  file << "videoEncodeMemoryMB = " << params_.videoEncodeMemoryMB << "\n";
+  file << "renderBackend = \"" << params_.renderBackend << "\"\n";
+  file << "videoEncoderProfile = \"" << params_.videoEncoderProfile << "\"\n";
+  file << "videoEncoderThreads = " << params_.videoEncoderThreads << "\n";
+  file << "videoTrace = " << (params_.videoTrace ? "true" : "false") << "\n";
+  file << "videoTraceSignals = " << (params_.videoTraceSignals ? "true" : "false") << "\n";
+  file << "videoLiveRing = \"" << params_.videoLiveRing << "\"\n";
+  file << "videoLiveRingSlots = " << params_.videoLiveRingSlots << "\n";
+  file << "videoFrameStride = " << params_.videoFrameStride << "\n";
+  file << "videoDeathTrigger = " << params_.videoDeathTrigger << "\n";
+  file << "videoSurvivorTrigger = " << params_.videoSurvivorTrigger << "\n";
+  file << "videoRoiX = " << params_.videoRoiX << "\n";
+  file << "videoRoiY = " << params_.videoRoiY << "\n";
+  file << "videoRoiWidth = " << params_.videoRoiWidth << "\n";
+  file << "videoRoiHeight = " << params_.videoRoiHeight << "\n";
   file << "displayScale = " << params_.displayScale << "\n\n";
 
   file << "[performance]\n";
   file << "numThreads = " << params_.numThreads << "\n\n";
 
+  file << "[metrics]\n";
+  file << "format = \"" << params_.metricsFormat << "\"\n";
+  file << "queueCapacity = " << params_.metricsQueueCapacity << "\n";
+  file << "queueMemoryMB = " << params_.metricsQueueMemoryMB << "\n";
+  file << "flushRows = " << params_.metricsFlushRows << "\n";
+  file << "flushIntervalMs = " << params_.metricsFlushIntervalMs << "\n";
+  file << "endpoint = \"" << params_.metricsEndpoint << "\"\n\n";
+
+  file << "[logging]\n";
+  file << "queueSize = " << params_.logQueueSize << "\n";
+  file << "consoleIntervalMs = " << params_.logConsoleIntervalMs << "\n\n";
+
+  file << "[replay]\n";
+  file << "checkpoints = " << (params_.replayCheckpoints ? "true" : "false") << "\n";
+  file << "dir = \"" << params_.replayDir << "\"\n\n";
+
   file << "[challenge]\n";
   file << "challenge = " << params_.challenge << "\n";
 
@@ -498,13 +763,55 @@ void ConfigManager::printConfig(bool showDefaults) const {
   if (params_.saveVideo) {
     fmt::print("  Video stride: {}\n", params_.videoStride);
     fmt::print("  Save first: {} frames\n", params_.videoSaveFirstFrames);
+    if (params_.videoAsync) {
+      fmt::print("  Pipeline: async, {} workers x {} queued frames", params_.videoEncodeWorkers,
+                 params_.videoQueueFrames);
+      if (params_.videoEncodeMemoryMB > 0) {
+        fmt::print(" (max {} MiB)", params_.videoEncodeMemoryMB);
+      }
+      fmt::print("\n");
+    } else {
+      fmt::print("  Pipeline: sync\n");
+    }
+    fmt::print("  Render backend: {}\n", params_.renderBackend);
+    fmt::print("  Encoder: {} profile, {} threads per video\n", params_.videoEncoderProfile,
+               params_.videoEncoderThreads == 0 ? std::string("auto") : std::to_string(params_.videoEncoderThreads));
+    if (params_.videoTrace) {
+      fmt::print("  Trace recording: on{}\n", params_.videoTraceSignals ? " (with signals)" : "");
+    }
+    if (params_.videoFrameStride > 1 || params_.videoDeathTrigger > 0.0f || params_.videoSurvivorTrigger > 0.0f) {
+      fmt::print("  Frame sampling: every {} steps, death trigger {}, survivor trigger {}\n", params_.videoFrameStride,
+                 params_.videoDeathTrigger, params_.videoSurvivorTrigger);
+    }
+    if (params_.videoRoiWidth > 0) {
+      fmt::print("  Region of interest: {} x {} at ({}, {})\n", params_.videoRoiWidth, params_.videoRoiHeight,
+                 params_.videoRoiX, params_.videoRoiY);
+    }
     fmt::print("  Display scale: {}x\n", params_.displayScale);
   }
+  if (!params_.videoLiveRing.empty()) {
+    fmt::print("  Live ring: {} ({} slots)\n", params_.videoLiveRing, params_.videoLiveRingSlots);
+  }
   fmt::print("\n");
 
   fmt::print("Performance:\n");
   fmt::print("  Threads: {}\n\n", params_.numThreads == 0 ? "auto" : std::to_string(params_.numThreads));
 
+  fmt::print("Metrics:\n");
+  fmt::print("  Format: {}\n", params_.metricsFormat);
+  if (params_.metricsFormat != "none") {
+    fmt::print("  Flush: every {} rows / {} ms\n", params_.metricsFlushRows, params_.metricsFlushIntervalMs);
+  }
+  if (!params_.metricsEndpoint.empty()) {
+    fmt::print("  Endpoint: {}\n", params_.metricsEndpoint);
+  }
+  fmt::print("\n");
+
+  if (params_.replayCheckpoints) {
+    fmt::print("Replay:\n");
+    fmt::print("  Checkpoints: {}\n\n", params_.replayDir);
+  }
+
   if (loadedConfigPath_) {
     fmt::print("📄 Loaded from: {}\n", *loadedConfigPath_);
   } else {
@@ -0,0 +1,301 @@
+/**
+ * @file liveRing.cpp
+ * @brief Implementation of the shared-memory live ring
+ */
+
+#include "liveRing.h"
+
+#include "../../core/simulation/simulator.h"
+#include "../../utils/logger.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Live {
+
+using Utils::Logger;
+
+namespace {
+
+constexpr size_t alignUp(size_t value) {
+  return (value + 63) & ~size_t(63);
+}
+
+size_t barrierMaskBytes(uint16_t sizeX, uint16_t sizeY) {
+  return (size_t(sizeX) * sizeY + 7) / 8;
+}
+
+const LiveSlotHeader* slotAt(const LiveRingHeader* header, uint64_t frame) {
+  const uint8_t* first = reinterpret_cast<const uint8_t*>(header) + sizeof(LiveRingHeader);
+  return reinterpret_cast<const LiveSlotHeader*>(first + ((frame - 1) % header->slotCount) * header->slotBytes);
+}
+
+}  // namespace
+
+LiveRingWriter liveRing;
+
+std::string liveRingName(const std::string& name) {
+  return name.empty() || name.front() == '/' ? name : "/" + name;
+}
+
+// ============================================================================
+// Writer
+// ============================================================================
+
+LiveRingWriter::~LiveRingWriter() {
+  close();
+}
+
+bool LiveRingWriter::open(const std::string& name, unsigned slotCount, uint16_t sizeX, uint16_t sizeY,
+                          unsigned signalLayers, unsigned maxAgents) {
+  close();
+  name_ = liveRingName(name);
+
+  const size_t agentsOffset = alignUp(sizeof(LiveSlotHeader));
+  const size_t barrierMaskOffset = agentsOffset + alignUp(size_t(maxAgents) * sizeof(LiveAgent));
+  const size_t signalsOffset = barrierMaskOffset + alignUp(barrierMaskBytes(sizeX, sizeY));
+  const size_t slotBytes = signalsOffset + alignUp(size_t(signalLayers) * sizeX * sizeY);
+  const size_t totalBytes = sizeof(LiveRingHeader) + size_t(slotCount) * slotBytes;
+
+  // A ring left by a crashed run is replaced; viewers still attached to it keep their mapping
+  ::shm_unlink(name_.c_str());
+  const int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    Logger::warning("Could not create live ring {}: {}", name_, std::strerror(errno));
+    return false;
+  }
+  if (::ftruncate(fd, static_cast<off_t>(totalBytes)) != 0) {
+    Logger::warning("Could not size live ring {} to {} bytes: {}", name_, totalBytes, std::strerror(errno));
+    ::close(fd);
+    ::shm_unlink(name_.c_str());
+    return false;
+  }
+  void* mapping = ::mmap(nullptr, totalBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    Logger::warning("Could not map live ring {}: {}", name_, std::strerror(errno));
+    ::shm_unlink(name_.c_str());
+    return false;
+  }
+
+  // The mapping starts zeroed: every slot sequence is 0 and latestFrame is 0
+  header_ = static_cast<LiveRingHeader*>(mapping);
+  mappedBytes_ = totalBytes;
+  header_->version = LIVE_RING_VERSION;
+  header_->slotCount = slotCount;
+  header_->slotBytes = slotBytes;
+  header_->sizeX = sizeX;
+  header_->sizeY = sizeY;
+  header_->signalLayers = signalLayers;
+  header_->maxAgents = maxAgents;
+  header_->agentsOffset = static_cast<uint32_t>(agentsOffset);
+  header_->barrierMaskOffset = static_cast<uint32_t>(barrierMaskOffset);
+  header_->signalsOffset = static_cast<uint32_t>(signalsOffset);
+  header_->writerAlive.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(header_->magic, LIVE_RING_MAGIC, sizeof(header_->magic));  // Readers check the magic last
+
+  nextFrame_ = 1;
+  barrierMask_.clear();
+  Logger::info("Publishing live frames to shared memory {} ({} slots, {:.1f} MiB)", name_, slotCount,
+               totalBytes / (1024.0 * 1024.0));
+  return true;
+}
+
+void LiveRingWriter::close() {
+  if (!header_) {
+    return;
+  }
+  header_->writerAlive.store(0, std::memory_order_release);
+  ::munmap(header_, mappedBytes_);
+  ::shm_unlink(name_.c_str());
+  header_ = nullptr;
+  mappedBytes_ = 0;
+}
+
+LiveSlotHeader* LiveRingWriter::beginFrame(unsigned simStep, unsigned generation, unsigned challenge,
+                                           unsigned barrierType) {
+  auto* slot = const_cast<LiveSlotHeader*>(slotAt(header_, nextFrame_));
+  slot->sequence.store(2 * nextFrame_ - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);  // Odd sequence is visible before any payload write
+  slot->generation = generation;
+  slot->simStep = simStep;
+  slot->challenge = challenge;
+  slot->barrierType = barrierType;
+  return slot;
+}
+
+void LiveRingWriter::commitFrame(LiveSlotHeader* slot, uint32_t agentCount) {
+  slot->agentCount = agentCount;
+  slot->sequence.store(2 * nextFrame_, std::memory_order_release);
+  header_->latestFrame.store(nextFrame_, std::memory_order_release);
+  ++nextFrame_;
+}
+
+void LiveRingWriter::buildBarrierMask(const std::vector<Coordinate>& barriers, unsigned barrierType) {
+  barrierMask_.assign(barrierMaskBytes(header_->sizeX, header_->sizeY), 0);
+  for (const Coordinate& loc : barriers) {
+    const size_t cell = size_t(loc.x) * header_->sizeY + loc.y;
+    barrierMask_[cell / 8] |= uint8_t(1u << (cell % 8));
+  }
+  barrierMaskType_ = barrierType;
+}
+
+void LiveRingWriter::publishWorld(unsigned simStep, unsigned generation, unsigned challenge, unsigned barrierType) {
+  const auto& p = parameterMngrSingleton;
+  LiveSlotHeader* slot = beginFrame(simStep, generation, challenge, barrierType);
+  auto* agents = reinterpret_cast<LiveAgent*>(slotData(slot, header_->agentsOffset));
+  uint32_t agentCount = 0;
+  for (unsigned index = 1; index <= p.population && agentCount < header_->maxAgents; ++index) {
+    const auto& indiv = peeps[index];
+    if (indiv.alive) {
+      agents[agentCount++] = LiveAgent{indiv.loc.x, indiv.loc.y, indiv.colorIndex, 0};
+    }
+  }
+
+  // Barriers are only created when a generation is spawned (some layouts are random per generation)
+  if (simStep == 0 || barrierMask_.empty() || barrierType != barrierMaskType_) {
+    buildBarrierMask(grid.getBarrierLocations(), barrierType);
+  }
+  std::memcpy(slotData(slot, header_->barrierMaskOffset), barrierMask_.data(), barrierMask_.size());
+
+  uint8_t* cells = slotData(slot, header_->signalsOffset);
+  for (unsigned layerNum = 0; layerNum < header_->signalLayers; ++layerNum) {
+    for (int16_t x = 0; x < header_->sizeX; ++x) {
+      std::memcpy(cells, pheromones[layerNum][x].cells(), header_->sizeY);
+      cells += header_->sizeY;
+    }
+  }
+  commitFrame(slot, agentCount);
+}
+
+// ============================================================================
+// Reader
+// ============================================================================
+
+LiveRingReader::~LiveRingReader() {
+  detach();
+}
+
+bool LiveRingReader::attach(const std::string& name) {
+  detach();
+  const std::string shmName = liveRingName(name);
+  const int fd = ::shm_open(shmName.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    Logger::error("No live ring named {}: {}", shmName, std::strerror(errno));
+    return false;
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(LiveRingHeader)) {
+    Logger::error("Live ring {} is not initialized", shmName);
+    ::close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(info.st_size);
+  void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    Logger::error("Could not map live ring {}: {}", shmName, std::strerror(errno));
+    return false;
+  }
+
+  const auto* header = static_cast<const LiveRingHeader*>(mapping);
+  const bool hasMagic = std::memcmp(header->magic, LIVE_RING_MAGIC, sizeof(header->magic)) == 0;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const bool valid = hasMagic && header->version == LIVE_RING_VERSION && header->slotCount > 0 &&
+                     header->slotBytes >= header->signalsOffset + size_t(header->signalLayers) * header->sizeX *
+                                                                      header->sizeY &&
+                     sizeof(LiveRingHeader) + header->slotCount * header->slotBytes <= size;
+  if (!valid) {
+    Logger::error("{} is not a live ring (version {})", shmName, LIVE_RING_VERSION);
+    ::munmap(mapping, size);
+    return false;
+  }
+  header_ = header;
+  mappedBytes_ = size;
+  return true;
+}
+
+void LiveRingReader::detach() {
+  if (!header_) {
+    return;
+  }
+  ::munmap(const_cast<LiveRingHeader*>(header_), mappedBytes_);
+  header_ = nullptr;
+  mappedBytes_ = 0;
+}
+
+bool LiveRingReader::view(uint64_t frame, LiveFrame& out) const {
+  if (frame == 0) {
+    return false;
+  }
+  const LiveSlotHeader* slot = slotAt(header_, frame);
+  if (slot->sequence.load(std::memory_order_acquire) != 2 * frame) {
+    return false;
+  }
+  const auto* base = reinterpret_cast<const uint8_t*>(slot);
+  out.frame = frame;
+  out.generation = slot->generation;
+  out.simStep = slot->simStep;
+  out.challenge = slot->challenge;
+  out.barrierType = slot->barrierType;
+  out.agentCount = std::min(slot->agentCount, header_->maxAgents);
+  out.agents = reinterpret_cast<const LiveAgent*>(base + header_->agentsOffset);
+  out.barrierMask = base + header_->barrierMaskOffset;
+  out.signals = base + header_->signalsOffset;
+  out.slot = slot;
+  return stillValid(out);
+}
+
+bool LiveRingReader::stillValid(const LiveFrame& frame) const {
+  std::atomic_thread_fence(std::memory_order_acquire);  // Everything read so far happens before this check
+  return frame.slot && frame.slot->sequence.load(std::memory_order_relaxed) == 2 * frame.frame;
+}
+
+bool LiveRingReader::readFrame(uint64_t frame, ImageFrameData& out) const {
+  LiveFrame live;
+  if (!view(frame, live)) {
+    return false;
+  }
+  const auto& h = *header_;
+  if (out.signalLayerCount != h.signalLayers || out.sizeX != h.sizeX || out.sizeY != h.sizeY) {
+    out.allocate(h.signalLayers, h.sizeX, h.sizeY, h.maxAgents);
+  }
+  out.simStep = live.simStep;
+  out.generation = live.generation;
+  out.challenge = live.challenge;
+  out.barrierType = live.barrierType;
+
+  out.indivLocs.clear();
+  out.indivColors.clear();
+  for (uint32_t i = 0; i < live.agentCount; ++i) {
+    out.indivLocs.push_back(Coordinate(live.agents[i].x, live.agents[i].y));
+    out.indivColors.push_back(live.agents[i].color);
+  }
+
+  out.barrierLocs.clear();
+  for (size_t byte = 0; byte < barrierMaskBytes(h.sizeX, h.sizeY); ++byte) {
+    for (uint8_t bits = live.barrierMask[byte]; bits != 0; bits = uint8_t(bits & (bits - 1))) {
+      const size_t cell = byte * 8 + std::countr_zero(bits);
+      out.barrierLocs.push_back(Coordinate(static_cast<int16_t>(cell / h.sizeY), static_cast<int16_t>(cell % h.sizeY)));
+    }
+  }
+
+  std::memcpy(out.signalData.data(), live.signals, out.signalData.size());
+  return stillValid(live);
+}
+
+}  // namespace Live
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
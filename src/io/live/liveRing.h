@@ -0,0 +1,245 @@
+#ifndef BIOSIM4_SRC_IO_LIVE_LIVERING_H_
+#define BIOSIM4_SRC_IO_LIVE_LIVERING_H_
+
+/**
+ * @file liveRing.h
+ * @brief World state published to a POSIX shared-memory ring for external viewers
+ *
+ * With videoLiveRing set to a shared-memory name, the simulator writes the
+ * world state of every step (agent locations and colors, barrier mask and all
+ * signal layers) into a ring of videoLiveRingSlots fixed-size slots. A viewer
+ * process attaches with LiveRingReader and reads whichever frame it wants at
+ * its own pace, directly from the mapping. The writer never waits for readers;
+ * once the ring wraps, the oldest frame is overwritten.
+ *
+ * Each slot is guarded by a sequence lock. Frame n (counting from 1) lives in
+ * slot (n - 1) % slotCount, whose sequence is 2n - 1 while it is written and
+ * 2n once it is complete. A reader checks the sequence before and after
+ * reading; if it changed, the frame was overwritten in the meantime.
+ *
+ * Layout (host byte order): a LiveRingHeader, then slotCount slots of
+ * slotBytes each. A slot is a LiveSlotHeader followed, at the offsets given in
+ * the ring header, by maxAgents LiveAgent records, the barrier mask (one bit
+ * per cell, cell (x, y) is bit x * sizeY + y) and the signal layers in the
+ * [layer][x][y] order of ImageFrameData.
+ *
+ * @note On macOS, shared-memory names are limited to 31 characters.
+ */
+
+#include "../video/imageWriter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Live {
+
+constexpr char LIVE_RING_MAGIC[8] = {'B', '4', 'L', 'I', 'V', 'E', '0', '1'};
+constexpr uint32_t LIVE_RING_VERSION = 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring sequence numbers must be lock-free across processes");
+
+/**
+ * @struct LiveRingHeader
+ * @brief Start of the shared mapping; written once by LiveRingWriter::open()
+ */
+struct alignas(64) LiveRingHeader {
+  char magic[8];                      ///< LIVE_RING_MAGIC
+  uint32_t version;                   ///< LIVE_RING_VERSION
+  uint32_t slotCount;                 ///< Frames kept in the ring
+  uint64_t slotBytes;                 ///< Distance between consecutive slots
+  uint16_t sizeX;                     ///< Grid width
+  uint16_t sizeY;                     ///< Grid height
+  uint32_t signalLayers;              ///< Signal layers per frame
+  uint32_t maxAgents;                 ///< LiveAgent capacity of a slot
+  uint32_t agentsOffset;              ///< Offset of the LiveAgent array within a slot
+  uint32_t barrierMaskOffset;         ///< Offset of the barrier mask within a slot
+  uint32_t signalsOffset;             ///< Offset of the signal layers within a slot
+  std::atomic<uint32_t> writerAlive;  ///< 1 while the simulator publishes, 0 once it closed the ring
+  std::atomic<uint64_t> latestFrame;  ///< Newest complete frame (0 = none yet)
+};
+
+/**
+ * @struct LiveSlotHeader
+ * @brief Start of one slot
+ */
+struct alignas(64) LiveSlotHeader {
+  std::atomic<uint64_t> sequence;  ///< 2n while frame n is complete, odd while it is written
+  uint32_t generation;             ///< Generation number
+  uint32_t simStep;                ///< Step within the generation
+  uint32_t challenge;              ///< Active challenge
+  uint32_t barrierType;            ///< Barrier layout
+  uint32_t agentCount;             ///< LiveAgent records in use
+};
+
+/**
+ * @struct LiveAgent
+ * @brief One living individual
+ */
+struct LiveAgent {
+  int16_t x;        ///< Grid column
+  int16_t y;        ///< Grid row
+  uint8_t color;    ///< Individual::colorIndex (see agentColor())
+  uint8_t padding;  ///< Always 0
+};
+
+static_assert(sizeof(LiveAgent) == 6, "LiveAgent is part of the shared layout");
+
+/**
+ * @struct LiveFrame
+ * @brief Zero-copy view of one frame inside the mapping
+ *
+ * The pointers stay valid while the reader is attached, but the writer may
+ * overwrite the slot at any time. Check LiveRingReader::stillValid() after
+ * reading to know whether what was read belongs to this frame.
+ */
+struct LiveFrame {
+  uint64_t frame = 0;                    ///< Frame number (1-based)
+  uint32_t generation = 0;               ///< Generation number
+  uint32_t simStep = 0;                  ///< Step within the generation
+  uint32_t challenge = 0;                ///< Active challenge
+  uint32_t barrierType = 0;              ///< Barrier layout
+  uint32_t agentCount = 0;               ///< Entries in agents
+  const LiveAgent* agents = nullptr;     ///< Living individuals
+  const uint8_t* barrierMask = nullptr;  ///< One bit per cell
+  const uint8_t* signals = nullptr;      ///< All signal layers, [layer][x][y]
+  const LiveSlotHeader* slot = nullptr;  ///< Slot the frame was read from
+};
+
+/**
+ * @class LiveRingWriter
+ * @brief Creates the ring and publishes frames into it
+ *
+ * Only one thread may publish. open() replaces a ring left behind by an
+ * earlier run under the same name; close() unlinks the name, so viewers that
+ * are still attached keep their mapping but new viewers cannot attach.
+ */
+class LiveRingWriter {
+ public:
+  LiveRingWriter() = default;
+  ~LiveRingWriter();
+
+  LiveRingWriter(const LiveRingWriter&) = delete;
+  LiveRingWriter& operator=(const LiveRingWriter&) = delete;
+
+  /**
+   * @brief Create and map the ring
+   * @param name Shared-memory name; a leading '/' is added if missing
+   * @param slotCount Frames kept in the ring (>= 2)
+   * @param sizeX Grid width
+   * @param sizeY Grid height
+   * @param signalLayers Signal layers per frame
+   * @param maxAgents Largest number of agents in one frame
+   * @return false (after logging) if the ring could not be created
+   */
+  bool open(const std::string& name, unsigned slotCount, uint16_t sizeX, uint16_t sizeY, unsigned signalLayers,
+            unsigned maxAgents);
+
+  /** @brief Mark the ring closed, unmap it and unlink its name; safe to call repeatedly */
+  void close();
+
+  /** @brief The ring is mapped */
+  bool isOpen() const { return header_ != nullptr; }
+
+  /**
+   * @brief Publish the current simulation state (peeps, grid, pheromones)
+   *
+   * Called from endOfSimulationStep() while the world is quiescent. Colors
+   * are the individuals' colorIndex, fixed at birth.
+   */
+  void publishWorld(unsigned simStep, unsigned generation, unsigned challenge, unsigned barrierType);
+
+  /** @brief Frames published since open() */
+  uint64_t publishedFrames() const { return nextFrame_ - 1; }
+
+ private:
+  /** @brief Claim the next slot and mark it as being written */
+  LiveSlotHeader* beginFrame(unsigned simStep, unsigned generation, unsigned challenge, unsigned barrierType);
+
+  /** @brief Complete the slot claimed by beginFrame() and advance latestFrame */
+  void commitFrame(LiveSlotHeader* slot, uint32_t agentCount);
+
+  /** @brief Rebuild barrierMask_ from a list of barrier cells */
+  void buildBarrierMask(const std::vector<Coordinate>& barriers, unsigned barrierType);
+
+  uint8_t* slotData(LiveSlotHeader* slot, uint32_t offset) { return reinterpret_cast<uint8_t*>(slot) + offset; }
+
+  std::string name_;                  ///< Normalized shared-memory name
+  LiveRingHeader* header_ = nullptr;  ///< Start of the mapping
+  size_t mappedBytes_ = 0;            ///< Size of the mapping
+  uint64_t nextFrame_ = 1;            ///< Number of the next frame to publish
+  std::vector<uint8_t> barrierMask_;  ///< Mask copied into every slot; rebuilt at step 0 of each generation
+  unsigned barrierMaskType_ = 0;      ///< Barrier type barrierMask_ was built for
+};
+
+/**
+ * @class LiveRingReader
+ * @brief Attaches to a ring read-only, from any process
+ */
+class LiveRingReader {
+ public:
+  LiveRingReader() = default;
+  ~LiveRingReader();
+
+  LiveRingReader(const LiveRingReader&) = delete;
+  LiveRingReader& operator=(const LiveRingReader&) = delete;
+
+  /**
+   * @brief Map an existing ring
+   * @return false (after logging) if it does not exist or is not a live ring
+   */
+  bool attach(const std::string& name);
+
+  /** @brief Unmap the ring; safe to call repeatedly */
+  void detach();
+
+  /** @brief Ring geometry; only valid while attached */
+  const LiveRingHeader& header() const { return *header_; }
+
+  /** @brief Newest complete frame (0 = none yet) */
+  uint64_t latestFrame() const { return header_->latestFrame.load(std::memory_order_acquire); }
+
+  /** @brief The simulator still publishes into the ring */
+  bool writerAlive() const { return header_->writerAlive.load(std::memory_order_acquire) != 0; }
+
+  /**
+   * @brief Locate a frame without copying it
+   * @return false if the frame was not published yet or was already overwritten
+   */
+  bool view(uint64_t frame, LiveFrame& out) const;
+
+  /** @brief No newer frame has started to overwrite the viewed slot */
+  bool stillValid(const LiveFrame& frame) const;
+
+  /**
+   * @brief Copy a frame into a snapshot that renderFrame() can draw
+   * @return false if the frame is not in the ring or was overwritten while copying
+   */
+  bool readFrame(uint64_t frame, ImageFrameData& out) const;
+
+ private:
+  const LiveRingHeader* header_ = nullptr;  ///< Start of the mapping
+  size_t mappedBytes_ = 0;                  ///< Size of the mapping
+};
+
+/**
+ * @brief Normalize a shared-memory name to the "/name" form shm_open() expects
+ */
+std::string liveRingName(const std::string& name);
+
+/**
+ * @brief Global ring writer used by the simulator (defined in liveRing.cpp)
+ */
+extern LiveRingWriter liveRing;
+
+}  // namespace Live
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_LIVE_LIVERING_H_
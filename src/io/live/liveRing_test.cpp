@@ -0,0 +1,178 @@
+/**
+ * @file liveRing_test.cpp
+ * @brief Tests for the shared-memory live ring.
+ */
+
+#include "../../core/simulation/simulator.h"
+#include "liveRing.h"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+
+using IO::Live::LiveFrame;
+using IO::Live::LiveRingReader;
+using IO::Live::LiveRingWriter;
+
+namespace {
+
+constexpr uint16_t SIZE_X = 20;
+constexpr uint16_t SIZE_Y = 12;
+constexpr unsigned SLOTS = 4;
+
+/** @brief Grid with the fixed vertical bar (barrier type 1) and an empty signal layer */
+void initWorld() {
+  initParamsForTesting(SIZE_X, SIZE_Y);
+  grid.initialize(SIZE_X, SIZE_Y);
+  grid.createBarrier(1);
+  pheromones.initialize(parameterMngrSingleton.signalLayers, SIZE_X, SIZE_Y);
+  peeps.initialize(parameterMngrSingleton.population);
+}
+
+/** @brief Population and signals for one step: a third of the agents alive, moving right each step */
+void setWorldStep(unsigned step) {
+  for (unsigned index = 1; index <= parameterMngrSingleton.population; ++index) {
+    Individual& indiv = peeps[index];
+    indiv.index = index;
+    indiv.alive = (index + step) % 3 == 0;
+    indiv.loc = Coordinate(static_cast<int16_t>((index + step) % SIZE_X), static_cast<int16_t>(index % SIZE_Y));
+    indiv.colorIndex = static_cast<uint8_t>(index * 7 + step);
+  }
+  for (int16_t x = 0; x < SIZE_X; ++x) {
+    for (int16_t y = 0; y < SIZE_Y; ++y) {
+      pheromones[0][x][y] = static_cast<uint8_t>(x * 11 + y * 3 + step);
+    }
+  }
+}
+
+/** @brief The snapshot a reader should decode for the current world */
+ImageFrameData expectedFrame() {
+  ImageFrameData frame;
+  frame.allocate(parameterMngrSingleton.signalLayers, SIZE_X, SIZE_Y, parameterMngrSingleton.population);
+  for (unsigned index = 1; index <= parameterMngrSingleton.population; ++index) {
+    if (peeps[index].alive) {
+      frame.indivLocs.push_back(peeps[index].loc);
+      frame.indivColors.push_back(peeps[index].colorIndex);
+    }
+  }
+  frame.barrierLocs = grid.getBarrierLocations();
+  size_t cell = 0;
+  for (int16_t x = 0; x < SIZE_X; ++x) {
+    for (int16_t y = 0; y < SIZE_Y; ++y) {
+      frame.signalData[cell++] = pheromones[0][x][y];
+    }
+  }
+  return frame;
+}
+
+std::string ringName() {
+  return "biosim4-test-" + std::to_string(::getpid());
+}
+
+/** @brief Barrier cells in x-major order, whatever order the layout created them in */
+std::vector<Coordinate> sortedCells(std::vector<Coordinate> cells) {
+  std::sort(cells.begin(), cells.end(),
+            [](const Coordinate& a, const Coordinate& b) { return a.x != b.x ? a.x < b.x : a.y < b.y; });
+  return cells;
+}
+
+}  // namespace
+
+TEST(LiveRingTest, ReaderSeesPublishedWorldUntilItIsOverwritten) {
+  initWorld();
+  ASSERT_FALSE(grid.getBarrierLocations().empty());
+
+  LiveRingWriter writer;
+  ASSERT_TRUE(writer.open(ringName(), SLOTS, SIZE_X, SIZE_Y, parameterMngrSingleton.signalLayers,
+                          parameterMngrSingleton.population));
+
+  LiveRingReader reader;
+  ASSERT_TRUE(reader.attach(ringName()));
+  EXPECT_TRUE(reader.writerAlive());
+  EXPECT_EQ(reader.latestFrame(), 0u);
+  EXPECT_EQ(reader.header().sizeX, SIZE_X);
+
+  std::vector<ImageFrameData> published;
+  for (unsigned step = 0; step < 10; ++step) {
+    setWorldStep(step);
+    writer.publishWorld(step, 3, 6, 1);
+    published.push_back(expectedFrame());
+  }
+  ASSERT_EQ(reader.latestFrame(), 10u);
+
+  // Only the last SLOTS frames are still in the ring
+  ImageFrameData decoded;
+  EXPECT_FALSE(reader.readFrame(6, decoded));
+  for (uint64_t frame = 7; frame <= 10; ++frame) {
+    ASSERT_TRUE(reader.readFrame(frame, decoded)) << "frame " << frame;
+    const ImageFrameData& expected = published[frame - 1];
+    EXPECT_EQ(decoded.simStep, frame - 1);
+    EXPECT_EQ(decoded.generation, 3u);
+    EXPECT_EQ(decoded.challenge, 6u);
+    EXPECT_EQ(decoded.barrierType, 1u);
+    ASSERT_EQ(decoded.indivLocs.size(), expected.indivLocs.size());
+    for (size_t i = 0; i < expected.indivLocs.size(); ++i) {
+      EXPECT_EQ(decoded.indivLocs[i], expected.indivLocs[i]);
+      EXPECT_EQ(decoded.indivColors[i], expected.indivColors[i]);
+    }
+    EXPECT_EQ(decoded.barrierLocs, expected.barrierLocs);
+    EXPECT_EQ(decoded.signalData, expected.signalData);
+  }
+  EXPECT_FALSE(reader.readFrame(11, decoded));
+
+  // A zero-copy view goes stale once the writer wraps around to its slot
+  LiveFrame view;
+  ASSERT_TRUE(reader.view(10, view));
+  EXPECT_EQ(view.agentCount, published[9].indivLocs.size());
+  EXPECT_EQ(view.agents[0].x, published[9].indivLocs[0].x);
+  EXPECT_EQ(view.agents[0].color, published[9].indivColors[0]);
+  for (unsigned step = 10; step < 10 + SLOTS; ++step) {
+    setWorldStep(step);
+    writer.publishWorld(step, 3, 6, 1);
+  }
+  EXPECT_FALSE(reader.stillValid(view));
+
+  writer.close();
+  EXPECT_FALSE(reader.writerAlive());
+  LiveRingReader late;
+  EXPECT_FALSE(late.attach(ringName()));
+}
+
+TEST(LiveRingTest, BarrierMaskFollowsTheBarriersOfEachGeneration) {
+  initWorld();
+  LiveRingWriter writer;
+  ASSERT_TRUE(writer.open(ringName(), SLOTS, SIZE_X, SIZE_Y, parameterMngrSingleton.signalLayers,
+                          parameterMngrSingleton.population));
+  LiveRingReader reader;
+  ASSERT_TRUE(reader.attach(ringName()));
+
+  ImageFrameData decoded;
+  const std::vector<Coordinate> bar = sortedCells(grid.getBarrierLocations());
+  for (unsigned step = 0; step < 3; ++step) {
+    setWorldStep(step);
+    writer.publishWorld(step, 3, 6, 1);
+    ASSERT_TRUE(reader.readFrame(writer.publishedFrames(), decoded));
+    EXPECT_EQ(sortedCells(decoded.barrierLocs), bar) << "step " << step;
+  }
+
+  // The next generation is spawned with another layout
+  grid.zeroFill();
+  grid.createBarrier(6);
+  const std::vector<Coordinate> bars = sortedCells(grid.getBarrierLocations());
+  ASSERT_NE(bars, bar);
+  for (unsigned step = 0; step < 3; ++step) {
+    setWorldStep(step);
+    writer.publishWorld(step, 4, 6, 6);
+    ASSERT_TRUE(reader.readFrame(writer.publishedFrames(), decoded));
+    EXPECT_EQ(sortedCells(decoded.barrierLocs), bars) << "step " << step;
+  }
+  writer.close();
+}
+
+}  // namespace BioSim
@@ -0,0 +1,307 @@
+/**
+ * @file metricsEndpoint.cpp
+ * @brief Implementation of the live Prometheus metrics endpoint
+ */
+
+#include "metricsEndpoint.h"
+
+#include "../../utils/logger.h"
+#include "../../utils/resourceUsage.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Metrics {
+
+using Core::Simulation::NUM_PHASES;
+using Core::Simulation::Phase;
+using Core::Simulation::phaseName;
+using Utils::Logger;
+
+LiveMetrics liveMetrics;
+MetricsEndpoint metricsEndpoint;
+
+namespace {
+
+constexpr int POLL_INTERVAL_MS = 200;  ///< How often the server thread checks for stop()
+constexpr int CLIENT_TIMEOUT_MS = 1000;
+
+/// Append one metric with HELP and TYPE lines
+template <typename T>
+void appendMetric(std::string& out, const char* name, const char* type, const char* help, T value) {
+  out += fmt::format("# HELP {} {}\n# TYPE {} {}\n{} {}\n", name, help, name, type, name, value);
+}
+
+/// Send all of @p data, giving up on error (the scraper will retry)
+void sendAll(int fd, const std::string& data) {
+#ifdef MSG_NOSIGNAL
+  constexpr int flags = MSG_NOSIGNAL;
+#else
+  constexpr int flags = 0;
+#endif
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, flags);
+    if (n <= 0) {
+      return;
+    }
+    sent += static_cast<size_t>(n);
+  }
+}
+
+}  // namespace
+
+void LiveMetrics::reset(uint32_t configuredPopulation) {
+  running.store(true, std::memory_order_relaxed);
+  population.store(configuredPopulation, std::memory_order_relaxed);
+  generation.store(0, std::memory_order_relaxed);
+  simStep.store(0, std::memory_order_relaxed);
+  generationsTotal.store(0, std::memory_order_relaxed);
+  agentStepsTotal.store(0, std::memory_order_relaxed);
+  agentStepsPerSecond.store(0.0, std::memory_order_relaxed);
+  survivors.store(0, std::memory_order_relaxed);
+  murders.store(0, std::memory_order_relaxed);
+  averageGenomeLength.store(0.0, std::memory_order_relaxed);
+  geneticDiversity.store(0.0, std::memory_order_relaxed);
+  for (auto& seconds : phaseSeconds) {
+    seconds.store(0.0, std::memory_order_relaxed);
+  }
+  touch();
+}
+
+void LiveMetrics::touch() {
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+  lastProgressUnixTime.store(std::chrono::duration<double>(now).count(), std::memory_order_relaxed);
+}
+
+std::string renderPrometheus(const LiveMetrics& metrics) {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  std::string out;
+  out.reserve(4096);
+
+  appendMetric(out, "biosim4_running", "gauge", "1 while a simulation run is in progress",
+               metrics.running.load(relaxed) ? 1 : 0);
+  appendMetric(out, "biosim4_population", "gauge", "Configured population size", metrics.population.load(relaxed));
+  appendMetric(out, "biosim4_generation", "gauge", "Current generation number", metrics.generation.load(relaxed));
+  appendMetric(out, "biosim4_sim_step", "gauge", "Last completed simulation step within the current generation",
+               metrics.simStep.load(relaxed));
+  appendMetric(out, "biosim4_generations_total", "counter", "Generations completed in this run",
+               metrics.generationsTotal.load(relaxed));
+  appendMetric(out, "biosim4_agent_steps_total", "counter", "Living-agent steps executed in this run",
+               metrics.agentStepsTotal.load(relaxed));
+  appendMetric(out, "biosim4_agent_steps_per_second", "gauge", "Agent-step throughput of the last generation",
+               metrics.agentStepsPerSecond.load(relaxed));
+  appendMetric(out, "biosim4_survivors", "gauge", "Survivors of the last completed generation",
+               metrics.survivors.load(relaxed));
+  appendMetric(out, "biosim4_murders", "gauge", "Individuals killed by others in the last completed generation",
+               metrics.murders.load(relaxed));
+  appendMetric(out, "biosim4_genetic_diversity", "gauge",
+               "Sampled genetic diversity (0..1) of the last generation written to the metrics log",
+               metrics.geneticDiversity.load(relaxed));
+  appendMetric(out, "biosim4_average_genome_length", "gauge", "Sampled mean genome length of the last generation",
+               metrics.averageGenomeLength.load(relaxed));
+  appendMetric(out, "biosim4_last_progress_timestamp_seconds", "gauge",
+               "Unix time of the last completed simulation step (stall detection)",
+               fmt::format("{:.3f}", metrics.lastProgressUnixTime.load(relaxed)));
+
+  out += "# HELP biosim4_phase_seconds_total Wall time spent in each phase of the main loop\n";
+  out += "# TYPE biosim4_phase_seconds_total counter\n";
+  for (unsigned phase = 0; phase < NUM_PHASES; ++phase) {
+    out += fmt::format("biosim4_phase_seconds_total{{phase=\"{}\"}} {:.6f}\n", phaseName(static_cast<Phase>(phase)),
+                       metrics.phaseSeconds[phase].load(relaxed));
+  }
+
+  appendMetric(out, "biosim4_resident_memory_bytes", "gauge", "Current resident set size",
+               Utils::currentResidentSetBytes());
+  appendMetric(out, "biosim4_peak_resident_memory_bytes", "gauge", "Peak resident set size",
+               Utils::peakResidentSetBytes());
+  return out;
+}
+
+MetricsEndpoint::~MetricsEndpoint() {
+  stop();
+}
+
+bool MetricsEndpoint::start(const std::string& address) {
+  stop();
+  if (address.empty()) {
+    return false;
+  }
+
+  int fd = -1;
+  std::string boundTo;
+  if (address.rfind("unix:", 0) == 0) {
+    const std::string path = address.substr(5);
+    sockaddr_un addr{};
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+      Logger::warning("Metrics endpoint: invalid UNIX socket path '{}'", path);
+      return false;
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    // Only a stale socket from an earlier run is removed; anything else at the
+    // path is left alone so a mistyped path cannot delete a regular file
+    struct stat existing {};
+    if (::lstat(path.c_str(), &existing) == 0) {
+      if (!S_ISSOCK(existing.st_mode)) {
+        Logger::warning("Metrics endpoint: {} exists and is not a socket; not starting", path);
+        return false;
+      }
+      ::unlink(path.c_str());
+    }
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      Logger::warning("Metrics endpoint: cannot bind {}: {}", path, std::strerror(errno));
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      return false;
+    }
+    unixPath_ = path;
+    boundTo = "unix:" + path;
+  } else {
+    // "port" or "host:port"; the host part is accepted for readability but the
+    // socket is always bound to loopback so the endpoint is never exposed remotely
+    const size_t colon = address.rfind(':');
+    const std::string portText = colon == std::string::npos ? address : address.substr(colon + 1);
+    int port = 0;
+    try {
+      port = std::stoi(portText);
+    } catch (const std::exception&) {
+      port = 0;
+    }
+    if (port <= 0 || port > 65535) {
+      Logger::warning("Metrics endpoint: invalid address '{}' (expected PORT, HOST:PORT or unix:PATH)", address);
+      return false;
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    const int reuse = 1;
+    if (fd >= 0) {
+      ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+      Logger::warning("Metrics endpoint: cannot bind 127.0.0.1:{}: {}", port, std::strerror(errno));
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      return false;
+    }
+    boundTo = fmt::format("127.0.0.1:{}", port);
+  }
+
+  if (::listen(fd, 8) != 0) {
+    Logger::warning("Metrics endpoint: listen failed: {}", std::strerror(errno));
+    ::close(fd);
+    if (!unixPath_.empty()) {
+      ::unlink(unixPath_.c_str());
+      unixPath_.clear();
+    }
+    return false;
+  }
+
+  listenFd_ = fd;
+  stopRequested_ = false;
+  thread_ = std::thread(&MetricsEndpoint::serveLoop, this);
+  Logger::print("📈 Metrics endpoint listening on {} (GET /metrics)", boundTo);
+  Logger::info("Metrics endpoint listening on {}", boundTo);
+  return true;
+}
+
+void MetricsEndpoint::stop() {
+  if (listenFd_ < 0) {
+    return;
+  }
+  stopRequested_ = true;
+  thread_.join();
+  ::close(listenFd_);
+  listenFd_ = -1;
+  if (!unixPath_.empty()) {
+    ::unlink(unixPath_.c_str());
+    unixPath_.clear();
+  }
+  Logger::info("Metrics endpoint stopped");
+}
+
+void MetricsEndpoint::serveLoop() {
+  while (!stopRequested_) {
+    pollfd listener{listenFd_, POLLIN, 0};
+    if (::poll(&listener, 1, POLL_INTERVAL_MS) <= 0 || !(listener.revents & POLLIN)) {
+      continue;
+    }
+    const int clientFd = ::accept(listenFd_, nullptr, nullptr);
+    if (clientFd < 0) {
+      continue;
+    }
+#ifdef SO_NOSIGPIPE
+    const int noSigPipe = 1;
+    ::setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+    serveClient(clientFd);
+    ::close(clientFd);
+  }
+}
+
+void MetricsEndpoint::serveClient(int clientFd) {
+  // Read until the end of the request headers; the body (if any) is ignored
+  std::string request;
+  char buffer[1024];
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+    pollfd client{clientFd, POLLIN, 0};
+    if (::poll(&client, 1, CLIENT_TIMEOUT_MS) <= 0) {
+      return;
+    }
+    const ssize_t n = ::recv(clientFd, buffer, sizeof(buffer), 0);
+    if (n <= 0) {
+      break;
+    }
+    request.append(buffer, static_cast<size_t>(n));
+  }
+
+  const bool isGet = request.rfind("GET ", 0) == 0;
+  const size_t pathEnd = request.find(' ', 4);
+  const std::string path = isGet && pathEnd != std::string::npos ? request.substr(4, pathEnd - 4) : "";
+
+  std::string status = "200 OK";
+  std::string body;
+  if (!isGet) {
+    status = "405 Method Not Allowed";
+    body = "only GET is supported\n";
+  } else if (path == "/metrics" || path == "/") {
+    body = renderPrometheus(liveMetrics);
+  } else {
+    status = "404 Not Found";
+    body = "try /metrics\n";
+  }
+
+  sendAll(clientFd, fmt::format("HTTP/1.0 {}\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                "Content-Length: {}\r\nConnection: close\r\n\r\n{}",
+                                status, body.size(), body));
+}
+
+}  // namespace Metrics
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
@@ -0,0 +1,133 @@
+#ifndef BIOSIM4_SRC_IO_METRICS_METRICSENDPOINT_H_
+#define BIOSIM4_SRC_IO_METRICS_METRICSENDPOINT_H_
+
+/**
+ * @file metricsEndpoint.h
+ * @brief Live run metrics served in Prometheus text format
+ *
+ * The simulation publishes its progress into LiveMetrics, a set of relaxed
+ * atomics written at the existing serial points of the main loop. Writers
+ * never take a lock. MetricsEndpoint is an optional, minimal HTTP/1.0 server.
+ * It listens on a loopback TCP port or on a UNIX socket, and answers
+ * `GET /metrics` with a snapshot of those atomics:
+ *
+ * @code
+ * curl http://127.0.0.1:9464/metrics
+ * curl --unix-socket /tmp/biosim4.sock http://localhost/metrics
+ * @endcode
+ */
+
+#include "../../core/simulation/simulationStats.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Metrics {
+
+/**
+ * @struct LiveMetrics
+ * @brief Lock-free progress counters of the running simulation
+ *
+ * All members are written with relaxed stores from the simulation thread
+ * (or, for diversity, the metrics writer thread) and read by the endpoint.
+ * A scrape may therefore mix values from adjacent steps, which is fine for
+ * monitoring.
+ */
+struct LiveMetrics {
+  std::atomic<bool> running{false};                                              ///< simulator() is executing
+  std::atomic<uint32_t> population{0};                                           ///< Configured population size
+  std::atomic<uint32_t> generation{0};                                           ///< Current generation number
+  std::atomic<uint32_t> simStep{0};                                              ///< Last completed step within the generation
+  std::atomic<uint64_t> generationsTotal{0};                                     ///< Generations completed in this run
+  std::atomic<uint64_t> agentStepsTotal{0};                                      ///< Living-agent steps executed in this run
+  std::atomic<double> agentStepsPerSecond{0.0};                                  ///< Throughput of the last completed generation
+  std::atomic<uint32_t> survivors{0};                                            ///< Survivors of the last completed generation
+  std::atomic<uint32_t> murders{0};                                              ///< Murders in the last completed generation
+  std::atomic<double> averageGenomeLength{0.0};                                  ///< Sampled genome length, last completed generation
+  std::atomic<double> geneticDiversity{0.0};                                     ///< Set by the metrics writer once computed
+  std::atomic<double> lastProgressUnixTime{0.0};                                 ///< Wall-clock time of the last completed step
+  std::array<std::atomic<double>, Core::Simulation::NUM_PHASES> phaseSeconds{};  ///< Cumulative time per Phase
+
+  /** @brief Reset all counters at the start of a run */
+  void reset(uint32_t configuredPopulation);
+
+  /** @brief Record wall-clock "now" as the time of the last progress */
+  void touch();
+};
+
+/**
+ * @brief Global live counters, published by simulator() and the metrics writer
+ */
+extern LiveMetrics liveMetrics;
+
+/**
+ * @brief Render @p metrics in Prometheus text exposition format (version 0.0.4)
+ */
+std::string renderPrometheus(const LiveMetrics& metrics);
+
+/**
+ * @class MetricsEndpoint
+ * @brief Background HTTP server exposing liveMetrics at /metrics
+ *
+ * Address forms:
+ * - `"9464"` or `"127.0.0.1:9464"`: TCP, always bound to the loopback interface
+ * - `"unix:/path/to.sock"`: UNIX domain socket (an existing socket file is replaced;
+ *   any other file at the path makes start() fail)
+ *
+ * One connection is served at a time; a scrape only formats a few hundred
+ * bytes, so that is enough for monitoring agents.
+ */
+class MetricsEndpoint {
+ public:
+  MetricsEndpoint() = default;
+  ~MetricsEndpoint();
+
+  MetricsEndpoint(const MetricsEndpoint&) = delete;
+  MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+  /**
+   * @brief Bind, listen and start the server thread
+   * @param address See class description
+   * @return false (after logging a warning) if the address is invalid or cannot be bound
+   */
+  bool start(const std::string& address);
+
+  /** @brief Stop the server thread and close (and for UNIX sockets, unlink) the socket */
+  void stop();
+
+  /** @brief True while the server thread is running */
+  bool running() const { return listenFd_ >= 0; }
+
+ private:
+  void serveLoop();
+  void serveClient(int clientFd);
+
+  int listenFd_ = -1;
+  std::string unixPath_;
+  std::atomic<bool> stopRequested_{false};
+  std::thread thread_;
+};
+
+/**
+ * @brief Global endpoint, started and stopped by simulator() when configured
+ */
+extern MetricsEndpoint metricsEndpoint;
+
+}  // namespace Metrics
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+// Backward compatibility aliases
+namespace BioSim {
+using IO::Metrics::liveMetrics;
+using IO::Metrics::metricsEndpoint;
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_METRICS_METRICSENDPOINT_H_
@@ -0,0 +1,125 @@
+/**
+ * @file metricsEndpoint_test.cpp
+ * @brief Tests for the Prometheus text rendering of the live counters.
+ */
+
+#include "metricsEndpoint.h"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace BioSim {
+
+using Core::Simulation::NUM_PHASES;
+using IO::Metrics::LiveMetrics;
+using IO::Metrics::renderPrometheus;
+
+namespace {
+
+/** @brief The parts of an exposition that belong to one metric family */
+struct Family {
+  std::string help;
+  std::string type;
+  std::map<std::string, std::string> samples;  ///< Sample name (with labels) to value
+};
+
+/** @brief Split an exposition into families; a sample must follow its family's TYPE line */
+std::map<std::string, Family> parse(const std::string& text) {
+  std::map<std::string, Family> families;
+  std::string current;
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    if (line.rfind("# HELP ", 0) == 0) {
+      const size_t nameEnd = line.find(' ', 7);
+      families[line.substr(7, nameEnd - 7)].help = line.substr(nameEnd + 1);
+    } else if (line.rfind("# TYPE ", 0) == 0) {
+      const size_t nameEnd = line.find(' ', 7);
+      current = line.substr(7, nameEnd - 7);
+      families[current].type = line.substr(nameEnd + 1);
+    } else {
+      const size_t valueStart = line.rfind(' ');
+      const std::string sample = line.substr(0, valueStart);
+      EXPECT_EQ(sample.substr(0, sample.find('{')), current) << "sample without TYPE: " << line;
+      families[current].samples[sample] = line.substr(valueStart + 1);
+    }
+  }
+  return families;
+}
+
+}  // namespace
+
+TEST(MetricsEndpointTest, RendersEveryCounterWithHelpTypeAndValue) {
+  LiveMetrics metrics;
+  metrics.running = true;
+  metrics.population = 3000;
+  metrics.generation = 42;
+  metrics.simStep = 299;
+  metrics.generationsTotal = 43;
+  metrics.agentStepsTotal = 38700000;
+  metrics.agentStepsPerSecond = 1234.5;
+  metrics.survivors = 2750;
+  metrics.murders = 12;
+  metrics.geneticDiversity = 0.25;
+  metrics.averageGenomeLength = 24.5;
+  metrics.lastProgressUnixTime = 1700000000.125;
+  for (unsigned phase = 0; phase < NUM_PHASES; ++phase) {
+    metrics.phaseSeconds[phase] = 1.5 * (phase + 1);
+  }
+
+  const std::string text = renderPrometheus(metrics);
+  ASSERT_FALSE(text.empty());
+  EXPECT_EQ(text.back(), '\n');
+  const std::map<std::string, Family> families = parse(text);
+
+  const struct {
+    const char* name;
+    const char* type;
+    const char* value;
+  } expected[] = {
+      {"biosim4_running", "gauge", "1"},
+      {"biosim4_population", "gauge", "3000"},
+      {"biosim4_generation", "gauge", "42"},
+      {"biosim4_sim_step", "gauge", "299"},
+      {"biosim4_generations_total", "counter", "43"},
+      {"biosim4_agent_steps_total", "counter", "38700000"},
+      {"biosim4_agent_steps_per_second", "gauge", "1234.5"},
+      {"biosim4_survivors", "gauge", "2750"},
+      {"biosim4_murders", "gauge", "12"},
+      {"biosim4_genetic_diversity", "gauge", "0.25"},
+      {"biosim4_average_genome_length", "gauge", "24.5"},
+      {"biosim4_last_progress_timestamp_seconds", "gauge", "1700000000.125"},
+  };
+  for (const auto& metric : expected) {
+    ASSERT_EQ(families.count(metric.name), 1u) << metric.name;
+    const Family& family = families.at(metric.name);
+    EXPECT_FALSE(family.help.empty()) << metric.name;
+    EXPECT_EQ(family.type, metric.type) << metric.name;
+    ASSERT_EQ(family.samples.size(), 1u) << metric.name;
+    EXPECT_EQ(family.samples.begin()->first, metric.name);
+    EXPECT_EQ(family.samples.begin()->second, metric.value) << metric.name;
+  }
+
+  // One labelled sample per phase
+  ASSERT_EQ(families.count("biosim4_phase_seconds_total"), 1u);
+  const Family& phases = families.at("biosim4_phase_seconds_total");
+  EXPECT_EQ(phases.type, "counter");
+  EXPECT_FALSE(phases.help.empty());
+  EXPECT_EQ(phases.samples.size(), NUM_PHASES);
+  EXPECT_EQ(phases.samples.at("biosim4_phase_seconds_total{phase=\"agent-step\"}"), "1.500000");
+  EXPECT_EQ(phases.samples.at("biosim4_phase_seconds_total{phase=\"spawn-generation\"}"), "6.000000");
+
+  // Memory gauges are read from the running process
+  for (const char* name : {"biosim4_resident_memory_bytes", "biosim4_peak_resident_memory_bytes"}) {
+    ASSERT_EQ(families.count(name), 1u) << name;
+    EXPECT_EQ(families.at(name).type, "gauge");
+    EXPECT_GT(std::stoull(families.at(name).samples.at(name)), 0u) << name;
+  }
+  EXPECT_EQ(families.size(), std::size(expected) + 3);
+}
+
+}  // namespace BioSim
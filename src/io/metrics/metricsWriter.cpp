@@ -0,0 +1,340 @@
+/**
+ * @file metricsWriter.cpp
+ * @brief Implementation of the background per-generation metrics writer
+ */
+
+#include "metricsWriter.h"
+
+#include "../../utils/logger.h"
+#include "metricsEndpoint.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Metrics {
+
+using Utils::Logger;
+
+MetricsWriter metricsWriter;
+
+namespace {
+
+constexpr const char* CSV_FILENAME = "epoch-log.csv";
+constexpr const char* BINARY_FILENAME = "epoch-log.bin";
+constexpr char BINARY_MAGIC[4] = {'B', 'S', 'M', '1'};
+
+/// Memory a queued row holds, counted against MetricsConfig::queueMemoryBytes
+size_t rowBytes(const GenerationMetrics& row) {
+  return sizeof(GenerationMetrics) + row.diversitySample.bytes();
+}
+
+const char* typeName(ColumnType type) {
+  switch (type) {
+    case ColumnType::U32:
+      return "u32";
+    case ColumnType::U64:
+      return "u64";
+    case ColumnType::F32:
+      return "f32";
+    case ColumnType::F64:
+      return "f64";
+  }
+  return "?";
+}
+
+/// Append @p bytes bytes of @p bits to @p out, least significant byte first
+void appendLittleEndian(std::string& out, uint64_t bits, unsigned bytes) {
+  for (unsigned n = 0; n < bytes; ++n) {
+    out.push_back(static_cast<char>((bits >> (8 * n)) & 0xff));
+  }
+}
+
+void appendU32(std::string& out, uint32_t value) {
+  appendLittleEndian(out, value, 4);
+}
+
+void appendU64(std::string& out, uint64_t value) {
+  appendLittleEndian(out, value, 8);
+}
+
+void appendF32(std::string& out, float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  appendLittleEndian(out, bits, 4);
+}
+
+void appendF64(std::string& out, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  appendLittleEndian(out, bits, 8);
+}
+
+}  // namespace
+
+MetricsFormat parseMetricsFormat(const std::string& name) {
+  if (name == "none") {
+    return MetricsFormat::NONE;
+  }
+  if (name == "csv") {
+    return MetricsFormat::CSV;
+  }
+  if (name == "binary") {
+    return MetricsFormat::BINARY;
+  }
+  throw std::invalid_argument("metrics format must be none, csv or binary, got '" + name + "'");
+}
+
+const std::vector<MetricsColumn>& MetricsWriter::schema() {
+  // The first five columns keep the layout of the old epoch-log.txt (tools/graphlog.gp)
+  static const std::vector<MetricsColumn> columns = {
+      {"generation", ColumnType::U32},
+      {"survivors", ColumnType::U32},
+      {"diversity", ColumnType::F32},
+      {"genome_length", ColumnType::F32},
+      {"murders", ColumnType::U32},
+      {"alive", ColumnType::U32},
+      {"agent_steps", ColumnType::U64},
+      {"agent_step_s", ColumnType::F64},
+      {"end_of_step_s", ColumnType::F64},
+      {"end_of_generation_s", ColumnType::F64},
+      {"spawn_s", ColumnType::F64},
+      {"rss_bytes", ColumnType::U64},
+  };
+  return columns;
+}
+
+MetricsWriter::~MetricsWriter() {
+  stop();
+}
+
+bool MetricsWriter::start(const MetricsConfig& config) {
+  stop();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  path_.clear();
+  queue_.clear();
+  pendingBytes_ = 0;
+  stopRequested_ = false;
+  flushRequests_ = 0;
+  flushesServed_ = 0;
+  writtenRows_ = 0;
+  droppedRows_ = 0;
+
+  if (config_.format == MetricsFormat::NONE) {
+    return true;
+  }
+
+  std::string path = config_.logDir;
+  if (!path.empty() && path.back() != '/') {
+    path += '/';
+  }
+  path += config_.format == MetricsFormat::CSV ? CSV_FILENAME : BINARY_FILENAME;
+
+  const auto mode = config_.format == MetricsFormat::BINARY ? std::ios::out | std::ios::trunc | std::ios::binary
+                                                            : std::ios::out | std::ios::trunc;
+  file_.open(path, mode);
+  if (!file_.is_open()) {
+    Logger::warning("Cannot open metrics log {}; metrics disabled", path);
+    return false;
+  }
+
+  path_ = path;
+  writeHeader();
+  file_.flush();
+
+  running_ = true;
+  thread_ = std::thread(&MetricsWriter::writerLoop, this);
+  return true;
+}
+
+bool MetricsWriter::submit(GenerationMetrics&& row) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return false;
+    }
+    const size_t bytes = rowBytes(row);
+    if (queue_.size() >= config_.queueCapacity ||
+        (config_.queueMemoryBytes > 0 && pendingBytes_ + bytes > config_.queueMemoryBytes)) {
+      ++droppedRows_;
+      return false;
+    }
+    pendingBytes_ += bytes;
+    queue_.push_back(std::move(row));
+  }
+  wakeWriter_.notify_one();
+  return true;
+}
+
+void MetricsWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!running_) {
+    return;
+  }
+  const uint64_t request = ++flushRequests_;
+  wakeWriter_.notify_one();
+  flushed_.wait(lock, [&] { return flushesServed_ >= request || !running_; });
+}
+
+void MetricsWriter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    stopRequested_ = true;
+  }
+  wakeWriter_.notify_one();
+  thread_.join();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  file_.close();
+  running_ = false;
+  flushed_.notify_all();
+
+  if (droppedRows_ > 0) {
+    Logger::warning("Metrics log {}: {} rows dropped (queue or memory budget full)", path_, droppedRows_);
+  }
+  Logger::info("Metrics log {}: {} rows written", path_, writtenRows_);
+}
+
+bool MetricsWriter::enabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return running_;
+}
+
+uint64_t MetricsWriter::writtenRows() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return writtenRows_;
+}
+
+uint64_t MetricsWriter::droppedRows() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return droppedRows_;
+}
+
+void MetricsWriter::writerLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto flushInterval = std::chrono::milliseconds(config_.flushIntervalMs);
+
+  Clock::time_point lastFlush = Clock::now();
+  unsigned rowsSinceFlush = 0;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    const auto hasWork = [&] { return stopRequested_ || !queue_.empty() || flushRequests_ != flushesServed_; };
+    if (config_.flushIntervalMs > 0 && rowsSinceFlush > 0) {
+      wakeWriter_.wait_until(lock, lastFlush + flushInterval, hasWork);
+    } else {
+      wakeWriter_.wait(lock, hasWork);
+    }
+
+    std::deque<GenerationMetrics> batch;
+    batch.swap(queue_);
+    const uint64_t flushTarget = flushRequests_;
+    const bool stopping = stopRequested_;
+    lock.unlock();
+
+    size_t batchBytes = 0;
+    for (const auto& row : batch) {
+      writeRow(row);
+      batchBytes += rowBytes(row);
+    }
+    rowsSinceFlush += batch.size();
+    const size_t batchRows = batch.size();
+    batch.clear();
+
+    const Clock::time_point now = Clock::now();
+    const bool flushDue = stopping || flushTarget != flushesServed_ ||
+                          (config_.flushEveryRows > 0 && rowsSinceFlush >= config_.flushEveryRows) ||
+                          (config_.flushIntervalMs > 0 && rowsSinceFlush > 0 && now - lastFlush >= flushInterval);
+    if (flushDue) {
+      file_.flush();
+      rowsSinceFlush = 0;
+      lastFlush = now;
+    }
+
+    lock.lock();
+    writtenRows_ += batchRows;
+    pendingBytes_ -= batchBytes;
+    if (flushDue) {
+      flushesServed_ = flushTarget;
+      flushed_.notify_all();
+    }
+    if (stopping && queue_.empty()) {
+      break;
+    }
+  }
+}
+
+void MetricsWriter::writeHeader() {
+  const auto& columns = schema();
+
+  if (config_.format == MetricsFormat::CSV) {
+    std::string types;
+    std::string names;
+    for (size_t n = 0; n < columns.size(); ++n) {
+      const char* separator = n + 1 < columns.size() ? "," : "";
+      types += fmt::format("{}{}", typeName(columns[n].type), separator);
+      names += fmt::format("{}{}", columns[n].name, separator);
+    }
+    file_ << "# biosim4-metrics v1\n";
+    file_ << "# types: " << types << "\n";
+    file_ << names << "\n";
+    return;
+  }
+
+  std::string header(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  appendU32(header, static_cast<uint32_t>(columns.size()));
+  for (const auto& column : columns) {
+    const size_t nameLength = std::strlen(column.name);
+    header.push_back(static_cast<char>(column.type));
+    header.push_back(static_cast<char>(nameLength));
+    header.append(column.name, nameLength);
+  }
+  file_.write(header.data(), header.size());
+}
+
+void MetricsWriter::writeRow(const GenerationMetrics& row) {
+  // Computed here rather than on the simulation thread; same pairs as geneticDiversity()
+  const float diversity = Core::Genetics::geneticDiversity(row.diversitySample);
+  liveMetrics.geneticDiversity.store(diversity, std::memory_order_relaxed);
+
+  // Field order must match schema()
+  if (config_.format == MetricsFormat::CSV) {
+    const std::string line =
+        fmt::format("{},{},{},{},{},{},{},{:.6f},{:.6f},{:.6f},{:.6f},{}\n", row.generation, row.survivors, diversity,
+                    row.averageGenomeLength, row.murders, row.alive, row.agentSteps, row.agentStepSeconds,
+                    row.endOfStepSeconds, row.endOfGenerationSeconds, row.spawnSeconds, row.residentSetBytes);
+    file_.write(line.data(), line.size());
+    return;
+  }
+
+  std::string record;
+  record.reserve(64);
+  appendU32(record, row.generation);
+  appendU32(record, row.survivors);
+  appendF32(record, diversity);
+  appendF32(record, row.averageGenomeLength);
+  appendU32(record, row.murders);
+  appendU32(record, row.alive);
+  appendU64(record, row.agentSteps);
+  appendF64(record, row.agentStepSeconds);
+  appendF64(record, row.endOfStepSeconds);
+  appendF64(record, row.endOfGenerationSeconds);
+  appendF64(record, row.spawnSeconds);
+  appendU64(record, row.residentSetBytes);
+  file_.write(record.data(), record.size());
+}
+
+}  // namespace Metrics
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
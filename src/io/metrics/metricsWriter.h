@@ -0,0 +1,211 @@
+#ifndef BIOSIM4_SRC_IO_METRICS_METRICSWRITER_H_
+#define BIOSIM4_SRC_IO_METRICS_METRICSWRITER_H_
+
+/**
+ * @file metricsWriter.h
+ * @brief Per-generation metrics log written by a background thread
+ *
+ * Replaces the old appendEpochLog(), which reopened `epoch-log.txt` every
+ * generation and computed genetic diversity on the simulation thread. The
+ * simulation thread now only fills a GenerationMetrics row and submits it to a
+ * bounded queue. A writer thread computes the expensive columns, formats the
+ * row and writes it under a configurable flush policy.
+ *
+ * Two formats share one column schema (see MetricsWriter::schema()):
+ * - CSV (`<logDir>/epoch-log.csv`): `#` comment lines with the format version
+ *   and column types, then one header row of column names, then data. The
+ *   first five columns match the old epoch log, so tools/graphlog.gp keeps working.
+ * - Binary (`<logDir>/epoch-log.bin`): the magic `BSM1`, a uint32 column count,
+ *   then for each column a uint8 type code, a uint8 name length and the name.
+ *   After that come fixed-width little-endian rows.
+ */
+
+#include "../../core/genetics/genome-neurons.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Metrics {
+
+/**
+ * @enum MetricsFormat
+ * @brief On-disk representation of the metrics log
+ */
+enum class MetricsFormat { NONE, CSV, BINARY };
+
+/**
+ * @brief Parse a format name ("none", "csv", "binary")
+ * @throws std::invalid_argument for unknown names
+ */
+MetricsFormat parseMetricsFormat(const std::string& name);
+
+/**
+ * @enum ColumnType
+ * @brief Storage type of one column (also the binary type code)
+ */
+enum class ColumnType : uint8_t { U32 = 1, U64 = 2, F32 = 3, F64 = 4 };
+
+/**
+ * @struct MetricsColumn
+ * @brief Name and storage type of one column
+ */
+struct MetricsColumn {
+  const char* name;  ///< Column name, snake_case
+  ColumnType type;   ///< Storage type
+};
+
+/**
+ * @struct GenerationMetrics
+ * @brief One row of the metrics log, filled on the simulation thread
+ *
+ * Genetic diversity is not computed on the simulation thread. Instead,
+ * diversitySample holds the genome pairs that geneticDiversity() would have
+ * compared, and the writer thread computes the value from them. The sample is
+ * only taken while the writer is enabled.
+ */
+struct GenerationMetrics {
+  uint32_t generation = 0;                              ///< Generation number
+  uint32_t survivors = 0;                               ///< Parents selected for the next generation
+  uint32_t murders = 0;                                 ///< Individuals killed by KILL_FORWARD
+  uint32_t alive = 0;                                   ///< Individuals alive at the end of the generation
+  float averageGenomeLength = 0.0f;                     ///< Sampled mean genome length
+  Core::Genetics::DiversitySample diversitySample;      ///< Genome pairs (a0, b0, a1, b1, ...) for geneticDiversity()
+  uint64_t agentSteps = 0;                              ///< Living-agent steps executed in this generation
+  double agentStepSeconds = 0.0;                        ///< Parallel agent-step time
+  double endOfStepSeconds = 0.0;                        ///< Serial end-of-step time
+  double endOfGenerationSeconds = 0.0;                  ///< endOfGeneration() time
+  double spawnSeconds = 0.0;                            ///< spawnNewGeneration() time
+  uint64_t residentSetBytes = 0;                        ///< Current RSS when the row was submitted
+};
+
+/**
+ * @struct MetricsConfig
+ * @brief Output location, format, queue bound and flush policy
+ */
+struct MetricsConfig {
+  MetricsFormat format = MetricsFormat::CSV;  ///< Output format (NONE disables the writer)
+  std::string logDir = "./output/logs/";      ///< Directory for epoch-log.csv / epoch-log.bin
+  size_t queueCapacity = 1024;                ///< Rows held before submit() starts dropping
+  size_t queueMemoryBytes = 64 << 20;         ///< Bytes of unwritten rows before submit() drops (0 = no cap)
+  unsigned flushEveryRows = 16;               ///< Flush after this many rows (0 = interval only)
+  unsigned flushIntervalMs = 1000;            ///< Flush at least this often while rows arrive (0 = rows only)
+};
+
+/**
+ * @class MetricsWriter
+ * @brief Bounded queue plus background writer for per-generation metrics
+ *
+ * @par Threading Model
+ * submit() is called from the simulation thread. It only takes a mutex long
+ * enough to push one row and never waits for I/O. If the queue is full, or
+ * the rows not yet written would exceed MetricsConfig::queueMemoryBytes, the
+ * row is dropped and counted, so a slow disk cannot stall the simulation. The
+ * writer thread takes the whole queue at once, then computes and writes the
+ * rows without holding the lock.
+ *
+ * @par Usage Pattern
+ * 1. start() once per simulator() run
+ * 2. submit() once per generation
+ * 3. flush() before reading the file from another process (graph updates)
+ * 4. stop() at the end of the run to drain, flush and close
+ */
+class MetricsWriter {
+ public:
+  MetricsWriter() = default;
+  ~MetricsWriter();
+
+  MetricsWriter(const MetricsWriter&) = delete;
+  MetricsWriter& operator=(const MetricsWriter&) = delete;
+
+  /**
+   * @brief Truncate the log, write the schema header and start the writer thread
+   *
+   * Stops a previous session first. With MetricsFormat::NONE, nothing is
+   * opened and submit() discards rows.
+   *
+   * @param config Output and flush settings
+   * @return false if the output file cannot be opened (the writer stays disabled)
+   */
+  bool start(const MetricsConfig& config);
+
+  /**
+   * @brief Queue one row without blocking on I/O
+   * @param row Metrics for the generation that just ended
+   * @return false if the writer is disabled or the queue or its memory budget is full (row dropped)
+   */
+  bool submit(GenerationMetrics&& row);
+
+  /**
+   * @brief Block until every submitted row is written and flushed
+   */
+  void flush();
+
+  /**
+   * @brief Drain the queue, flush, close the file and join the writer thread
+   */
+  void stop();
+
+  /** @brief True between a successful start() with a file format and stop() */
+  bool enabled() const;
+
+  /** @brief Rows written since start() */
+  uint64_t writtenRows() const;
+
+  /** @brief Rows dropped because the queue or its memory budget was full, since start() */
+  uint64_t droppedRows() const;
+
+  /** @brief Path of the current log file (empty if disabled) */
+  const std::string& path() const { return path_; }
+
+  /** @brief Column schema shared by the CSV and binary formats */
+  static const std::vector<MetricsColumn>& schema();
+
+ private:
+  void writerLoop();
+  void writeHeader();
+  void writeRow(const GenerationMetrics& row);
+
+  MetricsConfig config_;
+  std::string path_;
+  std::ofstream file_;
+
+  mutable std::mutex mutex_;            ///< Guards everything below
+  std::condition_variable wakeWriter_;  ///< Rows queued, flush requested or stopping
+  std::condition_variable flushed_;     ///< Writer caught up with a flush request
+  std::deque<GenerationMetrics> queue_;
+  std::thread thread_;
+  bool running_ = false;
+  bool stopRequested_ = false;
+  uint64_t flushRequests_ = 0;  ///< Incremented by flush()
+  uint64_t flushesServed_ = 0;  ///< Last flush request the writer completed
+  size_t pendingBytes_ = 0;     ///< Bytes of rows submitted but not yet written
+  uint64_t writtenRows_ = 0;
+  uint64_t droppedRows_ = 0;
+};
+
+/**
+ * @brief Global metrics writer, started and stopped by simulator()
+ */
+extern MetricsWriter metricsWriter;
+
+}  // namespace Metrics
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+// Backward compatibility aliases
+namespace BioSim {
+using IO::Metrics::GenerationMetrics;
+using IO::Metrics::metricsWriter;
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_METRICS_METRICSWRITER_H_
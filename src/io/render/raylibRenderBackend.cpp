@@ -3,39 +3,33 @@
  * @brief Raylib-based implementation of the rendering backend interface.
  *
  * This file provides a concrete implementation of IRenderBackend using the raylib
- * library for image manipulation and frame buffer management, with FFmpeg library
- * integration for professional-quality video encoding.
+ * library for image manipulation, with FFmpeg library integration for
+ * professional-quality video encoding.
  *
  * Video Encoding Strategy:
  * - raylib provides Image manipulation for frame rendering
- * - FFmpeg libavcodec/libavformat libraries handle video encoding
+ * - Each finished frame is streamed to a VideoEncoder (FFmpeg libavcodec/libavformat)
  * - Direct API usage (no external process calls)
- * - H.264 codec with MP4/AVI container support
+ * - H.264 codec with AVI container, MPEG-4 fallback
  */
 
 #include "../../types/params.h"
 #include "../../utils/logger.h"
+#include "../video/videoEncoder.h"
 #include "renderBackend.h"
+#include "signalBlitter.h"
+#include "staticBackground.h"
 
 #include <spdlog/fmt/fmt.h>
 
 #include <cmath>
-#include <fstream>
-#include <sstream>
-#include <vector>
+#include <filesystem>
+#include <string>
+#include <system_error>
 
 // Raylib includes
 #include "raylib.h"
 
-// FFmpeg includes (C API, use extern "C")
-extern "C" {
-#include <libavcodec/avcodec.h>
-#include <libavformat/avformat.h>
-#include <libavutil/imgutils.h>
-#include <libavutil/opt.h>
-#include <libswscale/swscale.h>
-}
-
 namespace BioSim {
 inline namespace v1 {
 namespace IO {
@@ -45,16 +39,19 @@ namespace Render {
  * @class RaylibRenderBackend
  * @brief Concrete rendering backend using raylib library.
  *
- * This class wraps raylib image operations in the IRenderBackend interface.
- * It maintains a vector of raylib Images to buffer frames and provides drawing
- * primitives that match the IRenderBackend contract.
+ * This class wraps raylib image operations in the IRenderBackend interface and
+ * provides drawing primitives that match the IRenderBackend contract. Finished
+ * frames are not buffered: endFrame() streams each one to a VideoEncoder that
+ * is opened by the first frame of a generation, so memory stays at one frame
+ * plus the codec's lookahead however long the generation is.
  *
  * Implementation Details:
  * - Uses raylib Image (PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
  * - Y-axis uses simulation convention (0=bottom, max=top)
  * - Alpha blending done via manual pixel operations for transparency
+ * - Pheromone layers are blended in bulk by a SignalBlitter on the image's pixel data
+ * - The zone and barriers are drawn once per generation and copied into each frame (StaticBackground)
  * - Video encoding via FFmpeg libavcodec/libavformat APIs (no external processes)
- * - H.264 codec with AVI container (MPEG-4 fallback if H.264 unavailable)
  *
  * Thread Safety:
  * - NOT thread-safe - caller must synchronize access
@@ -66,11 +63,19 @@ class RaylibRenderBackend : public IRenderBackend {
   ~RaylibRenderBackend() override;
 
   void init(uint16_t gridWidth, uint16_t gridHeight, uint16_t displayScale, uint16_t agentSize) override;
+  void setOutputDirectory(const std::string& outputPath) override;
+  void setEncoderSettings(const Video::EncoderSettings& settings) override;
+  void setWorldView(uint16_t worldWidth, uint16_t worldHeight, int16_t originX, int16_t originY) override;
   void startNewGeneration() override;
   void beginFrame(unsigned simStep, unsigned generation) override;
   void drawChallengeZone(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration) override;
   void drawRectangle(int16_t x1, int16_t y1, int16_t x2, int16_t y2, const Color& color) override;
   void drawCircle(int16_t centerX, int16_t centerY, uint16_t radius, const Color& color) override;
+  void drawSignalLayer(const uint8_t* cells, uint16_t sizeX, uint16_t sizeY, const Color& color,
+                       const SignalAlphaLut& alphaLut) override;
+  void drawBackground(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration,
+                      const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) override;
+  void drawBarriers(const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) override;
   void endFrame() override;
   bool saveVideo(unsigned generation, const std::string& outputPath) override;
   size_t getFrameCount() const override;
@@ -93,46 +98,47 @@ class RaylibRenderBackend : public IRenderBackend {
    */
   ::Color toRaylibColor(const Color& color) const;
 
-  /**
-   * @brief Free all buffered frames.
-   */
-  void clearFrameBuffer();
-
-  /**
-   * @brief Encode frames to video using FFmpeg API (no external process calls).
-   *
-   * @param generation Generation number for filename
-   * @param outputPath Base directory for output
-   * @return true if successful, false otherwise
-   */
-  bool exportAndEncodeVideo(unsigned generation, const std::string& outputPath);
-
   uint16_t gridWidth_;     ///< Simulation grid width in cells
   uint16_t gridHeight_;    ///< Simulation grid height in cells
+  uint16_t worldWidth_;    ///< Width of the whole world in cells (see setWorldView())
+  uint16_t worldHeight_;   ///< Height of the whole world in cells
+  int16_t originX_;        ///< World column of grid cell (0, 0)
+  int16_t originY_;        ///< World row of grid cell (0, 0)
   uint16_t displayScale_;  ///< Pixel scaling factor (pixels per grid cell)
   uint16_t agentSize_;     ///< Agent circle radius in pixels
   int imageWidth_;         ///< Image width in pixels
   int imageHeight_;        ///< Image height in pixels
 
-  Image currentFrame_;              ///< Frame currently being drawn
-  std::vector<Image> frameBuffer_;  ///< Accumulated frames for video
-  bool frameInProgress_;            ///< True if beginFrame() called without endFrame()
+  Image currentFrame_;           ///< Frame currently being drawn
+  bool frameInProgress_;         ///< True if beginFrame() called without endFrame()
+  unsigned frameGeneration_;     ///< Generation passed to beginFrame()
+  int frameBackground_;          ///< Background slot copied into this frame, -1 if none
+  std::string outputDir_;        ///< Where a generation's video is opened
+  Video::VideoEncoder encoder_;  ///< Streams the current generation's frames
+  SignalBlitter signalBlitter_;  ///< Bulk pheromone layer blending
+  StaticBackground background_;  ///< Cached zone and barriers of the current generation
 };
 
 RaylibRenderBackend::RaylibRenderBackend()
     : gridWidth_(0),
       gridHeight_(0),
+      worldWidth_(0),
+      worldHeight_(0),
+      originX_(0),
+      originY_(0),
       displayScale_(1),
       agentSize_(1),
       imageWidth_(0),
       imageHeight_(0),
-      frameInProgress_(false) {
+      frameInProgress_(false),
+      frameGeneration_(0),
+      frameBackground_(-1) {
   // Note: We don't call InitWindow() since we're running headless
   // raylib image functions work without window initialization
 }
 
 RaylibRenderBackend::~RaylibRenderBackend() {
-  clearFrameBuffer();
+  encoder_.abort();
   if (frameInProgress_) {
     UnloadImage(currentFrame_);
   }
@@ -141,6 +147,10 @@ RaylibRenderBackend::~RaylibRenderBackend() {
 void RaylibRenderBackend::init(uint16_t gridWidth, uint16_t gridHeight, uint16_t displayScale, uint16_t agentSize) {
   gridWidth_ = gridWidth;
   gridHeight_ = gridHeight;
+  worldWidth_ = gridWidth;
+  worldHeight_ = gridHeight;
+  originX_ = 0;
+  originY_ = 0;
   displayScale_ = displayScale;
   agentSize_ = agentSize;
   imageWidth_ = gridWidth * displayScale;
@@ -148,8 +158,29 @@ void RaylibRenderBackend::init(uint16_t gridWidth, uint16_t gridHeight, uint16_t
   startNewGeneration();
 }
 
+void RaylibRenderBackend::setOutputDirectory(const std::string& outputPath) {
+  outputDir_ = outputPath;
+}
+
+void RaylibRenderBackend::setEncoderSettings(const Video::EncoderSettings& settings) {
+  encoder_.setSettings(settings);
+}
+
+void RaylibRenderBackend::setWorldView(uint16_t worldWidth, uint16_t worldHeight, int16_t originX, int16_t originY) {
+  worldWidth_ = worldWidth;
+  worldHeight_ = worldHeight;
+  originX_ = originX;
+  originY_ = originY;
+  background_.invalidate();
+}
+
 void RaylibRenderBackend::startNewGeneration() {
-  clearFrameBuffer();
+  // Frames of an unfinished video are discarded, like the old per-generation buffer
+  encoder_.abort();
+  background_.invalidate();
+  if (frameInProgress_) {
+    UnloadImage(currentFrame_);
+  }
   frameInProgress_ = false;
 }
 
@@ -159,13 +190,20 @@ void RaylibRenderBackend::beginFrame(unsigned simStep, unsigned generation) {
     UnloadImage(currentFrame_);
   }
 
+  // The first frame of a generation opens its video; the name is fixed up in saveVideo() if needed
+  if (!outputDir_.empty() && !encoder_.isOpen()) {
+    encoder_.open(Video::generationVideoPath(outputDir_, generation, encoder_.settings().profile), imageWidth_,
+                  imageHeight_);
+  }
+
   // Create blank white canvas (use raylib's Color type explicitly)
   currentFrame_ = GenImageColor(imageWidth_, imageHeight_, ::Color{255, 255, 255, 255});
   frameInProgress_ = true;
+  frameGeneration_ = generation;
+  frameBackground_ = -1;
 
-  // Metadata is stored but not drawn (used for debugging/logging)
-  (void)simStep;     // unused for now
-  (void)generation;  // unused for now
+  // Metadata is not drawn (used for debugging/logging)
+  (void)simStep;  // unused for now
 }
 
 void RaylibRenderBackend::drawChallengeZone(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration) {
@@ -177,23 +215,23 @@ void RaylibRenderBackend::drawChallengeZone(ChallengeZoneType zoneType, unsigned
   switch (zoneType) {
     case ChallengeZoneType::CENTER_WEIGHTED:
     case ChallengeZoneType::CENTER_UNWEIGHTED: {
-      // Green circle in center (safe zone)
-      int centerX = imageWidth_ / 2;
-      int centerY = imageHeight_ / 2;
-      int radius = static_cast<int>(gridHeight_ * displayScale_ / 3.0f);
+      // Green circle in the center of the world (safe zone), shifted by the view
+      int centerX = worldWidth_ * displayScale_ / 2 - originX_ * displayScale_;
+      int centerY = worldHeight_ * displayScale_ / 2 - (worldHeight_ - originY_ - gridHeight_) * displayScale_;
+      int radius = static_cast<int>(worldHeight_ * displayScale_ / 3.0f);
       ::Color green = {0xa0, 0xff, 0xa0, 0xff};
       ImageDrawCircle(&currentFrame_, centerX, centerY, radius, green);
       break;
     }
 
     case ChallengeZoneType::RADIOACTIVE_WALLS: {
-      // Yellow wall on left half, then right half of generation
+      // Yellow wall on the world's left edge, then its right edge in the second half of the generation
       ::Color yellow = {0xff, 0xff, 0xa0, 0xff};
       int wallWidth = 5 * displayScale_;
-      int xOffset = 0;
+      int xOffset = -originX_ * displayScale_;
 
       if (simStep >= stepsPerGeneration / 2) {
-        xOffset = imageWidth_ - wallWidth;
+        xOffset += worldWidth_ * displayScale_ - wallWidth;
       }
 
       ImageDrawRectangle(&currentFrame_, xOffset, 0, wallWidth, imageHeight_, yellow);
@@ -291,16 +329,57 @@ void RaylibRenderBackend::drawCircle(int16_t centerX, int16_t centerY, uint16_t
   }
 }
 
+void RaylibRenderBackend::drawSignalLayer(const uint8_t* cells, uint16_t sizeX, uint16_t sizeY, const Color& color,
+                                          const SignalAlphaLut& alphaLut) {
+  if (!frameInProgress_) {
+    Logger::error("drawSignalLayer() called before beginFrame()");
+    return;
+  }
+  // GenImageColor() images are PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, so the data can be blended directly
+  signalBlitter_.blit(static_cast<uint8_t*>(currentFrame_.data), imageWidth_, imageHeight_, displayScale_, cells, sizeX,
+                      sizeY, color, alphaLut);
+}
+
+void RaylibRenderBackend::drawBackground(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration,
+                                         const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) {
+  if (!frameInProgress_) {
+    Logger::error("drawBackground() called before beginFrame()");
+    return;
+  }
+
+  uint8_t* rgba = static_cast<uint8_t*>(currentFrame_.data);
+  const unsigned slot = background_.select(frameGeneration_, zoneType, simStep, stepsPerGeneration, barrierLocs,
+                                           imageWidth_, imageHeight_, displayScale_);
+  if (background_.has(slot)) {
+    background_.copyTo(slot, rgba);
+  } else {
+    drawChallengeZone(zoneType, simStep, stepsPerGeneration);
+    background_.fillBarriers(rgba, barrierColor);
+    background_.store(slot, rgba);
+  }
+  frameBackground_ = static_cast<int>(slot);
+}
+
+void RaylibRenderBackend::drawBarriers(const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) {
+  if (!frameInProgress_) {
+    Logger::error("drawBarriers() called before beginFrame()");
+    return;
+  }
+  if (frameBackground_ < 0 || !background_.coversBarriers(barrierLocs)) {
+    IRenderBackend::drawBarriers(barrierLocs, barrierColor);
+    return;
+  }
+  background_.restoreBarriers(static_cast<unsigned>(frameBackground_), static_cast<uint8_t*>(currentFrame_.data));
+}
+
 void RaylibRenderBackend::endFrame() {
   if (!frameInProgress_) {
     Logger::warning("endFrame() called without beginFrame()");
     return;
   }
 
-  // Add completed frame to buffer
-  // Note: We need to make a copy since Image is a struct with pointers
-  Image frameCopy = ImageCopy(currentFrame_);
-  frameBuffer_.push_back(frameCopy);
+  // Encode the completed frame now instead of buffering it until the generation ends
+  encoder_.addFrame(static_cast<const uint8_t*>(currentFrame_.data), 4 * imageWidth_);
 
   // Clean up current frame
   UnloadImage(currentFrame_);
@@ -308,18 +387,37 @@ void RaylibRenderBackend::endFrame() {
 }
 
 bool RaylibRenderBackend::saveVideo(unsigned generation, const std::string& outputPath) {
-  if (frameBuffer_.empty()) {
+  if (!encoder_.isOpen() || encoder_.frameCount() == 0) {
     Logger::warning("No frames to save for generation {}", generation);
+    encoder_.abort();
+    return false;
+  }
+
+  const size_t frames = encoder_.frameCount();
+  const std::string encodedPath = encoder_.path();
+  Logger::info("Finishing video of {} frames for generation {}", frames, generation);
+  if (!encoder_.close()) {
+    Logger::error("Could not finalize video {}", encodedPath);
     return false;
   }
 
-  Logger::info("Saving {} frames for generation {}", frameBuffer_.size(), generation);
+  // Frames were streamed to the path chosen by the first beginFrame(); move the file if the caller expects another
+  const std::string outputFile = Video::generationVideoPath(outputPath, generation, encoder_.settings().profile);
+  if (outputFile != encodedPath) {
+    std::error_code error;
+    std::filesystem::rename(encodedPath, outputFile, error);
+    if (error) {
+      Logger::error("Could not move video {} to {}: {}", encodedPath, outputFile, error.message());
+      return false;
+    }
+  }
 
-  return exportAndEncodeVideo(generation, outputPath);
+  Logger::success("Video saved: {}", outputFile);
+  return true;
 }
 
 size_t RaylibRenderBackend::getFrameCount() const {
-  return frameBuffer_.size();
+  return encoder_.frameCount();
 }
 
 int RaylibRenderBackend::toScreenY(int16_t simY) const {
@@ -331,195 +429,10 @@ int RaylibRenderBackend::toScreenY(int16_t simY) const {
   return ::Color{color.r, color.g, color.b, color.a};
 }
 
-void RaylibRenderBackend::clearFrameBuffer() {
-  for (auto& frame : frameBuffer_) {
-    UnloadImage(frame);
-  }
-  frameBuffer_.clear();
-}
-
-bool RaylibRenderBackend::exportAndEncodeVideo(unsigned generation, const std::string& outputPath) {
-  // Build output video path
-  std::stringstream videoPath;
-  videoPath << outputPath << "/gen-" << std::setfill('0') << std::setw(6) << generation << ".avi";
-  std::string outputFile = videoPath.str();
-
-  Logger::info("Encoding {} frames using FFmpeg API...", frameBuffer_.size());
-
-  // Initialize FFmpeg codec
-  const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_H264);
-  if (!codec) {
-    // Fallback to MPEG4 if H264 not available
-    codec = avcodec_find_encoder(AV_CODEC_ID_MPEG4);
-    if (!codec) {
-      Logger::error("No suitable video codec found (H264/MPEG4)");
-      return false;
-    }
-    Logger::info("Using MPEG-4 codec (H.264 not available)");
-  }
-
-  AVCodecContext* codecCtx = avcodec_alloc_context3(codec);
-  if (!codecCtx) {
-    Logger::error("Could not allocate codec context");
-    return false;
-  }
-
-  // Configure codec parameters
-  codecCtx->bit_rate = 400000;
-  codecCtx->width = imageWidth_;
-  codecCtx->height = imageHeight_;
-  codecCtx->time_base = {1, 25};  // 25 FPS
-  codecCtx->framerate = {25, 1};
-  codecCtx->gop_size = 10;
-  codecCtx->max_b_frames = 1;
-  codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
-
-  // Set codec-specific options
-  if (codec->id == AV_CODEC_ID_H264) {
-    av_opt_set(codecCtx->priv_data, "preset", "medium", 0);
-    av_opt_set(codecCtx->priv_data, "crf", "23", 0);
-  }
-
-  // Open codec
-  if (avcodec_open2(codecCtx, codec, nullptr) < 0) {
-    Logger::error("Could not open codec");
-    avcodec_free_context(&codecCtx);
-    return false;
-  }
-
-  // Create output format context
-  AVFormatContext* formatCtx = nullptr;
-  avformat_alloc_output_context2(&formatCtx, nullptr, "avi", outputFile.c_str());
-  if (!formatCtx) {
-    Logger::error("Could not create format context");
-    avcodec_free_context(&codecCtx);
-    return false;
-  }
-
-  // Add video stream
-  AVStream* stream = avformat_new_stream(formatCtx, nullptr);
-  if (!stream) {
-    Logger::error("Could not create stream");
-    avformat_free_context(formatCtx);
-    avcodec_free_context(&codecCtx);
-    return false;
-  }
-
-  stream->time_base = codecCtx->time_base;
-  avcodec_parameters_from_context(stream->codecpar, codecCtx);
-
-  // Open output file
-  if (!(formatCtx->oformat->flags & AVFMT_NOFILE)) {
-    if (avio_open(&formatCtx->pb, outputFile.c_str(), AVIO_FLAG_WRITE) < 0) {
-      Logger::error("Could not open output file: {}", outputFile);
-      avformat_free_context(formatCtx);
-      avcodec_free_context(&codecCtx);
-      return false;
-    }
-  }
-
-  // Write header
-  if (avformat_write_header(formatCtx, nullptr) < 0) {
-    Logger::error("Could not write format header");
-    avio_closep(&formatCtx->pb);
-    avformat_free_context(formatCtx);
-    avcodec_free_context(&codecCtx);
-    return false;
-  }
-
-  // Create frame and packet
-  AVFrame* frame = av_frame_alloc();
-  if (!frame) {
-    Logger::error("Could not allocate frame");
-    av_write_trailer(formatCtx);
-    avio_closep(&formatCtx->pb);
-    avformat_free_context(formatCtx);
-    avcodec_free_context(&codecCtx);
-    return false;
-  }
-
-  frame->format = codecCtx->pix_fmt;
-  frame->width = codecCtx->width;
-  frame->height = codecCtx->height;
-
-  if (av_frame_get_buffer(frame, 0) < 0) {
-    Logger::error("Could not allocate frame data");
-    av_frame_free(&frame);
-    av_write_trailer(formatCtx);
-    avio_closep(&formatCtx->pb);
-    avformat_free_context(formatCtx);
-    avcodec_free_context(&codecCtx);
-    return false;
-  }
-
-  // Create scaler for RGB to YUV420P conversion
-  SwsContext* swsCtx = sws_getContext(imageWidth_, imageHeight_, AV_PIX_FMT_RGBA, codecCtx->width, codecCtx->height,
-                                      codecCtx->pix_fmt, SWS_BILINEAR, nullptr, nullptr, nullptr);
-  if (!swsCtx) {
-    Logger::error("Could not create scaler context");
-    av_frame_free(&frame);
-    av_write_trailer(formatCtx);
-    avio_closep(&formatCtx->pb);
-    avformat_free_context(formatCtx);
-    avcodec_free_context(&codecCtx);
-    return false;
-  }
-
-  // Encode each frame
-  AVPacket* pkt = av_packet_alloc();
-  for (size_t i = 0; i < frameBuffer_.size(); ++i) {
-    // Convert raylib Image to FFmpeg frame
-    uint8_t* srcData[1] = {static_cast<uint8_t*>(frameBuffer_[i].data)};
-    int srcLinesize[1] = {4 * imageWidth_};  // RGBA = 4 bytes per pixel
-
-    sws_scale(swsCtx, srcData, srcLinesize, 0, imageHeight_, frame->data, frame->linesize);
-
-    frame->pts = i;
-
-    // Send frame to encoder
-    if (avcodec_send_frame(codecCtx, frame) < 0) {
-      Logger::error("Could not send frame {} to encoder", i);
-      continue;
-    }
-
-    // Receive encoded packets
-    while (avcodec_receive_packet(codecCtx, pkt) == 0) {
-      av_packet_rescale_ts(pkt, codecCtx->time_base, stream->time_base);
-      pkt->stream_index = stream->index;
-      av_interleaved_write_frame(formatCtx, pkt);
-      av_packet_unref(pkt);
-    }
-  }
-
-  // Flush encoder
-  avcodec_send_frame(codecCtx, nullptr);
-  while (avcodec_receive_packet(codecCtx, pkt) == 0) {
-    av_packet_rescale_ts(pkt, codecCtx->time_base, stream->time_base);
-    pkt->stream_index = stream->index;
-    av_interleaved_write_frame(formatCtx, pkt);
-    av_packet_unref(pkt);
-  }
-
-  // Write trailer and cleanup
-  av_write_trailer(formatCtx);
-
-  av_packet_free(&pkt);
-  sws_freeContext(swsCtx);
-  av_frame_free(&frame);
-  avio_closep(&formatCtx->pb);
-  avformat_free_context(formatCtx);
-  avcodec_free_context(&codecCtx);
-
-  Logger::success("Video saved: {}", outputFile);
-  return true;
-}
-
 /**
  * @brief Factory function implementation for raylib backend.
- *
- * This replaces the CImg-based implementation as the default backend.
  */
-std::unique_ptr<IRenderBackend> createDefaultRenderBackend() {
+std::unique_ptr<IRenderBackend> createRaylibRenderBackend() {
   return std::make_unique<RaylibRenderBackend>();
 }
 
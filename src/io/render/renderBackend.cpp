@@ -0,0 +1,55 @@
+/**
+ * @file renderBackend.cpp
+ * @brief Runtime selection of the rendering backend and default IRenderBackend operations.
+ */
+
+#include "renderBackend.h"
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Render {
+
+void IRenderBackend::drawSignalLayer(const uint8_t* cells, uint16_t sizeX, uint16_t sizeY, const Color& color,
+                                     const SignalAlphaLut& alphaLut) {
+  for (int16_t x = 0; x < sizeX; ++x) {
+    for (int16_t y = 0; y < sizeY; ++y) {
+      const uint8_t alpha = alphaLut[*cells++];
+      if (alpha > 0) {
+        drawRectangle(x - 1, y - 1, x + 1, y + 1, Color(color.r, color.g, color.b, alpha));
+      }
+    }
+  }
+}
+
+void IRenderBackend::drawBackground(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration,
+                                    const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) {
+  (void)barrierLocs;
+  (void)barrierColor;
+  drawChallengeZone(zoneType, simStep, stepsPerGeneration);
+}
+
+void IRenderBackend::drawBarriers(const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) {
+  for (const auto& loc : barrierLocs) {
+    drawRectangle(loc.x, loc.y, loc.x + 1, loc.y + 1, barrierColor);
+  }
+}
+
+std::unique_ptr<IRenderBackend> createDefaultRenderBackend() {
+  return createSoftwareRenderBackend();
+}
+
+std::unique_ptr<IRenderBackend> createRenderBackend(const std::string& name) {
+  if (name == "software") {
+    return createSoftwareRenderBackend();
+  }
+  if (name == "raylib") {
+    return createRaylibRenderBackend();
+  }
+  return nullptr;
+}
+
+}  // namespace Render
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
@@ -21,7 +21,9 @@
  */
 
 #include "../../types/basicTypes.h"
+#include "../video/videoEncoder.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -57,6 +59,11 @@ struct Color {
   }
 };
 
+/**
+ * @brief Blend alpha (0-255) for each signal intensity (0-255) of a pheromone layer.
+ */
+using SignalAlphaLut = std::array<uint8_t, 256>;
+
 /**
  * @enum ChallengeZoneType
  * @brief Visual indicators for different survival challenge zones.
@@ -111,10 +118,47 @@ class IRenderBackend {
   virtual void init(uint16_t gridWidth, uint16_t gridHeight, uint16_t displayScale, uint16_t agentSize) = 0;
 
   /**
-   * @brief Start a new video generation, clearing any accumulated frames.
+   * @brief Set the directory that streaming backends write videos to while frames arrive.
    *
-   * Called at the beginning of each generation to reset frame buffers.
-   * Any previously buffered frames are discarded.
+   * Backends that keep frames in memory until saveVideo() can ignore this.
+   *
+   * @param outputPath Video output directory (e.g., "output/images/")
+   */
+  virtual void setOutputDirectory(const std::string& outputPath) { (void)outputPath; }
+
+  /**
+   * @brief Select the encoder profile and codec threads of the following videos.
+   *
+   * Backends without their own encoder can ignore this.
+   *
+   * @param settings Encoder setup, applied when the next video is opened
+   */
+  virtual void setEncoderSettings(const Video::EncoderSettings& settings) { (void)settings; }
+
+  /**
+   * @brief Place the rendered grid inside a larger world (region-of-interest capture).
+   *
+   * Draw calls stay in frame cells; only challenge zones, which are defined
+   * by the world's geometry, need to know the offset. init() resets the view
+   * to the grid itself. Backends without challenge zones can ignore this.
+   *
+   * @param worldWidth World width in cells
+   * @param worldHeight World height in cells
+   * @param originX World column of the frame's cell (0, 0)
+   * @param originY World row of the frame's cell (0, 0)
+   */
+  virtual void setWorldView(uint16_t worldWidth, uint16_t worldHeight, int16_t originX, int16_t originY) {
+    (void)worldWidth;
+    (void)worldHeight;
+    (void)originX;
+    (void)originY;
+  }
+
+  /**
+   * @brief Start a new video generation, discarding any unsaved frames.
+   *
+   * Called at the beginning of each generation. Frames of a video that was
+   * not finished with saveVideo() are discarded.
    */
   virtual void startNewGeneration() = 0;
 
@@ -176,23 +220,69 @@ class IRenderBackend {
   virtual void drawCircle(int16_t centerX, int16_t centerY, uint16_t radius, const Color& color) = 0;
 
   /**
-   * @brief Finalize the current frame and buffer it for video output.
+   * @brief Blend a whole pheromone layer over the frame.
    *
-   * Completes the frame started by beginFrame() and adds it to the internal
-   * video frame buffer. The frame can be encoded to video later via saveVideo().
+   * Every cell with a nonzero alpha is drawn as a 2x2-cell square, exactly like
+   * drawRectangle(x - 1, y - 1, x + 1, y + 1, color with alphaLut[intensity]).
+   * The default implementation does just that; backends with direct pixel
+   * access override it with a single bulk pass.
+   *
+   * @param cells Signal intensities, column-major (cells[x * sizeY + y])
+   * @param sizeX Grid width in cells
+   * @param sizeY Grid height in cells
+   * @param color Layer color (its alpha is ignored)
+   * @param alphaLut Blend alpha for each intensity
+   */
+  virtual void drawSignalLayer(const uint8_t* cells, uint16_t sizeX, uint16_t sizeY, const Color& color,
+                               const SignalAlphaLut& alphaLut);
+
+  /**
+   * @brief Draw the static part of the frame: challenge zone, and barriers if the backend caches them.
+   *
+   * Called right after beginFrame(). Within a generation the zone and the
+   * barriers do not change (RADIOACTIVE_WALLS has one state per half of the
+   * generation), so backends may render them once per generation and copy
+   * the cached image into every frame. The default just draws the zone;
+   * barriers are always completed by drawBarriers().
+   *
+   * @param zoneType Type of challenge zone to render
+   * @param simStep Current simulation step (selects the radioactive wall side)
+   * @param stepsPerGeneration Total steps per generation
+   * @param barrierLocs Barrier cells, fixed for the generation
+   * @param barrierColor Barrier fill color
+   */
+  virtual void drawBackground(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration,
+                              const std::vector<Coordinate>& barrierLocs, const Color& barrierColor);
+
+  /**
+   * @brief Draw barrier cells over everything drawn so far (e.g. pheromone layers).
+   *
+   * The default draws one rectangle per cell. Backends that cached the barriers
+   * in drawBackground() copy the barrier pixels back from that cache instead.
+   *
+   * @param barrierLocs Barrier cells (the same list given to drawBackground())
+   * @param barrierColor Barrier fill color
+   */
+  virtual void drawBarriers(const std::vector<Coordinate>& barrierLocs, const Color& barrierColor);
+
+  /**
+   * @brief Finalize the current frame and add it to the generation's video.
+   *
+   * Completes the frame started by beginFrame(). Depending on the backend the
+   * frame is encoded immediately or kept until saveVideo().
    */
   virtual void endFrame() = 0;
 
   /**
-   * @brief Encode all buffered frames into a video file.
+   * @brief Finish the generation's video file.
    *
-   * Writes accumulated frames from the current generation to an AVI video file
-   * with the specified generation number in the filename. Clears frame buffer
-   * after successful encoding.
+   * Writes the frames of the current generation to a video file with the
+   * specified generation number in the filename. Afterwards the backend is
+   * ready for the next generation's frames.
    *
    * Video properties (implementation-dependent):
-   * - Format: AVI container
-   * - Codec: H264 preferred, MJPEG fallback
+   * - Format: AVI container (Y4M for the raw encoder profile)
+   * - Codec: per the encoder profile, H264 by default with an MPEG-4 fallback
    * - Frame rate: 25 FPS
    * - Resolution: gridWidth * displayScale x gridHeight * displayScale
    *
@@ -200,18 +290,18 @@ class IRenderBackend {
    * @param outputPath Base directory path for video output (e.g., "output/images/")
    * @return true if video saved successfully, false on error
    *
-   * @note Blocking operation - may take several seconds for long videos
+   * @note Blocking operation - backends that encode on endFrame() only flush the codec here
    * @note Logs errors to stderr but does not throw exceptions
    */
   virtual bool saveVideo(unsigned generation, const std::string& outputPath) = 0;
 
   /**
-   * @brief Get the count of video frames currently buffered.
+   * @brief Get the count of video frames added since startNewGeneration().
    *
    * Returns the number of frames accumulated since startNewGeneration().
    * Useful for logging and debugging video generation issues.
    *
-   * @return Number of buffered frames waiting to be encoded
+   * @return Number of frames in the generation's unfinished video
    */
   virtual size_t getFrameCount() const = 0;
 };
@@ -219,9 +309,7 @@ class IRenderBackend {
 /**
  * @brief Factory function to create the default rendering backend.
  *
- * Currently returns a CImg-based implementation. In the future, this can
- * be extended to return different backends based on compile-time or
- * runtime configuration (e.g., -DUSE_RAYLIB flag).
+ * Returns the software rasterizer, which needs no display or GPU.
  *
  * @return Unique pointer to a concrete IRenderBackend implementation
  *
@@ -230,6 +318,20 @@ class IRenderBackend {
  */
 std::unique_ptr<IRenderBackend> createDefaultRenderBackend();
 
+/**
+ * @brief Create a rendering backend by name (the renderBackend config parameter).
+ *
+ * @param name "software" (CPU span rasterizer) or "raylib" (raylib image functions)
+ * @return The backend, or nullptr if the name is unknown
+ */
+std::unique_ptr<IRenderBackend> createRenderBackend(const std::string& name);
+
+/** @brief Create the CPU span rasterizer backend (softwareRenderBackend.cpp) */
+std::unique_ptr<IRenderBackend> createSoftwareRenderBackend();
+
+/** @brief Create the raylib image backend (raylibRenderBackend.cpp) */
+std::unique_ptr<IRenderBackend> createRaylibRenderBackend();
+
 }  // namespace Render
 }  // namespace IO
 }  // namespace v1
@@ -240,7 +342,9 @@ namespace BioSim {
 using IO::Render::ChallengeZoneType;
 using IO::Render::Color;
 using IO::Render::createDefaultRenderBackend;
+using IO::Render::createRenderBackend;
 using IO::Render::IRenderBackend;
+using IO::Render::SignalAlphaLut;
 }  // namespace BioSim
 
 #endif  // BIOSIM_RENDER_BACKEND_H_INCLUDED
@@ -0,0 +1,92 @@
+/**
+ * @file signalBlitter.cpp
+ * @brief Implementation of bulk pheromone layer blending
+ */
+
+#include "signalBlitter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Render {
+
+namespace {
+
+/** @brief Multiply two transmittances in 1/255 units, rounded */
+inline unsigned attenuate(unsigned transmittance, uint8_t alpha) {
+  return (transmittance * (255u - alpha) + 127u) / 255u;
+}
+
+}  // namespace
+
+void SignalBlitter::blit(uint8_t* rgba, int imageWidth, int imageHeight, uint16_t displayScale, const uint8_t* cells,
+                         uint16_t sizeX, uint16_t sizeY, const Color& color, const SignalAlphaLut& alphaLut) {
+  if (sizeX == 0 || sizeY == 0 || imageWidth != sizeX * displayScale || imageHeight != sizeY * displayScale) {
+    return;
+  }
+
+  // Pass 1: cell (x, y) covers columns x-1..x and simulation rows y..y+1 (the drawRectangle() mapping),
+  // so cell (cx, cy) is covered by sources (cx, cy), (cx + 1, cy), (cx, cy - 1) and (cx + 1, cy - 1)
+  cellAlpha_.assign(static_cast<size_t>(sizeX) * sizeY, 0);
+  bool anyCoverage = false;
+  for (uint16_t x = 0; x < sizeX; ++x) {
+    const uint8_t* column = cells + static_cast<size_t>(x) * sizeY;
+    for (uint16_t y = 0; y < sizeY; ++y) {
+      const uint8_t alpha = alphaLut[column[y]];
+      if (alpha == 0) {
+        continue;
+      }
+      anyCoverage = true;
+      for (int cx = x - 1; cx <= x; ++cx) {
+        if (cx < 0) {
+          continue;
+        }
+        for (int cy = y; cy <= y + 1 && cy < sizeY; ++cy) {
+          // Stored as effective alpha (0 = untouched), i.e. 255 minus the combined transmittance
+          uint8_t& cell = cellAlpha_[static_cast<size_t>(cy) * sizeX + cx];
+          cell = static_cast<uint8_t>(255u - attenuate(255u - cell, alpha));
+        }
+      }
+    }
+  }
+  if (!anyCoverage) {
+    return;
+  }
+
+  // Pass 2: blend image rows; all displayScale rows of one grid row share the expanded alphas
+  rowAlpha_.resize(imageWidth);
+  const unsigned r = color.r;
+  const unsigned g = color.g;
+  const unsigned b = color.b;
+  for (uint16_t simY = 0; simY < sizeY; ++simY) {
+    const uint8_t* rowCells = cellAlpha_.data() + static_cast<size_t>(simY) * sizeX;
+    if (std::all_of(rowCells, rowCells + sizeX, [](uint8_t a) { return a == 0; })) {
+      continue;
+    }
+    for (uint16_t x = 0; x < sizeX; ++x) {
+      std::memset(rowAlpha_.data() + x * displayScale, rowCells[x], displayScale);
+    }
+
+    const int top = imageHeight - (simY + 1) * displayScale;
+    for (int py = top; py < top + displayScale; ++py) {
+      uint8_t* px = rgba + static_cast<size_t>(py) * imageWidth * 4;
+      const uint8_t* alpha = rowAlpha_.data();
+      for (int i = 0; i < imageWidth; ++i) {
+        const unsigned a = alpha[i];
+        const unsigned inverse = 255u - a;
+        px[4 * i + 0] = static_cast<uint8_t>((r * a + px[4 * i + 0] * inverse + 127u) / 255u);
+        px[4 * i + 1] = static_cast<uint8_t>((g * a + px[4 * i + 1] * inverse + 127u) / 255u);
+        px[4 * i + 2] = static_cast<uint8_t>((b * a + px[4 * i + 2] * inverse + 127u) / 255u);
+        px[4 * i + 3] = 255;
+      }
+    }
+  }
+}
+
+}  // namespace Render
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
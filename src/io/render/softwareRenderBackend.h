@@ -0,0 +1,125 @@
+#ifndef BIOSIM4_SRC_IO_RENDER_SOFTWARERENDERBACKEND_H_
+#define BIOSIM4_SRC_IO_RENDER_SOFTWARERENDERBACKEND_H_
+
+/**
+ * @file softwareRenderBackend.h
+ * @brief Pure-CPU rasterizer implementation of the rendering backend interface.
+ *
+ * Draws directly into a packed RGBA frame held in host memory. There is no
+ * window, GL context or graphics library involved, so it runs on headless
+ * compute nodes. Finished frames are streamed to a VideoEncoder.
+ */
+
+#include "../video/videoEncoder.h"
+#include "renderBackend.h"
+#include "signalBlitter.h"
+#include "staticBackground.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Render {
+
+/**
+ * @class SoftwareRenderBackend
+ * @brief Rasterizes rectangles and circles into an RGBA buffer on the CPU.
+ *
+ * Implementation Details:
+ * - One uint32_t per pixel, bytes in R, G, B, A order in memory (what the encoder expects)
+ * - Every primitive is reduced to horizontal spans; opaque spans are plain fills,
+ *   translucent spans use integer blending, and both loops auto-vectorize
+ * - Pheromone layers are blended in bulk by a SignalBlitter
+ * - The zone and barriers are rendered once per generation (StaticBackground);
+ *   beginFrame() defers its white fill so a cached frame is written only once
+ * - Circles use per-radius span tables (half-width per row), built once per radius;
+ *   the table for agentSize is built in init()
+ * - Geometry matches RaylibRenderBackend, including its Y-axis mapping
+ *
+ * Thread Safety:
+ * - NOT thread-safe - caller must synchronize access
+ */
+class SoftwareRenderBackend : public IRenderBackend {
+ public:
+  SoftwareRenderBackend();
+  ~SoftwareRenderBackend() override;
+
+  void init(uint16_t gridWidth, uint16_t gridHeight, uint16_t displayScale, uint16_t agentSize) override;
+  void setOutputDirectory(const std::string& outputPath) override;
+  void setEncoderSettings(const Video::EncoderSettings& settings) override;
+  void setWorldView(uint16_t worldWidth, uint16_t worldHeight, int16_t originX, int16_t originY) override;
+  void startNewGeneration() override;
+  void beginFrame(unsigned simStep, unsigned generation) override;
+  void drawChallengeZone(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration) override;
+  void drawRectangle(int16_t x1, int16_t y1, int16_t x2, int16_t y2, const Color& color) override;
+  void drawCircle(int16_t centerX, int16_t centerY, uint16_t radius, const Color& color) override;
+  void drawSignalLayer(const uint8_t* cells, uint16_t sizeX, uint16_t sizeY, const Color& color,
+                       const SignalAlphaLut& alphaLut) override;
+  void drawBackground(ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration,
+                      const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) override;
+  void drawBarriers(const std::vector<Coordinate>& barrierLocs, const Color& barrierColor) override;
+  void endFrame() override;
+  bool saveVideo(unsigned generation, const std::string& outputPath) override;
+  size_t getFrameCount() const override;
+
+  /** @brief Frame being drawn (or the last finished one), row-major from the top-left; valid after a draw call */
+  const uint32_t* pixels() const { return frame_.data(); }
+
+  /** @brief Pixel at (x, y) in image coordinates (0,0 = top-left); valid after a draw call */
+  Color pixel(int x, int y) const;
+
+  int width() const { return imageWidth_; }    ///< Image width in pixels
+  int height() const { return imageHeight_; }  ///< Image height in pixels
+
+ private:
+  /** @brief Apply the white fill deferred by beginFrame(), once per frame */
+  void clearFrame();
+
+  /** @brief Fill pixels [x1, x2) of row y, clipped to the image */
+  void fillSpan(int y, int x1, int x2, uint32_t packed, uint8_t alpha);
+
+  /** @brief Fill the pixel rectangle [x1, x2) x [y1, y2), clipped to the image */
+  void fillRect(int x1, int y1, int x2, int y2, const Color& color);
+
+  /** @brief Fill a disc using the span table for its radius */
+  void fillCircle(int centerX, int centerY, uint16_t radius, const Color& color);
+
+  /** @brief Half-width of each row of a disc, indexed by dy + radius */
+  const std::vector<int>& circleSpans(uint16_t radius);
+
+  /** @brief Simulation Y (0 = bottom) to image Y (0 = top) */
+  int toScreenY(int16_t simY) const;
+
+  uint16_t gridWidth_;     ///< Simulation grid width in cells
+  uint16_t gridHeight_;    ///< Simulation grid height in cells
+  uint16_t worldWidth_;    ///< Width of the whole world in cells (see setWorldView())
+  uint16_t worldHeight_;   ///< Height of the whole world in cells
+  int16_t originX_;        ///< World column of grid cell (0, 0)
+  int16_t originY_;        ///< World row of grid cell (0, 0)
+  uint16_t displayScale_;  ///< Pixel scaling factor (pixels per grid cell)
+  uint16_t agentSize_;     ///< Agent circle radius in pixels
+  int imageWidth_;         ///< Image width in pixels
+  int imageHeight_;        ///< Image height in pixels
+
+  std::vector<uint32_t> frame_;                ///< Packed RGBA pixels, row-major
+  std::vector<std::vector<int>> circleSpans_;  ///< Span tables by radius (empty = not built)
+  bool frameInProgress_;                       ///< True if beginFrame() called without endFrame()
+  bool frameCleared_;                          ///< False between beginFrame() and the first write of a frame
+  unsigned frameGeneration_;                   ///< Generation passed to beginFrame()
+  int frameBackground_;                        ///< Background slot copied into this frame, -1 if none
+  size_t frameCount_;                          ///< Frames finished since startNewGeneration()
+  std::string outputDir_;                      ///< Where a generation's video is opened ("" = no video)
+  Video::VideoEncoder encoder_;                ///< Streams the current generation's frames
+  SignalBlitter signalBlitter_;                ///< Bulk pheromone layer blending
+  StaticBackground background_;                ///< Cached zone and barriers of the current generation
+};
+
+}  // namespace Render
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_RENDER_SOFTWARERENDERBACKEND_H_
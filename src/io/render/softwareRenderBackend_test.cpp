@@ -0,0 +1,202 @@
+/**
+ * @file softwareRenderBackend_test.cpp
+ * @brief Pixel-level unit tests for the CPU rasterizer backend.
+ *
+ * No output directory is set, so frames are rasterized but never encoded and
+ * the tests need no files or codecs.
+ */
+
+#include "softwareRenderBackend.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace BioSim {
+
+using IO::Render::SoftwareRenderBackend;
+
+namespace {
+
+bool sameColor(const Color& a, const Color& b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+}  // namespace
+
+TEST(SoftwareRenderBackendTest, FrameStartsWhite) {
+  SoftwareRenderBackend backend;
+  backend.init(8, 6, 2, 1);
+  EXPECT_EQ(backend.width(), 16);
+  EXPECT_EQ(backend.height(), 12);
+
+  backend.beginFrame(0, 0);
+  backend.endFrame();
+  for (int y = 0; y < backend.height(); ++y) {
+    for (int x = 0; x < backend.width(); ++x) {
+      ASSERT_TRUE(sameColor(backend.pixel(x, y), Color(255, 255, 255, 255)));
+    }
+  }
+}
+
+TEST(SoftwareRenderBackendTest, OpaqueRectangleUsesFlippedY) {
+  SoftwareRenderBackend backend;
+  backend.init(8, 8, 2, 1);
+  backend.beginFrame(0, 0);
+
+  // Same mapping as the raylib backend: cell rectangle (1,1)-(2,2) covers image rows 10..11
+  backend.drawRectangle(1, 1, 2, 2, Color(10, 20, 30, 255));
+  EXPECT_TRUE(sameColor(backend.pixel(2, 10), Color(10, 20, 30, 255)));
+  EXPECT_TRUE(sameColor(backend.pixel(3, 11), Color(10, 20, 30, 255)));
+  EXPECT_TRUE(sameColor(backend.pixel(4, 10), Color(255, 255, 255, 255)));
+  EXPECT_TRUE(sameColor(backend.pixel(2, 12), Color(255, 255, 255, 255)));
+}
+
+TEST(SoftwareRenderBackendTest, TranslucentRectangleBlendsOverWhite) {
+  SoftwareRenderBackend backend;
+  backend.init(4, 4, 1, 1);
+  backend.beginFrame(0, 0);
+
+  backend.drawRectangle(0, 0, 4, 4, Color(0, 0, 255, 51));
+  const Color blended = backend.pixel(1, 1);
+  EXPECT_EQ(blended.r, 204);
+  EXPECT_EQ(blended.g, 204);
+  EXPECT_EQ(blended.b, 255);
+  EXPECT_EQ(blended.a, 255);
+}
+
+TEST(SoftwareRenderBackendTest, CircleMatchesDistanceTest) {
+  SoftwareRenderBackend backend;
+  backend.init(16, 16, 1, 3);
+  backend.beginFrame(0, 0);
+
+  const int radius = 3;
+  backend.drawCircle(8, 7, radius, Color(0, 0, 0, 255));
+  const int centerX = 8;
+  const int centerY = 16 - 8;
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < 16; ++x) {
+      const int dx = x - centerX;
+      const int dy = y - centerY;
+      const bool inside = dx * dx + dy * dy <= radius * radius;
+      EXPECT_EQ(backend.pixel(x, y).r == 0, inside) << "at " << x << "," << y;
+    }
+  }
+}
+
+TEST(SoftwareRenderBackendTest, DrawingIsClippedToImage) {
+  SoftwareRenderBackend backend;
+  backend.init(4, 4, 2, 1);
+  backend.beginFrame(0, 0);
+
+  backend.drawRectangle(-2, -2, 10, 10, Color(1, 2, 3, 255));
+  backend.drawCircle(0, 0, 5, Color(4, 5, 6, 128));
+  EXPECT_TRUE(sameColor(backend.pixel(7, 0), Color(1, 2, 3, 255)));
+  backend.endFrame();
+  EXPECT_EQ(backend.getFrameCount(), 1u);
+}
+
+TEST(SoftwareRenderBackendTest, RadioactiveWallSwitchesSides) {
+  SoftwareRenderBackend backend;
+  backend.init(20, 4, 1, 1);
+
+  backend.beginFrame(0, 0);
+  backend.drawChallengeZone(ChallengeZoneType::RADIOACTIVE_WALLS, 10, 100);
+  EXPECT_FALSE(sameColor(backend.pixel(0, 0), Color(255, 255, 255, 255)));
+  EXPECT_TRUE(sameColor(backend.pixel(19, 0), Color(255, 255, 255, 255)));
+  backend.endFrame();
+
+  backend.beginFrame(60, 0);
+  backend.drawChallengeZone(ChallengeZoneType::RADIOACTIVE_WALLS, 60, 100);
+  EXPECT_TRUE(sameColor(backend.pixel(0, 0), Color(255, 255, 255, 255)));
+  EXPECT_FALSE(sameColor(backend.pixel(19, 0), Color(255, 255, 255, 255)));
+  backend.endFrame();
+}
+
+TEST(SoftwareRenderBackendTest, SaveVideoWithoutOutputDirectoryFails) {
+  SoftwareRenderBackend backend;
+  backend.init(4, 4, 1, 1);
+  backend.beginFrame(0, 0);
+  backend.endFrame();
+  EXPECT_FALSE(backend.saveVideo(0, "unused"));
+
+  backend.startNewGeneration();
+  EXPECT_EQ(backend.getFrameCount(), 0u);
+}
+
+TEST(SoftwareRenderBackendTest, SignalLayerMatchesPerCellRectangles) {
+  constexpr uint16_t sizeX = 12;
+  constexpr uint16_t sizeY = 9;
+  std::vector<uint8_t> cells(sizeX * sizeY, 0);
+  for (size_t i = 0; i < cells.size(); i += 3) {
+    cells[i] = static_cast<uint8_t>(40 + 17 * i);
+  }
+  SignalAlphaLut lut{};
+  for (unsigned i = 0; i < 256; ++i) {
+    lut[i] = static_cast<uint8_t>(i / 2);
+  }
+
+  SoftwareRenderBackend bulk;
+  SoftwareRenderBackend reference;
+  bulk.init(sizeX, sizeY, 3, 1);
+  reference.init(sizeX, sizeY, 3, 1);
+  bulk.beginFrame(0, 0);
+  reference.beginFrame(0, 0);
+  bulk.drawSignalLayer(cells.data(), sizeX, sizeY, Color(0, 0, 255), lut);
+  reference.IRenderBackend::drawSignalLayer(cells.data(), sizeX, sizeY, Color(0, 0, 255), lut);
+
+  // Overlapping blends are combined before rounding, so allow off-by-a-few differences
+  for (int y = 0; y < bulk.height(); ++y) {
+    for (int x = 0; x < bulk.width(); ++x) {
+      const Color a = bulk.pixel(x, y);
+      const Color b = reference.pixel(x, y);
+      ASSERT_NEAR(a.r, b.r, 3) << "at " << x << "," << y;
+      ASSERT_NEAR(a.g, b.g, 3) << "at " << x << "," << y;
+      ASSERT_EQ(a.b, b.b) << "at " << x << "," << y;
+    }
+  }
+}
+
+TEST(SoftwareRenderBackendTest, CachedBackgroundMatchesDirectDrawing) {
+  constexpr uint16_t sizeX = 20;
+  constexpr uint16_t sizeY = 10;
+  const std::vector<Coordinate> barriers{Coordinate(3, 4), Coordinate(4, 4), Coordinate(5, 4), Coordinate(10, 0),
+                                         Coordinate(19, 9)};
+  const Color gray(0x88, 0x88, 0x88);
+  std::vector<uint8_t> cells(sizeX * sizeY, 200);
+  SignalAlphaLut lut{};
+  lut.fill(60);
+
+  SoftwareRenderBackend cached;
+  SoftwareRenderBackend direct;
+  cached.init(sizeX, sizeY, 2, 1);
+  direct.init(sizeX, sizeY, 2, 1);
+
+  // Steps 10 and 20 hit the first wall slot (the second reuses the cache), step 80 the other one
+  for (unsigned simStep : {10u, 20u, 80u, 90u}) {
+    cached.beginFrame(simStep, 3);
+    cached.drawBackground(ChallengeZoneType::RADIOACTIVE_WALLS, simStep, 100, barriers, gray);
+    cached.drawSignalLayer(cells.data(), sizeX, sizeY, Color(0, 0, 255), lut);
+    cached.drawBarriers(barriers, gray);
+
+    direct.beginFrame(simStep, 3);
+    direct.IRenderBackend::drawBackground(ChallengeZoneType::RADIOACTIVE_WALLS, simStep, 100, barriers, gray);
+    direct.drawSignalLayer(cells.data(), sizeX, sizeY, Color(0, 0, 255), lut);
+    direct.IRenderBackend::drawBarriers(barriers, gray);
+
+    for (int y = 0; y < cached.height(); ++y) {
+      for (int x = 0; x < cached.width(); ++x) {
+        ASSERT_TRUE(sameColor(cached.pixel(x, y), direct.pixel(x, y))) << "step " << simStep << " at " << x << "," << y;
+      }
+    }
+    cached.endFrame();
+    direct.endFrame();
+  }
+}
+
+TEST(RenderBackendFactoryTest, SelectsByName) {
+  EXPECT_NE(createRenderBackend("software"), nullptr);
+  EXPECT_EQ(createRenderBackend("opengl"), nullptr);
+}
+
+}  // namespace BioSim
@@ -0,0 +1,109 @@
+/**
+ * @file staticBackground.cpp
+ * @brief Implementation of the per-generation static background cache
+ */
+
+#include "staticBackground.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Render {
+
+StaticBackground::StaticBackground()
+    : valid_{false, false},
+      keyed_(false),
+      generation_(0),
+      zoneType_(ChallengeZoneType::NONE),
+      barrierCount_(0),
+      imageWidth_(0),
+      imageHeight_(0) {}
+
+unsigned StaticBackground::select(unsigned generation, ChallengeZoneType zoneType, unsigned simStep,
+                                  unsigned stepsPerGeneration, const std::vector<Coordinate>& barrierLocs,
+                                  int imageWidth, int imageHeight, uint16_t displayScale) {
+  if (!keyed_ || generation != generation_ || zoneType != zoneType_ || barrierLocs.size() != barrierCount_ ||
+      imageWidth != imageWidth_ || imageHeight != imageHeight_) {
+    valid_ = {false, false};
+    keyed_ = true;
+    generation_ = generation;
+    zoneType_ = zoneType;
+    barrierCount_ = barrierLocs.size();
+    imageWidth_ = imageWidth;
+    imageHeight_ = imageHeight;
+    buildBarrierSpans(barrierLocs, displayScale);
+  }
+  return zoneType == ChallengeZoneType::RADIOACTIVE_WALLS && simStep >= stepsPerGeneration / 2 ? 1 : 0;
+}
+
+void StaticBackground::store(unsigned slot, const uint8_t* rgba) {
+  const size_t bytes = static_cast<size_t>(imageWidth_) * imageHeight_ * 4;
+  images_[slot].assign(rgba, rgba + bytes);
+  valid_[slot] = true;
+}
+
+void StaticBackground::copyTo(unsigned slot, uint8_t* rgba) const {
+  std::memcpy(rgba, images_[slot].data(), images_[slot].size());
+}
+
+void StaticBackground::fillBarriers(uint8_t* rgba, const Color& color) const {
+  const uint8_t pixel[4] = {color.r, color.g, color.b, 255};
+  for (const PixelSpan& span : barrierSpans_) {
+    uint8_t* row = rgba + (static_cast<size_t>(span.y) * imageWidth_ + span.x1) * 4;
+    for (int x = span.x1; x < span.x2; ++x, row += 4) {
+      std::memcpy(row, pixel, sizeof(pixel));
+    }
+  }
+}
+
+void StaticBackground::restoreBarriers(unsigned slot, uint8_t* rgba) const {
+  const uint8_t* image = images_[slot].data();
+  for (const PixelSpan& span : barrierSpans_) {
+    const size_t offset = (static_cast<size_t>(span.y) * imageWidth_ + span.x1) * 4;
+    std::memcpy(rgba + offset, image + offset, static_cast<size_t>(span.x2 - span.x1) * 4);
+  }
+}
+
+void StaticBackground::invalidate() {
+  valid_ = {false, false};
+  keyed_ = false;
+}
+
+void StaticBackground::buildBarrierSpans(const std::vector<Coordinate>& barrierLocs, uint16_t displayScale) {
+  barrierSpans_.clear();
+  barrierSpans_.reserve(barrierLocs.size() * displayScale);
+
+  // Same pixels as drawRectangle(x, y, x + 1, y + 1): columns of cell x, image rows of simulation row y + 1
+  for (const auto& loc : barrierLocs) {
+    const int x1 = std::max(loc.x * displayScale, 0);
+    const int x2 = std::min((loc.x + 1) * displayScale, imageWidth_);
+    const int top = imageHeight_ - (loc.y + 2) * displayScale;
+    for (int y = std::max(top, 0); y < std::min(top + displayScale, imageHeight_); ++y) {
+      if (x1 < x2) {
+        barrierSpans_.push_back(PixelSpan{y, x1, x2});
+      }
+    }
+  }
+
+  // Merge touching runs so that walls become one copy per row
+  std::sort(barrierSpans_.begin(), barrierSpans_.end(), [](const PixelSpan& a, const PixelSpan& b) {
+    return a.y != b.y ? a.y < b.y : a.x1 < b.x1;
+  });
+  size_t merged = 0;
+  for (const PixelSpan& span : barrierSpans_) {
+    if (merged > 0 && barrierSpans_[merged - 1].y == span.y && barrierSpans_[merged - 1].x2 >= span.x1) {
+      barrierSpans_[merged - 1].x2 = std::max(barrierSpans_[merged - 1].x2, span.x2);
+    } else {
+      barrierSpans_[merged++] = span;
+    }
+  }
+  barrierSpans_.resize(merged);
+}
+
+}  // namespace Render
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
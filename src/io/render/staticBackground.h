@@ -0,0 +1,102 @@
+#ifndef BIOSIM4_SRC_IO_RENDER_STATICBACKGROUND_H_
+#define BIOSIM4_SRC_IO_RENDER_STATICBACKGROUND_H_
+
+/**
+ * @file staticBackground.h
+ * @brief Per-generation cache of the static frame background (challenge zone plus barriers).
+ *
+ * Used by backends that can address their frame as packed RGBA8 pixels.
+ */
+
+#include "renderBackend.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Render {
+
+/**
+ * @class StaticBackground
+ * @brief Holds the rendered background of a generation and the barrier pixel runs.
+ *
+ * A background is everything a frame shows before the dynamic layers: white,
+ * the challenge zone and the barriers. It only changes with the generation,
+ * except RADIOACTIVE_WALLS, whose wall switches sides halfway through; that
+ * is why there are two slots. The backend renders a slot the first time it is
+ * needed and copies it into later frames with one memcpy.
+ *
+ * Barrier pixels are also kept as merged horizontal runs, so that barriers can
+ * be restored on top of the pheromone layers with a few small copies instead
+ * of being redrawn.
+ *
+ * @par Usage Pattern
+ * 1. select() at the start of the frame
+ * 2. If !has(slot): draw white + zone, fillBarriers(), store(); else copyTo()
+ * 3. After the pheromone layers: restoreBarriers()
+ */
+class StaticBackground {
+ public:
+  StaticBackground();
+
+  /**
+   * @brief Pick the slot for a frame, dropping cached slots if the static scene changed
+   *
+   * The cache is keyed on generation, zone type, barrier count and image size.
+   *
+   * @return Slot index (1 for the second half of a RADIOACTIVE_WALLS generation, else 0)
+   */
+  unsigned select(unsigned generation, ChallengeZoneType zoneType, unsigned simStep, unsigned stepsPerGeneration,
+                  const std::vector<Coordinate>& barrierLocs, int imageWidth, int imageHeight, uint16_t displayScale);
+
+  /** @brief True if the slot was stored since the last change of scene */
+  bool has(unsigned slot) const { return valid_[slot]; }
+
+  /** @brief Cache the finished background of a slot */
+  void store(unsigned slot, const uint8_t* rgba);
+
+  /** @brief Copy a stored slot into a frame */
+  void copyTo(unsigned slot, uint8_t* rgba) const;
+
+  /** @brief Paint the barrier runs in a solid color (used while building a slot) */
+  void fillBarriers(uint8_t* rgba, const Color& color) const;
+
+  /** @brief Copy the barrier runs of a stored slot back into a frame */
+  void restoreBarriers(unsigned slot, uint8_t* rgba) const;
+
+  /** @brief True if select() was called for this barrier list (same size) */
+  bool coversBarriers(const std::vector<Coordinate>& barrierLocs) const { return barrierCount_ == barrierLocs.size(); }
+
+  /** @brief Drop everything (e.g. at the start of a generation) */
+  void invalidate();
+
+ private:
+  /** @brief A run of pixels [x1, x2) in image row y */
+  struct PixelSpan {
+    int y;
+    int x1;
+    int x2;
+  };
+
+  void buildBarrierSpans(const std::vector<Coordinate>& barrierLocs, uint16_t displayScale);
+
+  std::array<std::vector<uint8_t>, 2> images_;  ///< Cached RGBA8 backgrounds by slot
+  std::array<bool, 2> valid_;                   ///< Slot stored for the current scene
+  std::vector<PixelSpan> barrierSpans_;         ///< Barrier pixels, merged per row
+  bool keyed_;                                  ///< False until the first select() after invalidate()
+  unsigned generation_;                         ///< Scene key: generation
+  ChallengeZoneType zoneType_;                  ///< Scene key: challenge zone
+  size_t barrierCount_;                         ///< Scene key: number of barrier cells
+  int imageWidth_;                              ///< Scene key: image width in pixels
+  int imageHeight_;                             ///< Scene key: image height in pixels
+};
+
+}  // namespace Render
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_RENDER_STATICBACKGROUND_H_
@@ -0,0 +1,105 @@
+#ifndef BIOSIM4_SRC_IO_TRACE_TRACEFORMAT_H_
+#define BIOSIM4_SRC_IO_TRACE_TRACEFORMAT_H_
+
+/**
+ * @file traceFormat.h
+ * @brief On-disk layout of generation trace files (.b4t)
+ *
+ * A trace records what a generation's video would show, without rendering it:
+ * agent positions and colors per captured step, the barrier mask, and
+ * optionally the pheromone layers quantized to 4 bits. biosim4-render turns
+ * traces into videos later.
+ *
+ * File layout (host byte order, little-endian on all supported targets):
+ * ```
+ * TraceHeader                      64 bytes
+ * barrier mask                     ceil(sizeX * sizeY / 8) bytes, bit (x * sizeY + y)
+ * frame 0 .. frameCount-1          TraceFrameHeader + agent payload + signal payload
+ * frame index                      frameCount x uint64_t file offset of each frame
+ * ```
+ *
+ * Agent payload:
+ * - KEY frames: agentCount color bytes, then agentCount (int16 x, int16 y)
+ * - DELTA frames: one nibble per agent (low nibble first), (dx + 1) * 3 + (dy + 1)
+ *   against the previous frame, or DELTA_ESCAPE; then uint32 escape count and
+ *   (uint32 ordinal, int16 x, int16 y) per escaped agent
+ *
+ * A frame is a KEY frame when it is the first one, when the number of live
+ * agents changed, and every KEYFRAME_INTERVAL frames so readers can seek.
+ *
+ * Signal payload, per stored layer: uint32 byte count, then the layer's cells
+ * (column-major, 4 bits each, low nibble first) with runs of zero bytes
+ * written as (0x00, run length 1..255).
+ */
+
+#include <cstdint>
+#include <string>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Trace {
+
+constexpr char TRACE_MAGIC[8] = {'B', '4', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr uint32_t TRACE_VERSION = 1;
+constexpr uint32_t KEYFRAME_INTERVAL = 64;  ///< Longest run of DELTA frames
+constexpr uint8_t DELTA_ESCAPE = 0x0f;      ///< Nibble for a move of more than one cell
+
+/** @brief Kind of a frame record */
+enum class FrameKind : uint8_t {
+  KEY = 0,    ///< Absolute positions and colors
+  DELTA = 1,  ///< Moves relative to the previous frame; colors unchanged
+};
+
+/**
+ * @struct TraceHeader
+ * @brief Fixed-size file header; frameCount and indexOffset are patched when the trace is closed
+ */
+struct TraceHeader {
+  char magic[8];                ///< TRACE_MAGIC
+  uint32_t version;             ///< TRACE_VERSION
+  uint32_t headerBytes;         ///< sizeof(TraceHeader)
+  uint32_t generation;          ///< Recorded generation
+  uint32_t challenge;           ///< Challenge ID (selects the zone overlay)
+  uint32_t barrierType;         ///< Barrier type ID
+  uint32_t stepsPerGeneration;  ///< For the radioactive wall switch
+  uint16_t sizeX;               ///< Grid width in cells
+  uint16_t sizeY;               ///< Grid height in cells
+  uint16_t signalLayers;        ///< Layers stored per frame (0 = none)
+  uint16_t displayScale;        ///< displayScale of the recording run (render default)
+  uint16_t agentSize;           ///< agentSize of the recording run (render default)
+  uint16_t flags;               ///< Reserved, 0
+  uint32_t frameCount;          ///< Frames in the file (0 until closed)
+  uint64_t indexOffset;         ///< Offset of the frame index (0 = trace not finished)
+  uint32_t population;          ///< Population of the run
+  uint32_t reserved;            ///< Reserved, 0
+};
+static_assert(sizeof(TraceHeader) == 64, "TraceHeader layout is part of the file format");
+
+/**
+ * @struct TraceFrameHeader
+ * @brief Header of one frame record
+ */
+struct TraceFrameHeader {
+  uint32_t simStep;      ///< Step the frame was captured at
+  uint32_t agentCount;   ///< Live agents in the frame
+  uint32_t agentBytes;   ///< Size of the agent payload
+  uint32_t signalBytes;  ///< Size of the signal payload
+  uint8_t kind;          ///< FrameKind
+  uint8_t reserved[3];   ///< Reserved, 0
+};
+static_assert(sizeof(TraceFrameHeader) == 20, "TraceFrameHeader layout is part of the file format");
+
+/**
+ * @brief Path of a generation's trace: `<directory>/gen-NNNNNN.b4t`
+ * @param directory Output directory (a trailing slash is optional)
+ * @param generation Generation number (zero-padded to six digits)
+ */
+std::string generationTracePath(const std::string& directory, unsigned generation);
+
+}  // namespace Trace
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_TRACE_TRACEFORMAT_H_
@@ -0,0 +1,251 @@
+/**
+ * @file traceReader.cpp
+ * @brief Implementation of the memory-mapped trace reader
+ */
+
+#include "traceReader.h"
+
+#include "../../utils/logger.h"
+#include "../video/imageWriter.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Trace {
+
+using Utils::Logger;
+
+namespace {
+
+template <typename T>
+T load(const uint8_t* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+TraceReader::~TraceReader() {
+  close();
+}
+
+bool TraceReader::open(const std::string& path) {
+  close();
+  path_ = path;
+
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    Logger::error("Could not open trace file: {}", path);
+    return false;
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(TraceHeader)) {
+    Logger::error("Trace {} is too short", path);
+    ::close(fd);
+    return false;
+  }
+  size_ = static_cast<size_t>(info.st_size);
+  void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    Logger::error("Could not map trace {}", path);
+    size_ = 0;
+    return false;
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+  ::madvise(mapping, size_, MADV_SEQUENTIAL);
+
+  std::memcpy(&header_, data_, sizeof(header_));
+  const size_t maskBytes = (static_cast<size_t>(header_.sizeX) * header_.sizeY + 7) / 8;
+  const bool valid = std::memcmp(header_.magic, TRACE_MAGIC, sizeof(header_.magic)) == 0 &&
+                     header_.version == TRACE_VERSION && header_.headerBytes == sizeof(TraceHeader) &&
+                     header_.sizeX > 0 && header_.sizeY > 0 && sizeof(TraceHeader) + maskBytes <= size_ &&
+                     header_.indexOffset >= sizeof(TraceHeader) + maskBytes && header_.indexOffset <= size_ &&
+                     (size_ - header_.indexOffset) / sizeof(uint64_t) >= header_.frameCount;
+  if (!valid) {
+    Logger::error("{} is not a finished trace (version {})", path, TRACE_VERSION);
+    close();
+    return false;
+  }
+
+  barriers_.clear();
+  const uint8_t* mask = data_ + sizeof(TraceHeader);
+  for (int16_t x = 0; x < header_.sizeX; ++x) {
+    for (int16_t y = 0; y < header_.sizeY; ++y) {
+      const size_t bit = static_cast<size_t>(x) * header_.sizeY + y;
+      if (mask[bit / 8] & (1u << (bit % 8))) {
+        barriers_.push_back(Coordinate{x, y});
+      }
+    }
+  }
+  nextFrame_ = 0;
+  return true;
+}
+
+void TraceReader::close() {
+  if (data_) {
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  header_ = TraceHeader{};
+  positions_.clear();
+  colors_.clear();
+  nextFrame_ = 0;
+}
+
+bool TraceReader::readFrame(size_t index, Video::ImageFrameData& frame) {
+  if (!data_ || index >= header_.frameCount) {
+    return false;
+  }
+
+  // Frames decode in order from a KEY frame; restart from the closest one before the target if needed
+  if (index < nextFrame_ || index >= nextFrame_ + KEYFRAME_INTERVAL) {
+    size_t key = index;
+    while (key > 0) {
+      const uint64_t offset = frameOffset(key);
+      if (offset + sizeof(TraceFrameHeader) <= header_.indexOffset &&
+          data_[offset + offsetof(TraceFrameHeader, kind)] == static_cast<uint8_t>(FrameKind::KEY)) {
+        break;
+      }
+      --key;
+    }
+    nextFrame_ = key;
+  }
+
+  while (nextFrame_ <= index) {
+    if (!decodeFrame(nextFrame_, frame)) {
+      Logger::error("Trace {} is corrupt at frame {}", path_, nextFrame_);
+      nextFrame_ = 0;
+      return false;
+    }
+    ++nextFrame_;
+  }
+
+  frame.generation = header_.generation;
+  frame.challenge = header_.challenge;
+  frame.barrierType = header_.barrierType;
+  frame.barrierLocs = barriers_;
+  frame.indivLocs.assign(positions_.begin(), positions_.end());
+  frame.indivColors.assign(colors_.begin(), colors_.end());
+  return true;
+}
+
+uint64_t TraceReader::frameOffset(size_t index) const {
+  return load<uint64_t>(data_ + header_.indexOffset + index * sizeof(uint64_t));
+}
+
+bool TraceReader::decodeFrame(size_t index, Video::ImageFrameData& frame) {
+  const uint64_t offset = frameOffset(index);
+  if (offset < sizeof(TraceHeader) || offset + sizeof(TraceFrameHeader) > header_.indexOffset) {
+    return false;
+  }
+  TraceFrameHeader record;
+  std::memcpy(&record, data_ + offset, sizeof(record));
+  const uint64_t payload = offset + sizeof(TraceFrameHeader);
+  if (payload + record.agentBytes + record.signalBytes > header_.indexOffset) {
+    return false;
+  }
+  const uint8_t* agents = data_ + payload;
+  const size_t count = record.agentCount;
+
+  if (record.kind == static_cast<uint8_t>(FrameKind::KEY)) {
+    if (record.agentBytes != count * (1 + 2 * sizeof(int16_t))) {
+      return false;
+    }
+    colors_.assign(agents, agents + count);
+    positions_.resize(count);
+    const uint8_t* xy = agents + count;
+    for (size_t i = 0; i < count; ++i, xy += 2 * sizeof(int16_t)) {
+      positions_[i] = Coordinate{load<int16_t>(xy), load<int16_t>(xy + sizeof(int16_t))};
+    }
+  } else if (record.kind == static_cast<uint8_t>(FrameKind::DELTA)) {
+    const size_t nibbleBytes = (count + 1) / 2;
+    if (count != positions_.size() || record.agentBytes < nibbleBytes + sizeof(uint32_t)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      const uint8_t code = (agents[i / 2] >> (i % 2 == 0 ? 0 : 4)) & 0x0f;
+      if (code < 9) {
+        positions_[i].x += code / 3 - 1;
+        positions_[i].y += code % 3 - 1;
+      } else if (code != DELTA_ESCAPE) {
+        return false;
+      }
+    }
+    const uint32_t escapes = load<uint32_t>(agents + nibbleBytes);
+    constexpr size_t ESCAPE_BYTES = sizeof(uint32_t) + 2 * sizeof(int16_t);
+    if (record.agentBytes != nibbleBytes + sizeof(uint32_t) + size_t(escapes) * ESCAPE_BYTES) {
+      return false;
+    }
+    const uint8_t* entry = agents + nibbleBytes + sizeof(uint32_t);
+    for (uint32_t e = 0; e < escapes; ++e, entry += ESCAPE_BYTES) {
+      const uint32_t ordinal = load<uint32_t>(entry);
+      if (ordinal >= count) {
+        return false;
+      }
+      positions_[ordinal] = Coordinate{load<int16_t>(entry + 4), load<int16_t>(entry + 6)};
+    }
+  } else {
+    return false;
+  }
+
+  frame.simStep = record.simStep;
+  return decodeSignals(agents + record.agentBytes, record.signalBytes, frame);
+}
+
+bool TraceReader::decodeSignals(const uint8_t* data, size_t bytes, Video::ImageFrameData& frame) {
+  if (frame.sizeX != header_.sizeX || frame.sizeY != header_.sizeY || frame.signalLayerCount != header_.signalLayers) {
+    frame.allocate(header_.signalLayers, header_.sizeX, header_.sizeY, header_.population);
+  }
+
+  const size_t cells = static_cast<size_t>(header_.sizeX) * header_.sizeY;
+  const uint8_t* end = data + bytes;
+  for (unsigned layer = 0; layer < header_.signalLayers; ++layer) {
+    if (end - data < static_cast<ptrdiff_t>(sizeof(uint32_t))) {
+      return false;
+    }
+    const uint32_t layerBytes = load<uint32_t>(data);
+    data += sizeof(uint32_t);
+    if (end - data < static_cast<ptrdiff_t>(layerBytes)) {
+      return false;
+    }
+
+    // Expand the zero runs back into nibble-packed cells
+    packed_.clear();
+    for (const uint8_t* in = data; in < data + layerBytes; ++in) {
+      if (*in != 0) {
+        packed_.push_back(*in);
+      } else if (in + 1 < data + layerBytes) {
+        packed_.insert(packed_.end(), *++in, 0);
+      } else {
+        return false;
+      }
+    }
+    if (packed_.size() != (cells + 1) / 2) {
+      return false;
+    }
+    data += layerBytes;
+
+    uint8_t* values = frame.signalData.data() + layer * cells;
+    for (size_t i = 0; i < cells; ++i) {
+      const uint8_t level = (packed_[i / 2] >> (i % 2 == 0 ? 0 : 4)) & 0x0f;
+      values[i] = static_cast<uint8_t>(level * 17);  // 0x0 -> 0, 0xf -> 255
+    }
+  }
+  return data == end;
+}
+
+}  // namespace Trace
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
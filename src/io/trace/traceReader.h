@@ -0,0 +1,87 @@
+#ifndef BIOSIM4_SRC_IO_TRACE_TRACEREADER_H_
+#define BIOSIM4_SRC_IO_TRACE_TRACEREADER_H_
+
+/**
+ * @file traceReader.h
+ * @brief Memory-mapped reader that decodes trace files back into frames
+ */
+
+#include "../../types/basicTypes.h"
+#include "traceFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+struct ImageFrameData;
+}
+namespace Trace {
+
+/**
+ * @class TraceReader
+ * @brief Decodes the frames of a finished trace (see traceFormat.h)
+ *
+ * The file is mapped read-only, so opening is cheap and several readers
+ * (one per rendering thread) can share the page cache. Reading frames in
+ * order decodes each one once; seeking backwards or far ahead restarts
+ * from the nearest KEY frame. All offsets and sizes are checked against the
+ * mapping, and corrupt files are reported, never read out of bounds.
+ */
+class TraceReader {
+ public:
+  TraceReader() = default;
+  ~TraceReader();
+
+  TraceReader(const TraceReader&) = delete;
+  TraceReader& operator=(const TraceReader&) = delete;
+
+  /**
+   * @brief Map a trace and validate its header and frame index
+   * @return false (after logging) for unreadable, unfinished or corrupt files
+   */
+  bool open(const std::string& path);
+
+  /** @brief Unmap the file */
+  void close();
+
+  /** @brief Header of the open trace */
+  const TraceHeader& header() const { return header_; }
+
+  /** @brief Number of frames in the open trace */
+  size_t frameCount() const { return header_.frameCount; }
+
+  /**
+   * @brief Decode one frame into a snapshot that saveOneFrameImmed()/renderFrame() can draw
+   * @param index Frame number (0 to frameCount()-1)
+   * @param frame Destination; reuses its capacity
+   * @return false if the index is out of range or the frame is corrupt
+   */
+  bool readFrame(size_t index, Video::ImageFrameData& frame);
+
+ private:
+  bool decodeFrame(size_t index, Video::ImageFrameData& frame);
+  bool decodeSignals(const uint8_t* data, size_t bytes, Video::ImageFrameData& frame);
+  uint64_t frameOffset(size_t index) const;
+
+  const uint8_t* data_ = nullptr;      ///< Mapped file
+  size_t size_ = 0;                    ///< Mapped bytes
+  std::string path_;                   ///< For error messages
+  TraceHeader header_{};               ///< Validated copy of the header
+  std::vector<Coordinate> barriers_;   ///< Decoded barrier mask
+  std::vector<Coordinate> positions_;  ///< Agent positions after the last decoded frame
+  std::vector<uint8_t> colors_;        ///< Agent colors since the last KEY frame
+  size_t nextFrame_ = 0;               ///< Frame that can be decoded without seeking
+  std::vector<uint8_t> packed_;        ///< Scratch: one nibble-packed layer
+};
+
+}  // namespace Trace
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_TRACE_TRACEREADER_H_
@@ -0,0 +1,237 @@
+/**
+ * @file traceWriter.cpp
+ * @brief Implementation of the delta-encoding trace writer
+ */
+
+#include "traceWriter.h"
+
+#include "../../utils/logger.h"
+#include "../video/imageWriter.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Trace {
+
+using Utils::Logger;
+
+namespace {
+
+constexpr size_t FILE_BUFFER_BYTES = 1 << 20;
+
+template <typename T>
+void append(std::vector<uint8_t>& out, const T& value) {
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+/** @brief Append bytes with runs of zeros replaced by (0x00, run length) */
+void appendZeroRunLength(std::vector<uint8_t>& out, const std::vector<uint8_t>& bytes) {
+  size_t i = 0;
+  while (i < bytes.size()) {
+    if (bytes[i] != 0) {
+      out.push_back(bytes[i++]);
+      continue;
+    }
+    size_t run = 1;
+    while (i + run < bytes.size() && bytes[i + run] == 0 && run < 255) {
+      ++run;
+    }
+    out.push_back(0);
+    out.push_back(static_cast<uint8_t>(run));
+    i += run;
+  }
+}
+
+}  // namespace
+
+std::string generationTracePath(const std::string& directory, unsigned generation) {
+  const char* separator = !directory.empty() && directory.back() == '/' ? "" : "/";
+  return fmt::format("{}{}gen-{:06}.b4t", directory, separator, generation);
+}
+
+TraceWriter::~TraceWriter() {
+  abort();
+}
+
+bool TraceWriter::open(const std::string& path, const Video::ImageFrameData& first, const TraceInfo& info) {
+  if (isOpen()) {
+    abort();
+  }
+  path_ = path;
+  offset_ = 0;
+  offsets_.clear();
+  previous_.clear();
+  framesSinceKey_ = 0;
+
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    Logger::error("Could not open trace file: {}", path);
+    return false;
+  }
+  fileBuffer_.resize(FILE_BUFFER_BYTES);
+  std::setvbuf(file_, fileBuffer_.data(), _IOFBF, fileBuffer_.size());
+
+  header_ = TraceHeader{};
+  std::memcpy(header_.magic, TRACE_MAGIC, sizeof(header_.magic));
+  header_.version = TRACE_VERSION;
+  header_.headerBytes = sizeof(TraceHeader);
+  header_.generation = first.generation;
+  header_.challenge = first.challenge;
+  header_.barrierType = first.barrierType;
+  header_.stepsPerGeneration = info.stepsPerGeneration;
+  header_.sizeX = first.sizeX;
+  header_.sizeY = first.sizeY;
+  header_.signalLayers = info.signals ? static_cast<uint16_t>(first.signalLayerCount) : 0;
+  header_.displayScale = info.displayScale;
+  header_.agentSize = info.agentSize;
+  header_.population = info.population;
+
+  // Barriers do not change within a generation, so they are stored once
+  std::vector<uint8_t> mask((static_cast<size_t>(first.sizeX) * first.sizeY + 7) / 8, 0);
+  for (const auto& loc : first.barrierLocs) {
+    const size_t bit = static_cast<size_t>(loc.x) * first.sizeY + loc.y;
+    mask[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+  }
+
+  if (!write(&header_, sizeof(header_)) || !write(mask.data(), mask.size())) {
+    abort();
+    return false;
+  }
+  return true;
+}
+
+bool TraceWriter::writeFrame(const Video::ImageFrameData& frame) {
+  if (!isOpen()) {
+    return false;
+  }
+
+  const bool key = offsets_.empty() || frame.indivLocs.size() != previous_.size() ||
+                   framesSinceKey_ + 1 >= KEYFRAME_INTERVAL;
+  const FrameKind kind = key ? FrameKind::KEY : FrameKind::DELTA;
+  encodeAgents(frame, kind);
+  encodeSignals(frame);
+
+  TraceFrameHeader record{};
+  record.simStep = frame.simStep;
+  record.agentCount = static_cast<uint32_t>(frame.indivLocs.size());
+  record.agentBytes = static_cast<uint32_t>(agentPayload_.size());
+  record.signalBytes = static_cast<uint32_t>(signalPayload_.size());
+  record.kind = static_cast<uint8_t>(kind);
+
+  offsets_.push_back(offset_);
+  if (!write(&record, sizeof(record)) || !write(agentPayload_.data(), agentPayload_.size()) ||
+      !write(signalPayload_.data(), signalPayload_.size())) {
+    return false;
+  }
+
+  previous_.assign(frame.indivLocs.begin(), frame.indivLocs.end());
+  framesSinceKey_ = key ? 0 : framesSinceKey_ + 1;
+  return true;
+}
+
+bool TraceWriter::close() {
+  if (!isOpen()) {
+    return false;
+  }
+
+  // Frame index, then patch the header now that the counts are known
+  header_.frameCount = static_cast<uint32_t>(offsets_.size());
+  header_.indexOffset = offset_;
+  bool ok = write(offsets_.data(), offsets_.size() * sizeof(uint64_t));
+  ok = ok && std::fseek(file_, 0, SEEK_SET) == 0 && std::fwrite(&header_, sizeof(header_), 1, file_) == 1;
+  ok = std::fclose(file_) == 0 && ok;
+  file_ = nullptr;
+  if (!ok) {
+    Logger::error("Could not finalize trace {}", path_);
+  }
+  return ok;
+}
+
+void TraceWriter::abort() {
+  if (!isOpen()) {
+    return;
+  }
+  std::fclose(file_);
+  file_ = nullptr;
+  std::remove(path_.c_str());
+  Logger::info("Discarded partial trace {} ({} frames)", path_, offsets_.size());
+}
+
+bool TraceWriter::write(const void* data, size_t bytes) {
+  if (bytes > 0 && std::fwrite(data, 1, bytes, file_) != bytes) {
+    Logger::error("Write to trace {} failed", path_);
+    return false;
+  }
+  offset_ += bytes;
+  return true;
+}
+
+void TraceWriter::encodeAgents(const Video::ImageFrameData& frame, FrameKind kind) {
+  agentPayload_.clear();
+  const size_t count = frame.indivLocs.size();
+
+  if (kind == FrameKind::KEY) {
+    agentPayload_.insert(agentPayload_.end(), frame.indivColors.begin(), frame.indivColors.begin() + count);
+    for (const auto& loc : frame.indivLocs) {
+      append(agentPayload_, loc.x);
+      append(agentPayload_, loc.y);
+    }
+    return;
+  }
+
+  // One nibble per agent; moves of more than one cell are escaped and listed after the nibbles
+  agentPayload_.assign((count + 1) / 2, 0);
+  uint32_t escapes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const int dx = frame.indivLocs[i].x - previous_[i].x;
+    const int dy = frame.indivLocs[i].y - previous_[i].y;
+    uint8_t code = DELTA_ESCAPE;
+    if (std::abs(dx) <= 1 && std::abs(dy) <= 1) {
+      code = static_cast<uint8_t>((dx + 1) * 3 + (dy + 1));
+    } else {
+      ++escapes;
+    }
+    agentPayload_[i / 2] |= static_cast<uint8_t>(i % 2 == 0 ? code : code << 4);
+  }
+  append(agentPayload_, escapes);
+  for (size_t i = 0; i < count && escapes > 0; ++i) {
+    const int dx = frame.indivLocs[i].x - previous_[i].x;
+    const int dy = frame.indivLocs[i].y - previous_[i].y;
+    if (std::abs(dx) > 1 || std::abs(dy) > 1) {
+      append(agentPayload_, static_cast<uint32_t>(i));
+      append(agentPayload_, frame.indivLocs[i].x);
+      append(agentPayload_, frame.indivLocs[i].y);
+    }
+  }
+}
+
+void TraceWriter::encodeSignals(const Video::ImageFrameData& frame) {
+  signalPayload_.clear();
+  const size_t cells = static_cast<size_t>(frame.sizeX) * frame.sizeY;
+  for (unsigned layer = 0; layer < header_.signalLayers; ++layer) {
+    const uint8_t* values = frame.signalLayer(layer);
+    packed_.assign((cells + 1) / 2, 0);
+    for (size_t i = 0; i < cells; ++i) {
+      const uint8_t level = values[i] >> 4;
+      packed_[i / 2] |= static_cast<uint8_t>(i % 2 == 0 ? level : level << 4);
+    }
+
+    const size_t sizeAt = signalPayload_.size();
+    append(signalPayload_, uint32_t{0});
+    appendZeroRunLength(signalPayload_, packed_);
+    const uint32_t bytes = static_cast<uint32_t>(signalPayload_.size() - sizeAt - sizeof(uint32_t));
+    std::memcpy(signalPayload_.data() + sizeAt, &bytes, sizeof(bytes));
+  }
+}
+
+}  // namespace Trace
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
@@ -0,0 +1,120 @@
+#ifndef BIOSIM4_SRC_IO_TRACE_TRACEWRITER_H_
+#define BIOSIM4_SRC_IO_TRACE_TRACEWRITER_H_
+
+/**
+ * @file traceWriter.h
+ * @brief Streams captured frames of one generation into a compact trace file
+ */
+
+#include "../../types/basicTypes.h"
+#include "traceFormat.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+struct ImageFrameData;
+}
+namespace Trace {
+
+/**
+ * @struct TraceInfo
+ * @brief Run settings stored in the trace header
+ */
+struct TraceInfo {
+  unsigned stepsPerGeneration = 0;  ///< Steps per generation
+  unsigned population = 0;          ///< Population of the run
+  uint16_t displayScale = 1;        ///< Default render scale
+  uint16_t agentSize = 1;           ///< Default agent radius in pixels
+  bool signals = false;             ///< Store quantized signal layers
+};
+
+/**
+ * @class TraceWriter
+ * @brief Writes one generation's frames as a delta-encoded trace (see traceFormat.h)
+ *
+ * Agents move at most one cell per step, so a DELTA frame usually costs half
+ * a byte per agent. Output goes through a large stdio buffer, so a recording
+ * run only pays sequential writes. Errors are logged and reported through
+ * return values; nothing throws.
+ *
+ * @par Usage Pattern
+ * 1. open() with the first frame of the generation (records the barrier mask)
+ * 2. writeFrame() for every captured frame, including the first
+ * 3. close() to write the frame index, or abort() to delete the partial file
+ */
+class TraceWriter {
+ public:
+  TraceWriter() = default;
+
+  /** @brief Discards an unfinished trace (see abort()) */
+  ~TraceWriter();
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  /**
+   * @brief Create the trace file and write the header and barrier mask
+   * @param path Output file (.b4t)
+   * @param first First frame of the generation (grid size, generation, challenge, barriers)
+   * @param info Run settings for the header
+   * @return false (after logging) if the file cannot be written
+   */
+  bool open(const std::string& path, const Video::ImageFrameData& first, const TraceInfo& info);
+
+  /**
+   * @brief Append one frame
+   * @return false if the trace is not open or the write failed
+   */
+  bool writeFrame(const Video::ImageFrameData& frame);
+
+  /**
+   * @brief Write the frame index, patch the header and close the file
+   * @return true if the trace was finalized
+   */
+  bool close();
+
+  /** @brief Close without finalizing and delete the partial file */
+  void abort();
+
+  /** @brief True between a successful open() and close()/abort() */
+  bool isOpen() const { return file_ != nullptr; }
+
+  /** @brief Frames written since open() */
+  size_t frameCount() const { return offsets_.size(); }
+
+  /** @brief Bytes written since open() */
+  uint64_t bytesWritten() const { return offset_; }
+
+  /** @brief Path given to the last open() */
+  const std::string& path() const { return path_; }
+
+ private:
+  bool write(const void* data, size_t bytes);
+  void encodeAgents(const Video::ImageFrameData& frame, FrameKind kind);
+  void encodeSignals(const Video::ImageFrameData& frame);
+
+  std::FILE* file_ = nullptr;
+  std::vector<char> fileBuffer_;  ///< stdio buffer
+  std::string path_;
+  TraceHeader header_{};
+  uint64_t offset_ = 0;                 ///< Current file offset
+  std::vector<uint64_t> offsets_;       ///< Offset of each frame
+  std::vector<Coordinate> previous_;    ///< Agent positions of the previous frame
+  uint32_t framesSinceKey_ = 0;         ///< DELTA frames since the last KEY frame
+  std::vector<uint8_t> agentPayload_;   ///< Scratch: encoded agents
+  std::vector<uint8_t> signalPayload_;  ///< Scratch: encoded signal layers
+  std::vector<uint8_t> packed_;         ///< Scratch: one nibble-packed layer
+};
+
+}  // namespace Trace
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_TRACE_TRACEWRITER_H_
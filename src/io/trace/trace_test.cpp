@@ -0,0 +1,131 @@
+/**
+ * @file trace_test.cpp
+ * @brief Round-trip tests for the trace writer and reader.
+ */
+
+#include "imageWriter.h"
+#include "traceReader.h"
+#include "traceWriter.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+
+using IO::Trace::TraceInfo;
+using IO::Trace::TraceReader;
+using IO::Trace::TraceWriter;
+
+namespace {
+
+constexpr uint16_t SIZE_X = 24;
+constexpr uint16_t SIZE_Y = 16;
+constexpr unsigned AGENTS = 9;
+
+/** @brief Deterministic frame: agents drift by one cell, one of them jumps, signals ramp */
+ImageFrameData makeFrame(unsigned step) {
+  ImageFrameData frame;
+  frame.allocate(2, SIZE_X, SIZE_Y, AGENTS);
+  frame.simStep = step;
+  frame.generation = 7;
+  frame.challenge = 3;
+  frame.barrierType = 1;
+  frame.barrierLocs = {Coordinate(5, 5), Coordinate(5, 6), Coordinate(20, 0)};
+  for (unsigned i = 0; i < AGENTS; ++i) {
+    const int16_t x = static_cast<int16_t>((i * 2 + step / (i % 3 + 1)) % SIZE_X);
+    const int16_t y = static_cast<int16_t>((i + step / 2) % SIZE_Y);
+    frame.indivLocs.push_back(Coordinate(x, i == 4 && step % 10 == 9 ? 0 : y));
+    frame.indivColors.push_back(static_cast<uint8_t>(i * 29));
+  }
+  for (size_t c = 0; c < frame.signalData.size(); ++c) {
+    frame.signalData[c] = c % 7 == 0 ? static_cast<uint8_t>((c + step) * 16) : 0;
+  }
+  return frame;
+}
+
+std::string tracePath(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace
+
+TEST(TraceTest, RoundTripsPositionsColorsAndSignals) {
+  const std::string path = tracePath("biosim4_trace_test.b4t");
+  constexpr unsigned FRAMES = 150;  // Crosses two KEY frame intervals
+
+  TraceInfo info;
+  info.stepsPerGeneration = 300;
+  info.population = AGENTS;
+  info.displayScale = 4;
+  info.agentSize = 2;
+  info.signals = true;
+
+  TraceWriter writer;
+  ASSERT_TRUE(writer.open(path, makeFrame(0), info));
+  for (unsigned step = 0; step < FRAMES; ++step) {
+    ASSERT_TRUE(writer.writeFrame(makeFrame(step)));
+  }
+  ASSERT_TRUE(writer.close());
+
+  TraceReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.frameCount(), FRAMES);
+  EXPECT_EQ(reader.header().generation, 7u);
+  EXPECT_EQ(reader.header().sizeX, SIZE_X);
+  EXPECT_EQ(reader.header().agentSize, 2);
+
+  // Sequential reads, then a backwards seek that restarts from a KEY frame
+  ImageFrameData decoded;
+  std::vector<unsigned> order;
+  for (unsigned step = 0; step < FRAMES; ++step) {
+    order.push_back(step);
+  }
+  order.push_back(70);
+  order.push_back(3);
+  for (unsigned step : order) {
+    ASSERT_TRUE(reader.readFrame(step, decoded)) << "frame " << step;
+    const ImageFrameData expected = makeFrame(step);
+    EXPECT_EQ(decoded.simStep, step);
+    EXPECT_EQ(decoded.challenge, expected.challenge);
+    ASSERT_EQ(decoded.indivLocs.size(), expected.indivLocs.size());
+    for (size_t i = 0; i < expected.indivLocs.size(); ++i) {
+      EXPECT_EQ(decoded.indivLocs[i], expected.indivLocs[i]) << "frame " << step << " agent " << i;
+      EXPECT_EQ(decoded.indivColors[i], expected.indivColors[i]);
+    }
+    ASSERT_EQ(decoded.barrierLocs.size(), expected.barrierLocs.size());
+    ASSERT_EQ(decoded.signalData.size(), expected.signalData.size());
+    for (size_t c = 0; c < expected.signalData.size(); ++c) {
+      // Signals are stored as their top four bits
+      ASSERT_EQ(decoded.signalData[c] >> 4, expected.signalData[c] >> 4) << "frame " << step << " cell " << c;
+    }
+  }
+  EXPECT_FALSE(reader.readFrame(FRAMES, decoded));
+  std::remove(path.c_str());
+}
+
+TEST(TraceTest, AbortedTraceIsRemovedAndUnfinishedTraceIsRejected) {
+  const std::string path = tracePath("biosim4_trace_abort.b4t");
+  TraceWriter writer;
+  ASSERT_TRUE(writer.open(path, makeFrame(0), TraceInfo{}));
+  ASSERT_TRUE(writer.writeFrame(makeFrame(0)));
+  writer.abort();
+  EXPECT_FALSE(std::filesystem::exists(path));
+
+  // A file cut off before close() has no frame index
+  {
+    TraceWriter partial;
+    ASSERT_TRUE(partial.open(path, makeFrame(0), TraceInfo{}));
+    ASSERT_TRUE(partial.writeFrame(makeFrame(0)));
+    ASSERT_TRUE(partial.close());
+  }
+  std::filesystem::resize_file(path, 100);
+  TraceReader reader;
+  EXPECT_FALSE(reader.open(path));
+  std::remove(path.c_str());
+}
+
+}  // namespace BioSim
@@ -0,0 +1,55 @@
+/**
+ * @file capturePolicy.cpp
+ * @brief Implementation of the video frame sampling policy
+ */
+
+#include "capturePolicy.h"
+
+#include <algorithm>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+
+void CapturePolicy::configure(const Types::Params& params) {
+  frameStride_ = std::max(1u, params.videoFrameStride);
+  lastStep_ = params.stepsPerGeneration > 0 ? params.stepsPerGeneration - 1 : 0;
+  population_ = params.population;
+  deathTrigger_ = params.videoDeathTrigger;
+  survivorTrigger_ = params.videoSurvivorTrigger;
+  previousLiving_ = 0;
+  capturedSurvivors_ = 0;
+  triggeredFrames_ = 0;
+  skippedSteps_ = 0;
+}
+
+bool CapturePolicy::shouldCapture(unsigned simStep, unsigned living, unsigned survivors) {
+  if (simStep == 0) {
+    previousLiving_ = living;
+  }
+
+  bool capture = simStep % frameStride_ == 0 || simStep == lastStep_;
+  if (!capture) {
+    const bool massDeath =
+        needsLivingCount() && previousLiving_ > living && previousLiving_ - living >= deathTrigger_ * previousLiving_;
+    const unsigned survivorChange =
+        survivors > capturedSurvivors_ ? survivors - capturedSurvivors_ : capturedSurvivors_ - survivors;
+    const bool survivorShift = needsSurvivorCount() && survivorChange >= survivorTrigger_ * population_;
+    capture = massDeath || survivorShift;
+    triggeredFrames_ += capture;
+  }
+
+  previousLiving_ = living;
+  if (capture) {
+    capturedSurvivors_ = survivors;
+  } else {
+    ++skippedSteps_;
+  }
+  return capture;
+}
+
+}  // namespace Video
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
@@ -0,0 +1,77 @@
+#ifndef BIOSIM4_SRC_IO_VIDEO_CAPTUREPOLICY_H_
+#define BIOSIM4_SRC_IO_VIDEO_CAPTUREPOLICY_H_
+
+/**
+ * @file capturePolicy.h
+ * @brief Decides which simulation steps of a recorded generation become video frames
+ *
+ * By default every step of a recorded generation is captured. With
+ * videoFrameStride = N, only every Nth step is kept as a keyframe, plus the
+ * first and last step. Two triggers add frames between keyframes, so that
+ * sudden events are not lost:
+ * - videoDeathTrigger: the living population dropped by at least this
+ *   fraction since the previous step (e.g. a radioactive wall or murder wave)
+ * - videoSurvivorTrigger: the number of individuals that currently pass the
+ *   survival criterion changed by at least this fraction of the population
+ *   since the last captured frame
+ *
+ * The policy only sees counts; endOfSimulationStep() gathers them.
+ */
+
+#include "../../types/params.h"
+
+#include <cstdint>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+
+/**
+ * @class CapturePolicy
+ * @brief Keyframe stride plus change-triggered frames for one generation at a time
+ */
+class CapturePolicy {
+ public:
+  /** @brief Take stride and triggers from the run's parameters and reset the counters */
+  void configure(const Types::Params& params);
+
+  /** @brief The triggers need the living count of every step */
+  bool needsLivingCount() const { return deathTrigger_ > 0.0f; }
+
+  /** @brief The triggers need the survivor count of every step */
+  bool needsSurvivorCount() const { return survivorTrigger_ > 0.0f; }
+
+  /**
+   * @brief Decide whether the current step is captured
+   * @param simStep Step within the generation (0 starts a new generation)
+   * @param living Living individuals after this step's deaths (ignored unless needsLivingCount())
+   * @param survivors Individuals passing the survival criterion (ignored unless needsSurvivorCount())
+   * @return true if the step should become a frame
+   */
+  bool shouldCapture(unsigned simStep, unsigned living, unsigned survivors);
+
+  /** @brief Frames kept because a trigger fired, since configure() */
+  uint64_t triggeredFrames() const { return triggeredFrames_; }
+
+  /** @brief Steps not captured, since configure() */
+  uint64_t skippedSteps() const { return skippedSteps_; }
+
+ private:
+  unsigned frameStride_ = 1;        ///< Keyframe interval in steps
+  unsigned lastStep_ = 0;           ///< Last step of a generation (always captured)
+  unsigned population_ = 0;         ///< Individuals per generation
+  float deathTrigger_ = 0.0f;       ///< Fraction of the living that must die in one step (0 = off)
+  float survivorTrigger_ = 0.0f;    ///< Fraction of the population the survivor count must move (0 = off)
+  unsigned previousLiving_ = 0;     ///< Living count of the previous step
+  unsigned capturedSurvivors_ = 0;  ///< Survivor count of the last captured frame
+  uint64_t triggeredFrames_ = 0;    ///< See triggeredFrames()
+  uint64_t skippedSteps_ = 0;       ///< See skippedSteps()
+};
+
+}  // namespace Video
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_VIDEO_CAPTUREPOLICY_H_
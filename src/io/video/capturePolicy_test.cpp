@@ -0,0 +1,65 @@
+/**
+ * @file capturePolicy_test.cpp
+ * @brief Tests for the video frame sampling policy.
+ */
+
+#include "capturePolicy.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace BioSim {
+
+using IO::Video::CapturePolicy;
+
+namespace {
+
+Params makeParams(unsigned stride, float deathTrigger, float survivorTrigger) {
+  Params p{};
+  p.population = 100;
+  p.stepsPerGeneration = 10;
+  p.videoFrameStride = stride;
+  p.videoDeathTrigger = deathTrigger;
+  p.videoSurvivorTrigger = survivorTrigger;
+  return p;
+}
+
+}  // namespace
+
+TEST(CapturePolicyTest, StrideKeepsKeyframesAndTheLastStep) {
+  CapturePolicy policy;
+  policy.configure(makeParams(4, 0.0f, 0.0f));
+  EXPECT_FALSE(policy.needsLivingCount());
+  EXPECT_FALSE(policy.needsSurvivorCount());
+
+  std::vector<unsigned> captured;
+  for (unsigned generation = 0; generation < 2; ++generation) {
+    for (unsigned step = 0; step < 10; ++step) {
+      if (policy.shouldCapture(step, 0, 0)) {
+        captured.push_back(step);
+      }
+    }
+  }
+  EXPECT_EQ(captured, (std::vector<unsigned>{0, 4, 8, 9, 0, 4, 8, 9}));
+  EXPECT_EQ(policy.skippedSteps(), 12u);
+  EXPECT_EQ(policy.triggeredFrames(), 0u);
+}
+
+TEST(CapturePolicyTest, TriggersAddFramesBetweenKeyframes) {
+  CapturePolicy policy;
+  policy.configure(makeParams(5, 0.25f, 0.1f));
+  ASSERT_TRUE(policy.needsLivingCount());
+  ASSERT_TRUE(policy.needsSurvivorCount());
+
+  EXPECT_TRUE(policy.shouldCapture(0, 100, 0));
+  EXPECT_FALSE(policy.shouldCapture(1, 90, 5));   // 10% died, survivors moved by 5
+  EXPECT_TRUE(policy.shouldCapture(2, 60, 5));    // A third of the living died
+  EXPECT_FALSE(policy.shouldCapture(3, 60, 14));  // Survivors moved by 9 since the last frame
+  EXPECT_TRUE(policy.shouldCapture(4, 60, 15));   // ... and now by 10
+  EXPECT_TRUE(policy.shouldCapture(5, 60, 15));   // Keyframe
+  EXPECT_EQ(policy.triggeredFrames(), 2u);
+  EXPECT_EQ(policy.skippedSteps(), 2u);
+}
+
+}  // namespace BioSim
@@ -0,0 +1,570 @@
+/**
+ * @file containerProbe.cpp
+ * @brief Implementation of header-only video container inspection
+ */
+
+#include "containerProbe.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+
+namespace {
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory map of a whole file, unmapped on destruction
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED) {
+        data_ = static_cast<const uint8_t*>(mapping);
+        size_ = static_cast<size_t>(info.st_size);
+        ::madvise(mapping, size_, MADV_RANDOM);  // Only headers and the index are touched
+      }
+    }
+    opened_ = true;
+    ::close(fd);
+  }
+
+  ~MappedFile() {
+    if (data_) {
+      ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool opened() const { return opened_; }
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const uint8_t* data_ = nullptr;  ///< Start of the mapping (null for an empty file)
+  size_t size_ = 0;                ///< Mapped bytes
+  bool opened_ = false;            ///< The file could be opened
+};
+
+uint32_t le32(const uint8_t* p) {
+  return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+uint32_t be32(const uint8_t* p) {
+  return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | uint32_t(p[3]);
+}
+
+uint64_t be64(const uint8_t* p) {
+  return uint64_t(be32(p)) << 32 | be32(p + 4);
+}
+
+bool tagIs(const uint8_t* p, const char* tag) {
+  return std::memcmp(p, tag, 4) == 0;
+}
+
+std::string tagName(const uint8_t* p) {
+  return std::string(reinterpret_cast<const char*>(p), 4);
+}
+
+// ============================================================================
+// AVI (RIFF)
+// ============================================================================
+
+/**
+ * @struct AviState
+ * @brief What the RIFF walk collected
+ */
+struct AviState {
+  unsigned riffCount = 0;         ///< "RIFF" chunks: "AVI " plus OpenDML "AVIX" extensions
+  unsigned streams = 0;           ///< strl lists seen so far
+  int videoStream = -1;           ///< Index of the first video stream
+  uint32_t microSecPerFrame = 0;  ///< avih
+  uint32_t width = 0;             ///< avih
+  uint32_t height = 0;            ///< avih
+  uint32_t scale = 0;             ///< strh of the video stream
+  uint32_t rate = 0;              ///< strh of the video stream
+  uint32_t streamLength = 0;      ///< strh of the video stream: frames in the stream
+  uint32_t odmlFrames = 0;        ///< dmlh: total frames across all RIFF chunks
+  bool superIndex = false;        ///< OpenDML indx chunk present
+  size_t moviTag = 0;             ///< Offset of the first "movi" list type
+  size_t moviEnd = 0;             ///< End of the first movi list
+  const uint8_t* idx1 = nullptr;  ///< Legacy index of the first RIFF chunk
+  uint32_t idx1Bytes = 0;         ///< Size of idx1
+};
+
+/**
+ * @brief Walk the chunks in [begin, end), descending into header lists but not into movi
+ * @return false with a problem description if a chunk runs past its parent
+ */
+bool walkAviChunks(const uint8_t* data, size_t begin, size_t end, AviState& state, std::string& problem) {
+  size_t pos = begin;
+  while (pos + 8 <= end) {
+    const uint8_t* chunk = data + pos;
+    const size_t bytes = le32(chunk + 4);
+    const size_t body = pos + 8;
+    if (bytes > end - body) {
+      problem = "'" + tagName(chunk) + "' chunk runs past the end of the file (truncated)";
+      return false;
+    }
+
+    if (tagIs(chunk, "LIST") && bytes >= 4) {
+      const uint8_t* listType = data + body;
+      if (tagIs(listType, "movi")) {
+        if (state.moviEnd == 0) {
+          state.moviTag = body;
+          state.moviEnd = body + bytes;
+        }
+      } else {
+        if (tagIs(listType, "strl")) {
+          ++state.streams;
+        }
+        if (!walkAviChunks(data, body + 4, body + bytes, state, problem)) {
+          return false;
+        }
+      }
+    } else if (tagIs(chunk, "avih") && bytes >= 40) {
+      state.microSecPerFrame = le32(data + body);
+      state.width = le32(data + body + 32);
+      state.height = le32(data + body + 36);
+    } else if (tagIs(chunk, "strh") && bytes >= 36) {
+      if (tagIs(data + body, "vids") && state.videoStream < 0 && state.streams > 0) {
+        state.videoStream = static_cast<int>(state.streams - 1);
+        state.scale = le32(data + body + 20);
+        state.rate = le32(data + body + 24);
+        state.streamLength = le32(data + body + 32);
+      }
+    } else if (tagIs(chunk, "dmlh") && bytes >= 4) {
+      state.odmlFrames = le32(data + body);
+    } else if (tagIs(chunk, "indx")) {
+      state.superIndex = true;
+    } else if (tagIs(chunk, "idx1") && !state.idx1) {
+      state.idx1 = data + body;
+      state.idx1Bytes = static_cast<uint32_t>(bytes);
+    }
+    pos = body + bytes + (bytes & 1);
+  }
+  return true;
+}
+
+void probeAvi(const uint8_t* data, size_t size, ContainerInfo& info) {
+  info.container = "avi";
+  AviState state;
+  size_t pos = 0;
+  while (pos + 12 <= size) {
+    if (!tagIs(data + pos, "RIFF")) {
+      info.problem = "unexpected '" + tagName(data + pos) + "' chunk after the RIFF chunks";
+      return;
+    }
+    const size_t bytes = le32(data + pos + 4);
+    if (bytes < 4 || bytes > size - pos - 8) {
+      info.problem = "RIFF chunk runs past the end of the file (truncated)";
+      return;
+    }
+    ++state.riffCount;
+    if (!walkAviChunks(data, pos + 12, pos + 8 + bytes, state, info.problem)) {
+      return;
+    }
+    pos += 8 + bytes + (bytes & 1);
+  }
+
+  info.width = state.width;
+  info.height = state.height;
+  if (state.rate > 0 && state.scale > 0) {
+    info.frameRate = double(state.rate) / state.scale;
+  } else if (state.microSecPerFrame > 0) {
+    info.frameRate = 1e6 / state.microSecPerFrame;
+  }
+
+  if (state.videoStream < 0) {
+    info.problem = "no video stream header";
+    return;
+  }
+  if (state.moviEnd == 0) {
+    info.problem = "no movi list";
+    return;
+  }
+  if (!state.idx1 && !state.superIndex) {
+    info.problem = "no index (the writer did not finish)";
+    return;
+  }
+
+  if (state.idx1 && state.riffCount == 1) {
+    // Count the video stream's entries ("NNdc"/"NNdb") and check that the last one lies in the file
+    const char digits[2] = {static_cast<char>('0' + state.videoStream / 10 % 10),
+                            static_cast<char>('0' + state.videoStream % 10)};
+    uint64_t indexed = 0;
+    const uint8_t* lastEntry = nullptr;
+    for (uint32_t offset = 0; offset + 16 <= state.idx1Bytes; offset += 16) {
+      const uint8_t* entry = state.idx1 + offset;
+      if (entry[0] == digits[0] && entry[1] == digits[1] && entry[2] == 'd' && (entry[3] == 'c' || entry[3] == 'b')) {
+        ++indexed;
+        lastEntry = entry;
+      }
+    }
+    if (lastEntry) {
+      const uint64_t chunkBytes = uint64_t(le32(lastEntry + 12)) + 8;
+      const uint64_t relative = uint64_t(le32(lastEntry + 8)) + state.moviTag;  // Offsets count from "movi"
+      const uint64_t absolute = le32(lastEntry + 8);                            // Some writers use file offsets
+      if (relative + chunkBytes > state.moviEnd && absolute + chunkBytes > state.moviEnd) {
+        info.problem = "index points past the movi list";
+        return;
+      }
+    }
+    if (state.streamLength > 0 && indexed != state.streamLength) {
+      info.problem =
+          "index holds " + std::to_string(indexed) + " frames, header says " + std::to_string(state.streamLength);
+      return;
+    }
+    info.frameCount = indexed;
+  } else {
+    info.frameCount = state.odmlFrames > 0 ? state.odmlFrames : state.streamLength;
+  }
+}
+
+// ============================================================================
+// MP4 / MOV (ISO base media file format)
+// ============================================================================
+
+/**
+ * @struct Box
+ * @brief One box: its type and payload
+ */
+struct Box {
+  const uint8_t* type = nullptr;  ///< Four-character type
+  size_t body = 0;                ///< Offset of the payload
+  size_t bytes = 0;               ///< Payload size
+};
+
+/**
+ * @brief Read the box at pos and advance past it
+ * @return false with a problem description if the box does not fit in [pos, end)
+ */
+bool nextBox(const uint8_t* data, size_t& pos, size_t end, Box& box, std::string& problem) {
+  if (end - pos < 8) {
+    problem = "box header cut off (truncated)";
+    return false;
+  }
+  uint64_t size = be32(data + pos);
+  size_t header = 8;
+  if (size == 1) {
+    if (end - pos < 16) {
+      problem = "box header cut off (truncated)";
+      return false;
+    }
+    size = be64(data + pos + 8);
+    header = 16;
+  } else if (size == 0) {
+    size = end - pos;  // Extends to the end of the file
+  }
+  box.type = data + pos + 4;
+  if (size < header || size > end - pos) {
+    problem = "'" + tagName(box.type) + "' box runs past the end of the file (truncated)";
+    return false;
+  }
+  box.body = pos + header;
+  box.bytes = static_cast<size_t>(size) - header;
+  pos += static_cast<size_t>(size);
+  return true;
+}
+
+/**
+ * @struct Mp4Track
+ * @brief Fields of one trak box
+ */
+struct Mp4Track {
+  uint32_t trackId = 0;    ///< tkhd
+  unsigned width = 0;      ///< tkhd, integer part of the 16.16 value
+  unsigned height = 0;     ///< tkhd
+  bool video = false;      ///< hdlr handler type is "vide"
+  uint32_t timescale = 0;  ///< mdhd
+  uint64_t duration = 0;   ///< mdhd, in timescale units
+  uint64_t samples = 0;    ///< stsz sample count
+};
+
+/**
+ * @brief Collect the fields of a trak box, descending through mdia, minf and stbl
+ */
+bool parseTrack(const uint8_t* data, size_t begin, size_t end, Mp4Track& track, std::string& problem) {
+  size_t pos = begin;
+  Box box;
+  while (pos < end) {
+    if (!nextBox(data, pos, end, box, problem)) {
+      return false;
+    }
+    const uint8_t* body = data + box.body;
+    if (tagIs(box.type, "mdia") || tagIs(box.type, "minf") || tagIs(box.type, "stbl")) {
+      if (!parseTrack(data, box.body, box.body + box.bytes, track, problem)) {
+        return false;
+      }
+    } else if (tagIs(box.type, "tkhd") && box.bytes >= 84) {
+      const bool v1 = body[0] == 1;
+      if (!v1 || box.bytes >= 96) {
+        track.trackId = be32(body + (v1 ? 20 : 12));
+        track.width = be32(body + (v1 ? 88 : 76)) >> 16;
+        track.height = be32(body + (v1 ? 92 : 80)) >> 16;
+      }
+    } else if (tagIs(box.type, "hdlr") && box.bytes >= 12) {
+      track.video = tagIs(body + 8, "vide");
+    } else if (tagIs(box.type, "mdhd") && box.bytes >= 24) {
+      const bool v1 = body[0] == 1;
+      if (!v1 || box.bytes >= 36) {
+        track.timescale = be32(body + (v1 ? 20 : 12));
+        track.duration = v1 ? be64(body + 24) : be32(body + 16);
+      }
+    } else if (tagIs(box.type, "stsz") && box.bytes >= 12) {
+      track.samples = be32(body + 8);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Add the trun sample counts of a moof box's trafs that belong to a track
+ */
+bool countFragmentSamples(const uint8_t* data, const Box& moof, uint32_t trackId, uint64_t& samples,
+                          std::string& problem) {
+  size_t pos = moof.body;
+  const size_t end = moof.body + moof.bytes;
+  Box traf;
+  while (pos < end) {
+    if (!nextBox(data, pos, end, traf, problem)) {
+      return false;
+    }
+    if (!tagIs(traf.type, "traf")) {
+      continue;
+    }
+    bool ours = false;
+    size_t inner = traf.body;
+    Box box;
+    while (inner < traf.body + traf.bytes) {
+      if (!nextBox(data, inner, traf.body + traf.bytes, box, problem)) {
+        return false;
+      }
+      if (tagIs(box.type, "tfhd") && box.bytes >= 8) {
+        ours = be32(data + box.body + 4) == trackId;
+      } else if (tagIs(box.type, "trun") && box.bytes >= 8 && ours) {
+        samples += be32(data + box.body + 4);
+      }
+    }
+  }
+  return true;
+}
+
+void probeMp4(const uint8_t* data, size_t size, ContainerInfo& info) {
+  info.container = size >= 12 && tagIs(data + 4, "ftyp") && tagIs(data + 8, "qt  ") ? "mov" : "mp4";
+
+  // Top level: every box must fit in the file; remember moov, mdat and the fragments
+  bool haveMoov = false;
+  bool haveMedia = false;
+  Box moov;
+  std::vector<Box> fragments;
+  size_t pos = 0;
+  Box box;
+  while (pos < size) {
+    if (!nextBox(data, pos, size, box, info.problem)) {
+      return;
+    }
+    if (tagIs(box.type, "moov")) {
+      haveMoov = true;
+      moov = box;
+    } else if (tagIs(box.type, "mdat")) {
+      haveMedia = true;
+    } else if (tagIs(box.type, "moof")) {
+      fragments.push_back(box);
+    }
+  }
+  if (!haveMoov) {
+    info.problem = "no moov box (the writer did not finish)";
+    return;
+  }
+
+  // First video track, plus the movie's own timescale as a fallback for the duration
+  Mp4Track video;
+  uint32_t movieTimescale = 0;
+  uint64_t movieDuration = 0;
+  pos = moov.body;
+  while (pos < moov.body + moov.bytes) {
+    if (!nextBox(data, pos, moov.body + moov.bytes, box, info.problem)) {
+      return;
+    }
+    if (tagIs(box.type, "mvhd") && box.bytes >= 20) {
+      const uint8_t* body = data + box.body;
+      const bool v1 = body[0] == 1;
+      if (!v1 || box.bytes >= 32) {
+        movieTimescale = be32(body + (v1 ? 20 : 12));
+        movieDuration = v1 ? be64(body + 24) : be32(body + 16);
+      }
+    } else if (tagIs(box.type, "trak") && !video.video) {
+      Mp4Track track;
+      if (!parseTrack(data, box.body, box.body + box.bytes, track, info.problem)) {
+        return;
+      }
+      if (track.video) {
+        video = track;
+      }
+    }
+  }
+  if (!video.video) {
+    info.problem = "no video track";
+    return;
+  }
+
+  uint64_t frames = video.samples;
+  for (const Box& moof : fragments) {
+    if (!countFragmentSamples(data, moof, video.trackId, frames, info.problem)) {
+      return;
+    }
+  }
+  info.width = video.width;
+  info.height = video.height;
+  info.frameCount = frames;
+  if (video.timescale > 0 && video.duration > 0) {
+    info.durationSeconds = double(video.duration) / video.timescale;
+  } else if (movieTimescale > 0) {
+    info.durationSeconds = double(movieDuration) / movieTimescale;
+  }
+  if (info.durationSeconds > 0.0) {
+    info.frameRate = frames / info.durationSeconds;
+  }
+  if (!haveMedia && fragments.empty()) {
+    info.problem = "no media data";
+  }
+}
+
+// ============================================================================
+// Y4M (YUV4MPEG2)
+// ============================================================================
+
+/**
+ * @brief Bytes of one frame for a Y4M colorspace tag ("420jpeg", "444", "mono", "420p10", ...)
+ */
+uint64_t y4mFrameBytes(unsigned width, unsigned height, const std::string& colorspace) {
+  const uint64_t luma = uint64_t(width) * height;
+  const uint64_t chromaWidth = (width + 1) / 2;
+  const uint64_t chromaHeight = (height + 1) / 2;
+  uint64_t samples = luma + 2 * chromaWidth * chromaHeight;  // 4:2:0, the default
+  if (colorspace.rfind("422", 0) == 0) {
+    samples = luma + 2 * chromaWidth * height;
+  } else if (colorspace.rfind("444alpha", 0) == 0) {
+    samples = 4 * luma;
+  } else if (colorspace.rfind("444", 0) == 0) {
+    samples = 3 * luma;
+  } else if (colorspace.rfind("mono", 0) == 0) {
+    samples = luma;
+  }
+  const size_t depth = colorspace.find('p');
+  const bool wide = depth != std::string::npos && std::atoi(colorspace.c_str() + depth + 1) > 8;
+  return wide ? 2 * samples : samples;
+}
+
+void probeY4m(const uint8_t* data, size_t size, ContainerInfo& info) {
+  info.container = "y4m";
+  const uint8_t* newline = static_cast<const uint8_t*>(std::memchr(data, '\n', size));
+  if (!newline) {
+    info.problem = "stream header cut off (truncated)";
+    return;
+  }
+
+  std::string colorspace = "420jpeg";
+  const std::string header(reinterpret_cast<const char*>(data), static_cast<size_t>(newline - data));
+  size_t token = header.find(' ');
+  while (token != std::string::npos) {
+    const size_t next = header.find(' ', token + 1);
+    const std::string field = header.substr(token + 1, next == std::string::npos ? next : next - token - 1);
+    if (!field.empty()) {
+      if (field[0] == 'W') {
+        info.width = static_cast<unsigned>(std::atoi(field.c_str() + 1));
+      } else if (field[0] == 'H') {
+        info.height = static_cast<unsigned>(std::atoi(field.c_str() + 1));
+      } else if (field[0] == 'F') {
+        const size_t colon = field.find(':');
+        const double den = colon == std::string::npos ? 0.0 : std::atof(field.c_str() + colon + 1);
+        info.frameRate = den > 0.0 ? std::atof(field.c_str() + 1) / den : 0.0;
+      } else if (field[0] == 'C') {
+        colorspace = field.substr(1);
+      }
+    }
+    token = next;
+  }
+  if (info.width == 0 || info.height == 0) {
+    info.problem = "stream header has no frame size";
+    return;
+  }
+
+  // Each frame is "FRAME[ params]\n" followed by the planes; only the frame headers are read
+  const uint64_t frameBytes = y4mFrameBytes(info.width, info.height, colorspace);
+  size_t pos = static_cast<size_t>(newline - data) + 1;
+  while (pos < size) {
+    if (size - pos < 6 || std::memcmp(data + pos, "FRAME", 5) != 0) {
+      info.problem = "frame " + std::to_string(info.frameCount) + " has no FRAME header";
+      return;
+    }
+    const uint8_t* end = static_cast<const uint8_t*>(std::memchr(data + pos, '\n', size - pos));
+    if (!end || frameBytes > size - static_cast<size_t>(end - data) - 1) {
+      info.problem = "frame " + std::to_string(info.frameCount) + " is cut off (truncated)";
+      return;
+    }
+    pos = static_cast<size_t>(end - data) + 1 + static_cast<size_t>(frameBytes);
+    ++info.frameCount;
+  }
+}
+
+}  // namespace
+
+ContainerInfo probeContainer(const std::filesystem::path& path) {
+  ContainerInfo info;
+  const MappedFile file(path);
+  if (!file.opened()) {
+    info.problem = "cannot open file";
+    return info;
+  }
+  if (file.size() < 12) {
+    info.problem = file.size() == 0 ? "empty file" : "file too short for a video";
+    return info;
+  }
+
+  const uint8_t* data = file.data();
+  if (tagIs(data, "RIFF") && tagIs(data + 8, "AVI ")) {
+    probeAvi(data, file.size(), info);
+  } else if (std::memcmp(data, "YUV4MPEG2", 9) == 0) {
+    probeY4m(data, file.size(), info);
+  } else if (tagIs(data + 4, "ftyp") || tagIs(data + 4, "moov") || tagIs(data + 4, "mdat") ||
+             tagIs(data + 4, "free") || tagIs(data + 4, "wide")) {
+    probeMp4(data, file.size(), info);
+  } else {
+    info.problem = "unrecognized container";
+    return info;
+  }
+
+  if (info.problem.empty() && info.frameCount == 0) {
+    info.problem = "no frames";
+  }
+  if (info.durationSeconds == 0.0 && info.frameRate > 0.0) {
+    info.durationSeconds = info.frameCount / info.frameRate;
+  }
+  info.valid = info.problem.empty();
+  return info;
+}
+
+}  // namespace Video
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
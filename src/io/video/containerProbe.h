@@ -0,0 +1,58 @@
+#ifndef BIOSIM4_SRC_IO_VIDEO_CONTAINERPROBE_H_
+#define BIOSIM4_SRC_IO_VIDEO_CONTAINERPROBE_H_
+
+/**
+ * @file containerProbe.h
+ * @brief Header-only inspection of AVI, MP4/MOV and Y4M video files
+ *
+ * probeContainer() maps a video read-only and walks only its container
+ * structure: RIFF chunks and the idx1 index for AVI, the box tree (moov, trak,
+ * stsz, moof/trun) for MP4 and MOV, and the frame headers for Y4M. No sample
+ * is decoded, so a file is checked in microseconds, and the pages touched are
+ * the headers and index rather than the whole file.
+ *
+ * A file is reported invalid when its structure shows that the writer did not
+ * finish: a chunk or box that runs past the end of the file, a missing index
+ * or movie header, zero frames, or an index that disagrees with the header.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+
+/**
+ * @struct ContainerInfo
+ * @brief What the container headers say about a video
+ */
+struct ContainerInfo {
+  std::string container;         ///< "avi", "mp4", "y4m", or "" if the format was not recognized
+  unsigned width = 0;            ///< Frame width in pixels
+  unsigned height = 0;           ///< Frame height in pixels
+  uint64_t frameCount = 0;       ///< Video frames according to the index (or header)
+  double frameRate = 0.0;        ///< Frames per second
+  double durationSeconds = 0.0;  ///< Length of the video stream
+  bool valid = false;            ///< The file is complete and consistent
+  std::string problem;           ///< Why the file is invalid ("" if valid)
+};
+
+/**
+ * @brief Read a video's container headers and index through a memory map
+ *
+ * Safe to call from several threads at once.
+ *
+ * @param path Video file (.avi, .mp4, .mov or .y4m; the format is detected from the content)
+ * @return Container information; valid is false with a problem description on failure
+ */
+ContainerInfo probeContainer(const std::filesystem::path& path);
+
+}  // namespace Video
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_VIDEO_CONTAINERPROBE_H_
@@ -0,0 +1,204 @@
+/**
+ * @file containerProbe_test.cpp
+ * @brief Tests for header-only container inspection on small synthetic files.
+ */
+
+#include "containerProbe.h"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace BioSim {
+
+using IO::Video::ContainerInfo;
+using IO::Video::probeContainer;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+void putLe32(Bytes& out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void putBe32(Bytes& out, uint32_t value) {
+  for (int i = 3; i >= 0; --i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void putTag(Bytes& out, const char* tag) {
+  out.insert(out.end(), tag, tag + 4);
+}
+
+Bytes riffChunk(const char* id, const Bytes& body) {
+  Bytes out;
+  putTag(out, id);
+  putLe32(out, static_cast<uint32_t>(body.size()));
+  out.insert(out.end(), body.begin(), body.end());
+  return out;
+}
+
+Bytes riffList(const char* type, const std::vector<Bytes>& children) {
+  Bytes body;
+  putTag(body, type);
+  for (const Bytes& child : children) {
+    body.insert(body.end(), child.begin(), child.end());
+  }
+  return riffChunk("LIST", body);
+}
+
+/** @brief AVI with one 25 fps video stream of `frames` 10-byte frames; `headerFrames` goes into strh */
+Bytes makeAvi(uint32_t frames, uint32_t headerFrames) {
+  Bytes avih(56, 0);
+  avih[0] = 0x40, avih[1] = 0x9c;  // 40000 us per frame
+  avih[32] = 64;                   // Width
+  avih[36] = 48;                   // Height
+  Bytes strh;
+  putTag(strh, "vids");
+  putTag(strh, "H264");
+  strh.resize(20, 0);
+  putLe32(strh, 1);   // dwScale
+  putLe32(strh, 25);  // dwRate
+  putLe32(strh, 0);   // dwStart
+  putLe32(strh, headerFrames);
+  strh.resize(56, 0);
+
+  std::vector<Bytes> chunks;
+  Bytes index;
+  uint32_t offset = 4;
+  for (uint32_t f = 0; f < frames; ++f) {
+    chunks.push_back(riffChunk("00dc", Bytes(10, static_cast<uint8_t>(f))));
+    putTag(index, "00dc");
+    putLe32(index, 0x10);
+    putLe32(index, offset);
+    putLe32(index, 10);
+    offset += 18;
+  }
+
+  Bytes avi;
+  putTag(avi, "AVI ");
+  for (const Bytes& part : {riffList("hdrl", {riffChunk("avih", avih), riffList("strl", {riffChunk("strh", strh)})}),
+                            riffList("movi", chunks), riffChunk("idx1", index)}) {
+    avi.insert(avi.end(), part.begin(), part.end());
+  }
+  return riffChunk("RIFF", avi);
+}
+
+Bytes box(const char* type, const Bytes& body) {
+  Bytes out;
+  putBe32(out, static_cast<uint32_t>(body.size() + 8));
+  putTag(out, type);
+  out.insert(out.end(), body.begin(), body.end());
+  return out;
+}
+
+Bytes boxes(const std::vector<Bytes>& children) {
+  Bytes out;
+  for (const Bytes& child : children) {
+    out.insert(out.end(), child.begin(), child.end());
+  }
+  return out;
+}
+
+/** @brief MP4 with one 320x240 video track of `frames` samples at 30 fps */
+Bytes makeMp4(uint32_t frames) {
+  Bytes tkhd(84, 0);
+  tkhd[15] = 1;                      // Track ID
+  tkhd[76] = 0x01, tkhd[77] = 0x40;  // Width 320, 16.16 fixed point
+  tkhd[81] = 240;                    // Height 240
+  Bytes mdhd(24, 0);
+  mdhd[14] = 0x75, mdhd[15] = 0x30;  // Timescale 30000
+  const uint32_t duration = frames * 1000;
+  mdhd[16] = static_cast<uint8_t>(duration >> 24), mdhd[17] = static_cast<uint8_t>(duration >> 16);
+  mdhd[18] = static_cast<uint8_t>(duration >> 8), mdhd[19] = static_cast<uint8_t>(duration);
+  Bytes hdlr(24, 0);
+  hdlr[8] = 'v', hdlr[9] = 'i', hdlr[10] = 'd', hdlr[11] = 'e';
+  Bytes stsz(8, 0);
+  putBe32(stsz, frames);
+
+  Bytes ftyp;
+  putTag(ftyp, "isom");
+  putBe32(ftyp, 512);
+  const Bytes stbl = box("stbl", box("stsz", stsz));
+  const Bytes mdia = box("mdia", boxes({box("mdhd", mdhd), box("hdlr", hdlr), box("minf", stbl)}));
+  const Bytes moov = box("moov", boxes({box("mvhd", Bytes(100, 0)), box("trak", boxes({box("tkhd", tkhd), mdia}))}));
+  return boxes({box("ftyp", ftyp), box("mdat", Bytes(frames * 7, 1)), moov});
+}
+
+std::string writeTemp(const std::string& name, const Bytes& bytes) {
+  const std::string path = "/tmp/biosim4-probe-" + std::to_string(::getpid()) + "-" + name;
+  std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  return path;
+}
+
+ContainerInfo probeBytes(const std::string& name, const Bytes& bytes) {
+  const std::string path = writeTemp(name, bytes);
+  const ContainerInfo info = probeContainer(path);
+  std::remove(path.c_str());
+  return info;
+}
+
+}  // namespace
+
+TEST(ContainerProbeTest, AviHeadersAndIndexGiveFramesAndSize) {
+  const Bytes avi = makeAvi(50, 50);
+  const ContainerInfo info = probeBytes("ok.avi", avi);
+  EXPECT_TRUE(info.valid) << info.problem;
+  EXPECT_EQ(info.container, "avi");
+  EXPECT_EQ(info.frameCount, 50u);
+  EXPECT_EQ(info.width, 64u);
+  EXPECT_EQ(info.height, 48u);
+  EXPECT_DOUBLE_EQ(info.frameRate, 25.0);
+  EXPECT_DOUBLE_EQ(info.durationSeconds, 2.0);
+
+  // Cut off inside the index, or unfinished (header frame count never written back)
+  EXPECT_FALSE(probeBytes("cut.avi", Bytes(avi.begin(), avi.end() - 20)).valid);
+  const ContainerInfo mismatch = probeBytes("mismatch.avi", makeAvi(50, 60));
+  EXPECT_FALSE(mismatch.valid);
+  EXPECT_NE(mismatch.problem.find("index holds 50"), std::string::npos) << mismatch.problem;
+}
+
+TEST(ContainerProbeTest, Mp4BoxesGiveFramesAndDuration) {
+  const Bytes mp4 = makeMp4(90);
+  const ContainerInfo info = probeBytes("ok.mp4", mp4);
+  EXPECT_TRUE(info.valid) << info.problem;
+  EXPECT_EQ(info.container, "mp4");
+  EXPECT_EQ(info.frameCount, 90u);
+  EXPECT_EQ(info.width, 320u);
+  EXPECT_EQ(info.height, 240u);
+  EXPECT_DOUBLE_EQ(info.durationSeconds, 3.0);
+
+  // The moov box is written last, so a cut file has a box running past its end
+  const ContainerInfo cut = probeBytes("cut.mp4", Bytes(mp4.begin(), mp4.end() - 30));
+  EXPECT_FALSE(cut.valid);
+  EXPECT_NE(cut.problem.find("truncated"), std::string::npos) << cut.problem;
+}
+
+TEST(ContainerProbeTest, Y4mFrameHeadersAreCounted) {
+  const std::string header = "YUV4MPEG2 W4 H2 F25:1 Ip A1:1 C444\n";
+  Bytes y4m(header.begin(), header.end());
+  for (int f = 0; f < 3; ++f) {
+    const std::string frame = "FRAME\n";
+    y4m.insert(y4m.end(), frame.begin(), frame.end());
+    y4m.insert(y4m.end(), 4 * 2 * 3, 0x80);
+  }
+  const ContainerInfo info = probeBytes("ok.y4m", y4m);
+  EXPECT_TRUE(info.valid) << info.problem;
+  EXPECT_EQ(info.frameCount, 3u);
+  EXPECT_EQ(info.width, 4u);
+  EXPECT_DOUBLE_EQ(info.durationSeconds, 3.0 / 25.0);
+
+  EXPECT_FALSE(probeBytes("cut.y4m", Bytes(y4m.begin(), y4m.end() - 1)).valid);
+  EXPECT_FALSE(probeBytes("empty.avi", Bytes{}).valid);
+}
+
+}  // namespace BioSim
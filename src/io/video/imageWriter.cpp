@@ -13,17 +13,18 @@
 #include "imageWriter.h"
 
 #include "../../core/simulation/simulator.h"
+#include "../../utils/logger.h"
 #include "../render/renderBackend.h"
+#include "../trace/traceWriter.h"
 
 #include <spdlog/fmt/fmt.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
-#include <condition_variable>
-#include <iomanip>
-#include <iostream>
+#include <cstring>
 #include <memory>
 #include <mutex>
-#include <sstream>
 #include <thread>
 
 namespace BioSim {
@@ -31,8 +32,57 @@ inline namespace v1 {
 namespace IO {
 namespace Video {
 
-// Global render backend instance (owned by imageWriter)
-static std::unique_ptr<IO::Render::IRenderBackend> renderBackend = nullptr;
+using Utils::Logger;
+
+// Backend of the first encoder worker, used by saveOneFrameImmed() and sync mode
+static IO::Render::IRenderBackend* primaryBackend = nullptr;
+
+/**
+ * @brief Blend alpha for each intensity of a pheromone layer, computed once per process
+ *
+ * Layer 0 (trails) is scaled to at most 0.33 so dense trails do not hide the
+ * agents; layer 1 (recent deaths) uses the intensity as alpha.
+ */
+static const SignalAlphaLut& signalAlphaLut(unsigned layer) {
+  static const std::array<SignalAlphaLut, 2> luts = [] {
+    std::array<SignalAlphaLut, 2> tables{};
+    for (unsigned intensity = 0; intensity < 256; ++intensity) {
+      const float trail = std::min((static_cast<float>(intensity) / 255.0f) / 3.0f, 0.33f);
+      tables[0][intensity] = static_cast<uint8_t>(trail * 255.0f);
+      tables[1][intensity] = static_cast<uint8_t>(intensity);
+    }
+    return tables;
+  }();
+  return luts[layer > 0 ? 1 : 0];
+}
+
+const Color& agentColor(uint8_t colorIndex) {
+  static const std::array<Color, 256> colors = [] {
+    constexpr uint8_t maxColorVal = 0xb0;
+    constexpr uint8_t maxLumaVal = 0xb0;
+    auto rgbToLuma = [](uint8_t r, uint8_t g, uint8_t b) { return (r + r + r + b + g + g + g + g) / 8; };
+
+    std::array<Color, 256> table;
+    for (unsigned c = 0; c < 256; ++c) {
+      uint8_t r = static_cast<uint8_t>(c);                // R: 0..255
+      uint8_t g = static_cast<uint8_t>((c & 0x1f) << 3);  // G: 0..255
+      uint8_t b = static_cast<uint8_t>((c & 7) << 5);     // B: 0..255
+
+      // Prevent color mappings to very bright colors (hard to see):
+      if (rgbToLuma(r, g, b) > maxLumaVal) {
+        if (r > maxColorVal)
+          r %= maxColorVal;
+        if (g > maxColorVal)
+          g %= maxColorVal;
+        if (b > maxColorVal)
+          b %= maxColorVal;
+      }
+      table[c] = Color(r, g, b, 255);
+    }
+    return table;
+  }();
+  return colors[colorIndex];
+}
 
 /**
  * @brief Renders a single simulation frame using the render backend abstraction
@@ -49,27 +99,31 @@ static std::unique_ptr<IO::Render::IRenderBackend> renderBackend = nullptr;
  * 5. Barrier locations (gray rectangles)
  * 6. Individual agents (colored circles based on genome hash)
  *
+ * Layers 1, 2 and 5 are static within a generation; drawBackground() lets the
+ * backend render them once and copy them into each frame.
+ *
+ * @param backend Backend that draws and encodes the frame
  * @param data Cached snapshot of simulation state including individual locations, colors,
  *             pheromone intensities, and barrier positions. This snapshot is immutable
  *             allowing rendering to occur on a separate thread without data races.
+ * @param stepsPerGeneration Steps per generation (radioactive wall switch)
+ * @param agentSize Agent circle radius in pixels
  *
  * @note Frame resolution is gridSize * displayScale pixels per dimension
- * @note Agent colors are deterministically generated from genome via makeGeneticColor()
+ * @note Agent colors come from each individual's colorIndex, mapped through agentColor()
  * @note Pheromone alpha values are scaled to prevent over-saturation (max 0.33 for layer 0)
- * @note The rendered frame is buffered by the backend for later video encoding
+ * @note The rendered frame is handed to the backend, which streams it to the encoder
+ * @note Takes the settings as arguments so biosim4-render can replay traces without a simulation
  *
  * @see makeGeneticColor() for color generation algorithm
+ * @see agentColor() for the color index to RGBA mapping
  * @see ImageFrameData for data structure definition
  * @see IRenderBackend for rendering interface details
  */
-void saveOneFrameImmed(const ImageFrameData& data) {
-  if (!renderBackend) {
-    fmt::print(stderr, "Error: Render backend not initialized!\n");
-    return;
-  }
-
+void renderFrame(IO::Render::IRenderBackend& backend, const ImageFrameData& data, unsigned stepsPerGeneration,
+                 uint16_t agentSize) {
   // Begin new frame (creates white canvas)
-  renderBackend->beginFrame(data.simStep, data.generation);
+  backend.beginFrame(data.simStep, data.generation);
 
   // Convert challenge enum to zone type
   ChallengeZoneType zoneType = ChallengeZoneType::NONE;
@@ -88,267 +142,342 @@ void saveOneFrameImmed(const ImageFrameData& data) {
       break;
   }
 
-  // Draw challenge zones
-  renderBackend->drawChallengeZone(zoneType, data.simStep, parameterMngrSingleton.stepsPerGeneration);
+  // Draw challenge zones (and, where the backend caches them, barriers) from the generation's static background
+  const Color barrierColor(0x88, 0x88, 0x88, 0xff);  // Gray
+  backend.drawBackground(zoneType, data.simStep, stepsPerGeneration, data.barrierLocs, barrierColor);
 
   // Draw standard pheromone trails (signal layer 0) - blue with alpha
-  if (data.signalLayers.size() > 0) {
-    for (int16_t x = 0; x < parameterMngrSingleton.gridSize_X; ++x) {
-      for (int16_t y = 0; y < parameterMngrSingleton.gridSize_Y; ++y) {
-        uint8_t intensity = data.signalLayers[0][x][y];
-        if (intensity > 0) {
-          // Blue pheromone with alpha based on intensity (max 0.33)
-          float alpha = (static_cast<float>(intensity) / 255.0f) / 3.0f;
-          if (alpha > 0.33f) {
-            alpha = 0.33f;
-          }
-          uint8_t alphaVal = static_cast<uint8_t>(alpha * 255.0f);
-
-          // Draw rectangle for pheromone cell
-          renderBackend->drawRectangle(x - 1, y - 1, x + 1, y + 1, Color(0x00, 0x00, 0xff, alphaVal));
-        }
-      }
-    }
+  if (data.signalLayerCount > 0) {
+    backend.drawSignalLayer(data.signalLayer(0), data.sizeX, data.sizeY, Color(0x00, 0x00, 0xff), signalAlphaLut(0));
   }
 
   // Draw "recent death" pheromone layer (layer 1) - red with alpha
-  if (data.signalLayers.size() > 1) {
-    for (int16_t x = 0; x < parameterMngrSingleton.gridSize_X; ++x) {
-      for (int16_t y = 0; y < parameterMngrSingleton.gridSize_Y; ++y) {
-        uint8_t intensity = data.signalLayers[1][x][y];
-        if (intensity > 0) {
-          // Red death marker with alpha
-          float alpha = static_cast<float>(intensity) / 255.0f;
-          uint8_t alphaVal = static_cast<uint8_t>(alpha * 255.0f);
-
-          renderBackend->drawRectangle(x - 1, y - 1, x + 1, y + 1, Color(0xff, 0x00, 0x00, alphaVal));
-        }
-      }
-    }
+  if (data.signalLayerCount > 1) {
+    backend.drawSignalLayer(data.signalLayer(1), data.sizeX, data.sizeY, Color(0xff, 0x00, 0x00), signalAlphaLut(1));
   }
 
-  // Draw barriers as gray rectangles
-  Color barrierColor(0x88, 0x88, 0x88, 0xff);  // Gray
-  for (const auto& loc : data.barrierLocs) {
-    renderBackend->drawRectangle(loc.x, loc.y, loc.x + 1, loc.y + 1, barrierColor);
-  }
+  // Draw barriers as gray rectangles, on top of the pheromone layers
+  backend.drawBarriers(data.barrierLocs, barrierColor);
 
   // Draw individuals as colored circles
-  constexpr uint8_t maxColorVal = 0xb0;
-  constexpr uint8_t maxLumaVal = 0xb0;
-
-  auto rgbToLuma = [](uint8_t r, uint8_t g, uint8_t b) { return (r + r + r + b + g + g + g + g) / 8; };
-
   for (size_t i = 0; i < data.indivLocs.size(); ++i) {
-    int c = data.indivColors[i];
-    uint8_t r = static_cast<uint8_t>(c);                // R: 0..255
-    uint8_t g = static_cast<uint8_t>((c & 0x1f) << 3);  // G: 0..255
-    uint8_t b = static_cast<uint8_t>((c & 7) << 5);     // B: 0..255
-
-    // Prevent color mappings to very bright colors (hard to see):
-    if (rgbToLuma(r, g, b) > maxLumaVal) {
-      if (r > maxColorVal)
-        r %= maxColorVal;
-      if (g > maxColorVal)
-        g %= maxColorVal;
-      if (b > maxColorVal)
-        b %= maxColorVal;
-    }
-
-    renderBackend->drawCircle(data.indivLocs[i].x, data.indivLocs[i].y, parameterMngrSingleton.agentSize,
-                              Color(r, g, b, 255));
+    backend.drawCircle(data.indivLocs[i].x, data.indivLocs[i].y, agentSize, agentColor(data.indivColors[i]));
   }
 
-  // Finalize frame (adds to backend's frame buffer)
-  renderBackend->endFrame();
+  // Finalize frame (adds it to the generation's video)
+  backend.endFrame();
 }
 
 /**
- * @brief Constructor initializing ImageWriter to idle state ready for async operations
+ * @brief Renders a captured frame through the first worker's render backend
  *
- * Initializes atomic flags and counters for thread-safe communication between the main
- * simulation thread and the optional async frame-saving thread (currently unused).
+ * Uses the run's stepsPerGeneration and agentSize; see renderFrame().
+ */
+void saveOneFrameImmed(const ImageFrameData& data) {
+  if (!primaryBackend) {
+    fmt::print(stderr, "Error: Render backend not initialized!\n");
+    return;
+  }
+  renderFrame(*primaryBackend, data, parameterMngrSingleton.stepsPerGeneration, parameterMngrSingleton.agentSize);
+}
+
+/**
+ * @brief Constructor initializing ImageWriter to synchronous, idle state
+ *
+ * @note The encoder pool is started by init(), not here
+ */
+ImageWriter::ImageWriter()
+    : frameBytes{0},
+      captureWorker{nullptr},
+      viewWidth{0},
+      viewHeight{0},
+      poolRunning{false},
+      stopRequested{false},
+      renderedFrames{0},
+      stalledFrames{0},
+      stallSeconds{0.0},
+      peakSlotsInUse{0},
+      poolSeconds{0.0} {}
+
+ImageWriter::~ImageWriter() {
+  shutdown();
+  primaryBackend = nullptr;
+}
+
+/**
+ * @brief Sizes all snapshot buffers once so that captureFrame() never allocates
  *
- * @note busy=true initially prevents premature job submission before init() is called
- * @note The async saveFrameThread() is not started automatically - currently unused
+ * @param layers Number of signal layers to snapshot
+ * @param gridSizeX Grid width in cells
+ * @param gridSizeY Grid height in cells
+ * @param population Upper bound on the number of individuals drawn
  */
-ImageWriter::ImageWriter() : droppedFrameCount{0}, busy{true}, dataReady{false}, abortRequested{false} {}
+void ImageFrameData::allocate(unsigned layers, uint16_t gridSizeX, uint16_t gridSizeY, unsigned population) {
+  sizeX = gridSizeX;
+  sizeY = gridSizeY;
+  signalLayerCount = layers;
+  signalData.assign(size_t(layers) * gridSizeX * gridSizeY, 0);
+  indivLocs.reserve(population);
+  indivColors.reserve(population);
+}
 
 /**
  * @brief Initializes the ImageWriter with grid dimensions and signal layer count
  *
- * Prepares the image writer for a new simulation run by creating the render backend
- * and initializing it with the simulation parameters.
+ * Prepares the image writer for a new simulation run: finishes the previous
+ * run's pipeline, creates one render backend (or trace writer) per encoder
+ * worker, sizes the frame slots and starts the workers when video is enabled
+ * in async mode.
+ *
+ * Slot count is videoQueueFrames per worker, reduced to what fits in
+ * videoEncodeMemoryMB but at least 2, so capture can overlap rendering.
+ * Sync mode uses one worker and one slot.
+ *
+ * With a region of interest (videoRoiWidth > 0, not in videoTrace mode),
+ * slots and backends are sized to the region, and each backend is told where
+ * the region lies so challenge zones stay anchored to the whole grid.
  *
- * @param layers Number of pheromone signal layers (typically 2: standard trails + death alarm) - unused, kept for API
- * compatibility
+ * @param layers Number of pheromone signal layers (typically 2: standard trails + death alarm)
  * @param sizeX Grid width in cells
  * @param sizeY Grid height in cells
  *
- * @note Called once at simulator startup from simulator() main function
- * @note Parameters are stored globally in parameterMngrSingleton, not cached locally
+ * @note Called once per run from simulator()
  */
 void ImageWriter::init(uint16_t layers, uint16_t sizeX, uint16_t sizeY) {
-  (void)layers;  // Unused parameter, kept for API compatibility
-  // Create and initialize the render backend
-  renderBackend = createDefaultRenderBackend();
-  if (renderBackend) {
-    renderBackend->init(sizeX, sizeY, parameterMngrSingleton.displayScale, parameterMngrSingleton.agentSize);
+  shutdown();
+
+  const auto& p = parameterMngrSingleton;
+  const bool async = p.saveVideo && p.videoAsync;
+  unsigned workerCount = async ? std::max(1u, p.videoEncodeWorkers) : 1;
+  if (workerCount > 1 && !p.videoTrace && p.renderBackend == "raylib") {
+    Logger::warning("The raylib backend is not thread-safe; encoding videos with one worker");
+    workerCount = 1;
+  }
+
+  policy.configure(p);
+  if (p.videoRoiWidth > 0 && p.videoRoiHeight > 0 && !p.videoTrace) {
+    viewOrigin = Coordinate(static_cast<int16_t>(p.videoRoiX), static_cast<int16_t>(p.videoRoiY));
+    viewWidth = static_cast<uint16_t>(p.videoRoiWidth);
+    viewHeight = static_cast<uint16_t>(p.videoRoiHeight);
   } else {
-    fmt::print(stderr, "Error: Failed to create render backend!\n");
+    viewOrigin = Coordinate(0, 0);
+    viewWidth = sizeX;
+    viewHeight = sizeY;
+  }
+
+  frameBytes = size_t(layers) * viewWidth * viewHeight + size_t(p.population) * (sizeof(Coordinate) + 1) +
+               grid.getBarrierLocations().capacity() * sizeof(Coordinate) + sizeof(ImageFrameData);
+  size_t slotCount = async ? size_t(std::max(1u, p.videoQueueFrames)) * workerCount : 1;
+  if (p.videoEncodeMemoryMB > 0) {
+    slotCount = std::min(slotCount, size_t(p.videoEncodeMemoryMB) * 1024 * 1024 / frameBytes);
+  }
+  slotCount = std::max<size_t>(async ? 2 : 1, slotCount);
+
+  frames.resize(slotCount);
+  freeSlots.clear();
+  for (unsigned slot = 0; slot < slotCount; ++slot) {
+    frames[slot].allocate(layers, viewWidth, viewHeight, p.population);
+    freeSlots.push_back(static_cast<unsigned>(slotCount - 1 - slot));  // Slot 0 is handed out first
+  }
+  renderedFrames = 0;
+  stalledFrames = 0;
+  stallSeconds = 0.0;
+  peakSlotsInUse = 0;
+  poolSeconds = 0.0;
+  poolStart = std::chrono::steady_clock::now();
+
+  // One render backend, or the trace writer that replaces it, per worker
+  Video::EncoderSettings encoderSettings;
+  parseEncoderProfile(p.videoEncoderProfile, encoderSettings.profile);  // Validated by ConfigManager
+  encoderSettings.threads = p.videoEncoderThreads;
+  workers.clear();
+  primaryBackend = nullptr;
+  for (unsigned w = 0; w < workerCount; ++w) {
+    auto worker = std::make_unique<Worker>();
+    if (p.videoTrace) {
+      worker->traceWriter = std::make_unique<Trace::TraceWriter>();
+    } else {
+      worker->backend = createRenderBackend(p.renderBackend);
+      if (!worker->backend) {
+        fmt::print(stderr, "Error: Failed to create render backend \"{}\"!\n", p.renderBackend);
+        break;
+      }
+      worker->backend->init(viewWidth, viewHeight, p.displayScale, p.agentSize);
+      worker->backend->setWorldView(sizeX, sizeY, viewOrigin.x, viewOrigin.y);
+      worker->backend->setOutputDirectory(p.imageDir);
+      worker->backend->setEncoderSettings(encoderSettings);
+    }
+    workers.push_back(std::move(worker));
+  }
+  if (!workers.empty()) {
+    primaryBackend = workers.front()->backend.get();
   }
   startNewGeneration();
+
+  if (!workers.empty() && async) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopRequested = false;
+    poolRunning = true;
+    for (auto& worker : workers) {
+      worker->thread = std::thread(&ImageWriter::renderLoop, this, std::ref(*worker));
+    }
+  }
 }
 
 /**
- * @brief Resets frame accumulator for a new generation's video output
+ * @brief Resets frame accumulators for a new generation's video output
  *
- * Clears the render backend's frame buffer and resets the skipped frame counter.
- * This must be called before capturing frames for a new generation to prevent
- * mixing frames from different generations in the same video file.
+ * Waits for the encoder pool to finish queued work, then clears every render
+ * backend's unfinished video. This prevents mixing frames from different
+ * generations in the same video file.
  *
- * @note Called automatically by init() and after saveGenerationVideo() completes
- * @note Does NOT clear droppedFrameCount (tracks drops across all generations)
+ * @note Called automatically by init(); generation boundaries go through saveGenerationVideo()
  */
 void ImageWriter::startNewGeneration() {
-  if (renderBackend) {
-    renderBackend->startNewGeneration();
+  flush();
+  for (auto& worker : workers) {
+    if (worker->backend) {
+      worker->backend->startNewGeneration();
+    }
+    if (worker->traceWriter) {
+      worker->traceWriter->abort();
+    }
   }
-  skippedFrames = 0;
+  captureWorker = nullptr;
 }
 
 /**
- * @brief Generates a deterministic 8-bit color value from an individual's genome
- *
- * Creates a pseudo-hash of the genome by extracting bit patterns from key gene properties
- * (first and last gene's source/sink types and indices). This produces visually distinct
- * colors for different genome structures while keeping the same color for clones.
- *
- * Bit layout (LSB to MSB):
- * - Bit 0: Genome length parity (odd=1, even=0)
- * - Bit 1: First gene source type
- * - Bit 2: Last gene source type
- * - Bit 3: First gene sink type
- * - Bit 4: Last gene sink type
- * - Bit 5: First gene source number (LSB only)
- * - Bit 6: First gene sink number (LSB only)
- * - Bit 7: Last gene source number (LSB only)
- *
- * @param genome The individual's genome (vector of Gene structs)
- * @return 8-bit color index value (0-255) used as seed for RGB color generation
- *
- * @note This is NOT a cryptographic hash - collisions are acceptable and visually tolerable
- * @note Color mapping to RGB occurs in saveOneFrameImmed() to prevent overly bright colors
- * @note Identical genomes (clones) will have identical colors, aiding visual tracking
- *
- * @see saveOneFrameImmed() for RGB color mapping from this 8-bit value
+ * @brief Copies the simulation state needed for one frame into a preallocated snapshot
+ *
+ * Signal layers are copied one grid column at a time with memcpy, and locations and
+ * colors are appended into vectors whose capacity was reserved by
+ * ImageFrameData::allocate(). Colors are the individuals' colorIndex, computed
+ * at birth, so no genome is read here.
+ *
+ * With a region of interest, individuals and barriers outside it are left out,
+ * the rest are translated by the region's origin, and each column copy starts
+ * at the region's first row.
+ *
+ * @see ImageWriter::captureFrame() in imageWriter.h for parameter documentation
  */
-uint8_t makeGeneticColor(const Genome& genome) {
-  return ((genome.size() & 1) | ((genome.front().sourceType) << 1) | ((genome.back().sourceType) << 2) |
-          ((genome.front().sinkType) << 3) | ((genome.back().sinkType) << 4) | ((genome.front().sourceNum & 1) << 5) |
-          ((genome.front().sinkNum & 1) << 6) | ((genome.back().sourceNum & 1) << 7));
+void ImageWriter::captureFrame(ImageFrameData& frame, unsigned simStep, unsigned generation, unsigned challenge,
+                               unsigned barrierType) {
+  const auto& p = parameterMngrSingleton;
+  const bool cropped = viewWidth > 0 && (viewWidth != p.gridSize_X || viewHeight != p.gridSize_Y);
+  const uint16_t width = cropped ? viewWidth : static_cast<uint16_t>(p.gridSize_X);
+  const uint16_t height = cropped ? viewHeight : static_cast<uint16_t>(p.gridSize_Y);
+  if (frame.signalLayerCount != p.signalLayers || frame.sizeX != width || frame.sizeY != height) {
+    frame.allocate(p.signalLayers, width, height, p.population);
+  }
+
+  frame.simStep = simStep;
+  frame.generation = generation;
+  frame.challenge = challenge;
+  frame.barrierType = barrierType;
+
+  frame.indivLocs.clear();
+  frame.indivColors.clear();
+  frame.barrierLocs.clear();
+  if (!cropped) {
+    for (unsigned index = 1; index <= p.population; ++index) {
+      const Individual& indiv = peeps[index];
+      if (indiv.alive) {
+        frame.indivLocs.push_back(indiv.loc);
+        frame.indivColors.push_back(indiv.colorIndex);
+      }
+    }
+    frame.barrierLocs.assign(grid.getBarrierLocations().begin(), grid.getBarrierLocations().end());
+  } else {
+    auto inView = [&](Coordinate loc) {
+      return loc.x >= viewOrigin.x && loc.x < viewOrigin.x + width && loc.y >= viewOrigin.y &&
+             loc.y < viewOrigin.y + height;
+    };
+    for (unsigned index = 1; index <= p.population; ++index) {
+      const Individual& indiv = peeps[index];
+      if (indiv.alive && inView(indiv.loc)) {
+        frame.indivLocs.push_back(indiv.loc - viewOrigin);
+        frame.indivColors.push_back(indiv.colorIndex);
+      }
+    }
+    for (const Coordinate& loc : grid.getBarrierLocations()) {
+      if (inView(loc)) {
+        frame.barrierLocs.push_back(loc - viewOrigin);
+      }
+    }
+  }
+
+  const int16_t firstColumn = cropped ? viewOrigin.x : 0;
+  const int16_t firstRow = cropped ? viewOrigin.y : 0;
+  uint8_t* cells = frame.signalData.data();
+  for (unsigned layerNum = 0; layerNum < frame.signalLayerCount; ++layerNum) {
+    for (int16_t x = 0; x < frame.sizeX; ++x) {
+      std::memcpy(cells, pheromones[layerNum][firstColumn + x].cells() + firstRow, frame.sizeY);
+      cells += frame.sizeY;
+    }
+  }
 }
 
 /**
- * @brief [UNUSED] Asynchronous gate for submitting frame render jobs to background thread
- *
- * This method was designed to queue frame rendering on a separate worker thread
- * (saveFrameThread()) to avoid blocking the simulation loop. However, it is currently
- * disabled due to threading bugs and race conditions (see IMAGEWRITER_INTEGRATION_GUIDE.md).
+ * @brief Queues one frame for its generation's worker, blocking only on backpressure
  *
- * Operational flow (when enabled):
- * 1. Check if saveFrameThread() is busy processing previous frame
- * 2. If idle, snapshot current simulation state into ImageFrameData
- * 3. Set dataReady flag and notify worker thread via condition variable
- * 4. Return true (job accepted) or false (busy, frame dropped)
- *
- * The busy flag uses atomic operations but relaxed memory ordering is sufficient because:
- * - Only one producer (this function) and one consumer (saveFrameThread())
- * - Frame drops are acceptable - no correctness issues from stale visibility
- * - Condition variable provides synchronization for dataReady flag
+ * The snapshot is taken on the calling thread, inside the serial end of step,
+ * so the workers never read peeps, grid or pheromones. The first frame of a
+ * generation picks the least loaded worker, and the rest of the generation
+ * follows it. If every slot still holds an unencoded frame, the caller waits
+ * for one to be freed instead of dropping the new frame. Waits are counted and
+ * reported by shutdown().
  *
  * @param simStep Current simulation step number (0 to stepsPerGeneration-1)
  * @param generation Current generation number (0 to numGenerations-1)
  * @param challenge Active challenge type enum (affects zone rendering)
  * @param barrierType Barrier pattern enum (affects barrier rendering)
  *
- * @return true if frame was queued successfully, false if worker thread was busy (frame dropped)
- *
- * @warning Currently DISABLED - use saveVideoFrameSync() instead
- * @warning Caller must not modify peeps, grid, or pheromones until this returns false
+ * @return true once the frame is queued (or rendered, in sync mode)
  *
- * @see saveVideoFrameSync() for the currently-used synchronous implementation
- * @see saveFrameThread() for the worker thread implementation
- * @see IMAGEWRITER_INTEGRATION_GUIDE.md for threading bug details
+ * @see renderLoop() for the consumer side
  */
 bool ImageWriter::saveVideoFrame(unsigned simStep, unsigned generation, unsigned challenge, unsigned barrierType) {
-  if (!busy) {
-    busy = true;
-    /// queue job for saveFrameThread()
-    /// We cache a local copy of data from params, grid, and peeps because
-    /// those objects will change by the main thread at the same time our
-    /// saveFrameThread() is using it to output a video frame.
-    data.simStep = simStep;
-    data.generation = generation;
-    data.challenge = challenge;
-    data.barrierType = barrierType;
-    data.indivLocs.clear();
-    data.indivColors.clear();
-    data.barrierLocs.clear();
-
-    for (uint16_t index = 1; index <= parameterMngrSingleton.population; ++index) {
-      const Individual& indiv = peeps[index];
-      if (indiv.alive) {
-        data.indivLocs.push_back(indiv.loc);
-        data.indivColors.push_back(makeGeneticColor(indiv.genome));
-      }
-    }
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!poolRunning) {
+    lock.unlock();
+    return saveVideoFrameSync(simStep, generation, challenge, barrierType);
+  }
 
-    /// Copy signal layers
-    for (unsigned layerNum = 0; layerNum < parameterMngrSingleton.signalLayers; ++layerNum) {
-      for (int16_t x = 0; x < parameterMngrSingleton.gridSize_X; ++x) {
-        for (int16_t y = 0; y < parameterMngrSingleton.gridSize_Y; ++y) {
-          data.signalLayers[layerNum][x][y] = pheromones[layerNum][x][y];
-        }
-      }
-    }
+  if (freeSlots.empty()) {
+    const auto waitStart = std::chrono::steady_clock::now();
+    progress.wait(lock, [&] { return !freeSlots.empty(); });
+    ++stalledFrames;
+    stallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStart).count();
+  }
 
-    auto const& barrierLocs = grid.getBarrierLocations();
-    for (Coordinate loc : barrierLocs) {
-      data.barrierLocs.push_back(loc);
-    }
+  // The slot is free, and only this thread writes it until it is queued
+  const unsigned slot = freeSlots.back();
+  freeSlots.pop_back();
+  peakSlotsInUse = std::max(peakSlotsInUse, frames.size() - freeSlots.size());
+  lock.unlock();
+  captureFrame(frames[slot], simStep, generation, challenge, barrierType);
+  lock.lock();
 
-    /// tell thread there's a job to do
-    {
-      std::lock_guard<std::mutex> lck(mutex_);
-      dataReady = true;
-    }
-    condVar.notify_one();
-    return true;
-  } else {
-    /// image saver thread is busy, drop a frame
-    ++droppedFrameCount;
-    return false;
+  if (!captureWorker) {
+    captureWorker = &pickWorker();
   }
+  captureWorker->jobs.push_back(Job{Job::Kind::FRAME, slot, generation});
+  lock.unlock();
+  workReady.notify_all();
+  return true;
 }
 
 /**
  * @brief Synchronously captures and renders a single video frame (blocking call)
  *
- * This is the actively-used frame capture method that snapshots the current simulation
- * state and immediately renders it to the imageList buffer. Unlike saveVideoFrame(),
- * this blocks the simulation loop until rendering completes (~1-5ms per frame depending
- * on population size and grid dimensions).
+ * Snapshots the current simulation state and immediately renders it on the
+ * calling thread with the first worker's backend. Used when videoAsync is off,
+ * and by saveVideoFrame() when the encoder pool is not running.
  *
  * Execution flow:
- * 1. Copy simulation state (individuals, pheromones, barriers) into ImageFrameData
- * 2. Call saveOneFrameImmed() to render frame and append to imageList
- * 3. Return control to caller (simulation can proceed to next step)
- *
- * Data copied from global singletons:
- * - peeps: alive individuals' locations and genome-based colors
- * - pheromones: all signal layers' intensity values [layer][x][y]
- * - grid: barrier location coordinates
+ * 1. captureFrame() into slot 0
+ * 2. Call processFrame() to render the frame (or append it to the trace)
+ * 3. Return control to caller
  *
  * @param simStep Current simulation step number (0 to stepsPerGeneration-1)
  * @param generation Current generation number (0 to numGenerations-1)
@@ -357,95 +486,142 @@ bool ImageWriter::saveVideoFrame(unsigned simStep, unsigned generation, unsigned
  *
  * @return Always true (frame is guaranteed to be captured)
  *
- * @note Blocking time scales with population and grid size (typically <5ms)
- * @note Called from endOfSimulationStep() when saveVideo=true in config
- * @note Memory allocation per call: ~O(population + gridSize_X * gridSize_Y * signalLayers)
- *
- * @see saveVideoFrame() for the unused async version
- * @see saveOneFrameImmed() for the actual rendering implementation
- * @see endOfSimulationStep() in simulator.cpp for the call site
+ * @note No allocation per call: all slots are sized in init(), and signal layers are
+ *       copied with one memcpy per grid column
  */
 bool ImageWriter::saveVideoFrameSync(unsigned simStep, unsigned generation, unsigned challenge, unsigned barrierType) {
-  /// We cache a local copy of data from params, grid, and peeps because
-  /// those objects will change by the main thread at the same time our
-  /// saveFrameThread() is using it to output a video frame.
-  data.simStep = simStep;
-  data.generation = generation;
-  data.challenge = challenge;
-  data.barrierType = barrierType;
-  data.indivLocs.clear();
-  data.indivColors.clear();
-  data.barrierLocs.clear();
-  data.signalLayers.clear();
-
-  for (uint16_t index = 1; index <= parameterMngrSingleton.population; ++index) {
-    const Individual& indiv = peeps[index];
-    if (indiv.alive) {
-      data.indivLocs.push_back(indiv.loc);
-      data.indivColors.push_back(makeGeneticColor(indiv.genome));
-    }
+  if (frames.empty()) {
+    frames.resize(1);
+  }
+  ImageFrameData& frame = frames[0];
+  captureFrame(frame, simStep, generation, challenge, barrierType);
+  if (!workers.empty()) {
+    processFrame(*workers.front(), frame);
+    ++workers.front()->frames;
   }
+  ++renderedFrames;
+  return true;
+}
 
-  /// Copy signal layers - note: pheromones uses Signals class [layer][x][y]
-  /// but we need to copy to simple vector structure
-  data.signalLayers.resize(parameterMngrSingleton.signalLayers);
-  for (unsigned layerNum = 0; layerNum < parameterMngrSingleton.signalLayers; ++layerNum) {
-    data.signalLayers[layerNum].resize(parameterMngrSingleton.gridSize_X);
-    for (int16_t x = 0; x < parameterMngrSingleton.gridSize_X; ++x) {
-      data.signalLayers[layerNum][x].resize(parameterMngrSingleton.gridSize_Y);
-      for (int16_t y = 0; y < parameterMngrSingleton.gridSize_Y; ++y) {
-        data.signalLayers[layerNum][x][y] = pheromones[layerNum][x][y];
+/**
+ * @brief Finishes the generation's video: queued behind its frames, or inline
+ *
+ * In async mode the encode runs on the generation's worker after its last
+ * frame, so the simulation continues with spawnNewGeneration() at once, and
+ * the next generation's frames go to whichever worker is least loaded. Capture
+ * only blocks if every slot fills up before a worker frees one.
+ *
+ * @param generation Generation number for filename construction (0 to numGenerations-1)
+ *
+ * @see encodeGeneration() for the encode itself
+ * @see endOfGeneration() in simulator.cpp for the call site
+ */
+void ImageWriter::saveGenerationVideo(unsigned generation) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (poolRunning) {
+      if (captureWorker) {
+        captureWorker->jobs.push_back(Job{Job::Kind::ENCODE, 0, generation});
+        captureWorker = nullptr;
+        workReady.notify_all();
       }
+      return;
     }
   }
-
-  auto const& barrierLocs = grid.getBarrierLocations();
-  for (Coordinate loc : barrierLocs) {
-    data.barrierLocs.push_back(loc);
+  if (!workers.empty()) {
+    encodeGeneration(*workers.front(), generation);
   }
+}
 
-  saveOneFrameImmed(data);
-  return true;
+/**
+ * @brief Worker for the next generation: an idle one if possible, else the shortest queue
+ *
+ * @note Caller holds mutex_
+ */
+ImageWriter::Worker& ImageWriter::pickWorker() {
+  Worker* best = workers.front().get();
+  for (auto& worker : workers) {
+    if (worker->jobs.size() + worker->busy < best->jobs.size() + best->busy) {
+      best = worker.get();
+    }
+  }
+  return *best;
 }
 
 /**
- * @brief Encodes accumulated frames into an AVI video file for the completed generation
+ * @brief Renders one captured frame, or appends it to the generation's trace
  *
- * This method is called at the end of each generation (after survival selection) to
- * compile all captured frames into a single video file using the render backend's
- * video encoding capabilities.
+ * In videoTrace mode the first frame of a generation opens
+ * imageDir/gen-NNNNNN.b4t; the trace stores the barrier mask once and then
+ * delta-encoded agent moves, so recording costs a few sequential writes per
+ * frame instead of a render and an encode.
+ *
+ * @param worker Worker whose backend or trace writer receives the frame
+ * @param frame Snapshot to render or record
+ *
+ * @note Runs on the worker's thread in async mode, on the caller otherwise
+ */
+void ImageWriter::processFrame(Worker& worker, const ImageFrameData& frame) {
+  const auto& p = parameterMngrSingleton;
+  if (!worker.traceWriter) {
+    if (worker.backend) {
+      renderFrame(*worker.backend, frame, p.stepsPerGeneration, static_cast<uint16_t>(p.agentSize));
+    }
+    return;
+  }
+
+  if (!worker.traceWriter->isOpen()) {
+    Trace::TraceInfo info;
+    info.stepsPerGeneration = p.stepsPerGeneration;
+    info.population = p.population;
+    info.displayScale = static_cast<uint16_t>(p.displayScale);
+    info.agentSize = static_cast<uint16_t>(p.agentSize);
+    info.signals = p.videoTraceSignals;
+    if (!worker.traceWriter->open(Trace::generationTracePath(p.imageDir, frame.generation), frame, info)) {
+      return;
+    }
+  }
+  worker.traceWriter->writeFrame(frame);
+}
+
+/**
+ * @brief Finishes the generation's AVI video file and resets the backend
  *
  * Video properties (backend-specific):
  * - Format: AVI container
- * - Codec: H264 (preferred) or backend-specific fallback
+ * - Codec: per videoEncoderProfile, H264 by default (see videoEncoder.h)
  * - Frame rate: 25 FPS (typical)
  * - Resolution: gridSize * displayScale pixels
- * - Filename: output/images/gen-NNNNNN.avi (6-digit zero-padded generation number)
+ * - Filename: output/images/gen-NNNNNN.avi (6-digit zero-padded generation number; .y4m for the raw profile)
  *
- * Encoding flow:
- * 1. Delegate to renderBackend->saveVideo() for encoding
- * 2. Report success/failure to stdout
- * 3. Clear frame buffer via startNewGeneration()
+ * @param worker Worker that rendered the generation's frames
+ * @param generation Generation number for filename construction
  *
- * @param generation Generation number for filename construction (0 to numGenerations-1)
+ * In videoTrace mode this finalizes the generation's trace instead.
  *
- * @note Encoding time varies by backend and frame count
- * @note Empty frame buffer is handled gracefully by backend
+ * @note Runs on the worker's thread in async mode, on the caller otherwise
  * @note Errors are logged but do not abort the simulation
- *
- * @warning Blocking operation - simulation pauses during video encoding
- *
- * @see startNewGeneration() for cleanup after encoding completes
- * @see endOfGeneration() in simulator.cpp for the call site
- * @see config/biosim4.ini parameters: saveVideo, videoStride, videoSaveFirstFrames
  */
-void ImageWriter::saveGenerationVideo(unsigned generation) {
-  if (!renderBackend) {
+void ImageWriter::encodeGeneration(Worker& worker, unsigned generation) {
+  if (worker.traceWriter) {
+    if (worker.traceWriter->isOpen()) {
+      const size_t frameCount = worker.traceWriter->frameCount();
+      const uint64_t bytes = worker.traceWriter->bytesWritten();
+      if (worker.traceWriter->close()) {
+        ++worker.videos;
+        Logger::info("Trace saved: {} ({} frames, {:.1f} KiB)", worker.traceWriter->path(), frameCount,
+                     bytes / 1024.0);
+      }
+    }
+    return;
+  }
+
+  if (!worker.backend) {
     fmt::print(stderr, "Error: Render backend not initialized!\n");
     return;
   }
 
-  size_t frameCount = renderBackend->getFrameCount();
+  size_t frameCount = worker.backend->getFrameCount();
   if (frameCount > 0) {
     std::string imgDir = parameterMngrSingleton.imageDir;
     // Add trailing slash if not present
@@ -455,97 +631,150 @@ void ImageWriter::saveGenerationVideo(unsigned generation) {
 
     fmt::print("Encoding {} frames for generation {}\n", frameCount, generation);
 
-    bool success = renderBackend->saveVideo(generation, imgDir);
+    bool success = worker.backend->saveVideo(generation, imgDir);
 
     if (success) {
+      ++worker.videos;
       fmt::print("Video saved successfully\n");
     } else {
       fmt::print(stderr, "Error: Failed to save video for generation {}\n", generation);
     }
   }
-  startNewGeneration();
+  worker.backend->startNewGeneration();
 }
 
 /**
- * @brief [UNUSED] Signals the async worker thread to terminate gracefully
- *
- * This method was designed to cleanly shutdown the saveFrameThread() background worker
- * by setting the abortRequested flag and waking the thread via condition variable.
- * The worker checks this flag and exits its loop when true.
+ * @brief Waits until every worker has processed every queued job
  *
- * @note Currently unused because async threading is disabled
- * @note If re-enabled, call this before ImageWriter destruction to prevent orphaned threads
+ * Returns immediately in sync mode.
+ */
+void ImageWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  progress.wait(lock, [&] {
+    return !poolRunning || std::all_of(workers.begin(), workers.end(),
+                                       [](const auto& worker) { return worker->jobs.empty() && !worker->busy; });
+  });
+}
+
+/**
+ * @brief Drains the pool, joins the encoder threads and reports throughput
  *
- * @see saveFrameThread() for the worker thread that responds to this signal
+ * Called at the end of every simulator() run so that all videos are complete
+ * before the run returns.
  */
-void ImageWriter::abort() {
-  busy = true;
-  abortRequested = true;
+void ImageWriter::shutdown() {
   {
-    std::lock_guard<std::mutex> lck(mutex_);
-    dataReady = true;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!poolRunning) {
+      return;
+    }
+    stopRequested = true;
+  }
+  workReady.notify_all();
+  for (auto& worker : workers) {
+    worker->thread.join();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  poolRunning = false;
+  poolSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - poolStart).count();
+  progress.notify_all();
+
+  const Core::Simulation::VideoPipelineStats stats = pipelineStatsLocked();
+  Logger::info(
+      "Video pipeline: {} workers, {} frames in {} videos ({:.1f} frames/s, {:.0f}% busy), peak buffer {:.1f} of {} "
+      "MiB ({} slots), {} captures waited {:.3f}s for a free slot",
+      stats.workers, stats.frames, stats.videos, stats.framesPerSecond(), stats.utilization() * 100.0,
+      stats.peakBufferedBytes / (1024.0 * 1024.0), stats.memoryBudgetBytes / (1024 * 1024), stats.slots,
+      stats.stalledCaptures, stats.stallSeconds);
+  if (stats.skippedSteps > 0) {
+    Logger::info("Frame sampling: {} steps skipped, {} frames added by capture triggers", stats.skippedSteps,
+                 stats.triggeredFrames);
   }
-  condVar.notify_one();
+}
+
+uint64_t ImageWriter::renderedFrameCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return renderedFrames;
+}
+
+uint64_t ImageWriter::stalledFrameCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stalledFrames;
+}
+
+Core::Simulation::VideoPipelineStats ImageWriter::pipelineStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pipelineStatsLocked();
 }
 
 /**
- * @brief [UNUSED] Background worker thread for asynchronous frame rendering
- *
- * This thread implementation was designed to offload frame rendering from the main
- * simulation loop, allowing the simulator to proceed to the next step while the
- * previous frame is still being rendered. However, it is currently disabled due to
- * race conditions and synchronization bugs (see IMAGEWRITER_INTEGRATION_GUIDE.md).
- *
- * Intended operation:
- * 1. Wait on condition variable until saveVideoFrame() signals a new job
- * 2. Check abortRequested flag for graceful shutdown
- * 3. Render frame from cached ImageFrameData via saveOneFrameImmed()
- * 4. Clear busy flag to signal readiness for next frame
- * 5. Loop back to wait state
- *
- * Synchronization mechanism:
- * - Condition variable (condVar) for efficient thread wake-up
- * - Mutex (mutex_) protecting dataReady flag
- * - Atomic busy flag for job acceptance gate (lock-free check in saveVideoFrame())
- * - ImageFrameData snapshot copied before thread wake-up to avoid data races
- *
- * Known issues preventing usage:
- * - Race conditions when simulation modifies peeps/grid during frame copy
- * - Inconsistent frame timing causing dropped frames
- * - Memory visibility issues with relaxed atomic ordering
- * - Condition variable spurious wake-ups not properly handled
+ * @brief Pool statistics; caller holds mutex_
+ */
+Core::Simulation::VideoPipelineStats ImageWriter::pipelineStatsLocked() const {
+  Core::Simulation::VideoPipelineStats stats;
+  stats.workers = poolRunning || poolSeconds > 0.0 ? static_cast<unsigned>(workers.size()) : 0;
+  stats.slots = static_cast<unsigned>(frames.size());
+  stats.frames = renderedFrames;
+  stats.skippedSteps = policy.skippedSteps();
+  stats.triggeredFrames = policy.triggeredFrames();
+  for (const auto& worker : workers) {
+    stats.videos += worker->videos;
+    stats.busySeconds += worker->busySeconds;
+  }
+  stats.wallSeconds =
+      poolRunning ? std::chrono::duration<double>(std::chrono::steady_clock::now() - poolStart).count() : poolSeconds;
+  stats.stalledCaptures = stalledFrames;
+  stats.stallSeconds = stallSeconds;
+  stats.peakBufferedBytes = uint64_t(peakSlotsInUse) * frameBytes;
+  stats.memoryBudgetBytes = uint64_t(parameterMngrSingleton.videoEncodeMemoryMB) * 1024 * 1024;
+  return stats;
+}
+
+/**
+ * @brief Encoder thread: processes one worker's frame and encode jobs in capture order
  *
- * @warning Do not call directly - this is a thread entry point
- * @warning Currently disabled - synchronous rendering via saveVideoFrameSync() is used instead
+ * The thread owns its worker's render backend (or trace writer) while it
+ * runs. A FRAME job renders one slot and then frees it, waking a capture
+ * blocked on backpressure. An ENCODE job finishes the generation's video.
+ * The loop exits once a stop is requested and the worker's queue is empty,
+ * so no queued work is lost.
+ *
+ * @param worker The worker this thread serves
  *
- * @see saveVideoFrame() for the job submission gate
- * @see saveVideoFrameSync() for the currently-active synchronous implementation
- * @see abort() for graceful thread termination
- * @see doc/IMAGEWRITER_INTEGRATION_GUIDE.md for detailed bug analysis
+ * @warning Do not call directly - this is a thread entry point
  */
-void ImageWriter::saveFrameThread() {
-  busy = false;  ///< we're ready for business
-  fmt::print("Imagewriter thread started.\n");
-
+void ImageWriter::renderLoop(Worker& worker) {
+  std::unique_lock<std::mutex> lock(mutex_);
   while (true) {
-    /// wait for job on queue
-    std::unique_lock<std::mutex> lck(mutex_);
-    condVar.wait(lck, [&] { return dataReady && busy; });
-    /// save frame
-    dataReady = false;
-    busy = false;
-
-    if (abortRequested) {
-      break;
+    workReady.wait(lock, [&] { return stopRequested || !worker.jobs.empty(); });
+    if (worker.jobs.empty()) {
+      break;  // Stop requested and nothing left to do
     }
 
-    /// save image frame
-    saveOneFrameImmed(imageWriter.data);
+    const Job job = worker.jobs.front();
+    worker.jobs.pop_front();
+    worker.busy = true;
+    lock.unlock();
 
-    /// fmt::print("Image writer thread waiting...\n");
-    /// std::this_thread::sleep_for(std::chrono::seconds(2));
+    const auto jobStart = std::chrono::steady_clock::now();
+    if (job.kind == Job::Kind::FRAME) {
+      processFrame(worker, frames[job.slot]);
+    } else {
+      encodeGeneration(worker, job.generation);
+    }
+    const double jobSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - jobStart).count();
+
+    lock.lock();
+    if (job.kind == Job::Kind::FRAME) {
+      freeSlots.push_back(job.slot);
+      ++worker.frames;
+      ++renderedFrames;
+    }
+    worker.busySeconds += jobSeconds;
+    worker.busy = false;
+    progress.notify_all();
   }
-  fmt::print("Image writer thread exiting.\n");
 }
 
 // Global ImageWriter singleton instance
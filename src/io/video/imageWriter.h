@@ -6,19 +6,21 @@
  * @brief Video frame generation and movie assembly for evolution simulation visualization.
  *
  * This module handles the creation of graphic frames for each simulation step and
- * assembles them into video files at the end of each generation. It supports both
- * synchronous and asynchronous (threaded) frame capture modes.
- *
- * @note Async threading exists but is currently disabled due to bugs.
- * See doc/IMAGEWRITER_INTEGRATION_GUIDE.md for details.
+ * assembles them into video files at the end of each generation. Frames are
+ * captured on the simulation thread and, by default, rendered and encoded on a
+ * pipelined render thread (see ImageWriter).
  */
 
 #include "../../core/agents/indiv.h"
 #include "../../core/agents/peeps.h"
+#include "../../core/simulation/simulationStats.h"
 #include "../../types/params.h"
+#include "capturePolicy.h"
 
-#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -26,6 +28,13 @@
 namespace BioSim {
 inline namespace v1 {
 namespace IO {
+namespace Render {
+class IRenderBackend;
+struct Color;
+}
+namespace Trace {
+class TraceWriter;
+}
 namespace Video {
 
 /**
@@ -37,18 +46,34 @@ namespace Video {
  * main simulation loop. This allows the simulation to proceed to the next step
  * while the previous frame is being written to disk.
  *
- * @note Currently used in synchronous mode only due to threading bugs.
+ * All signal layers live in one flat buffer with the same column-major layout
+ * as Signals, so a snapshot is one memcpy per grid column. After allocate(),
+ * repeated snapshots into the same frame do not allocate.
+ *
  */
 struct ImageFrameData {
-  unsigned simStep;                                       ///< Current step number within the generation
-  unsigned generation;                                    ///< Current generation number
-  unsigned challenge;                                     ///< Active challenge/selection criterion ID
-  unsigned barrierType;                                   ///< Type of barrier in the environment (if any)
-  std::vector<Coordinate> indivLocs;                      ///< Locations of all individuals in the grid
-  std::vector<uint8_t> indivColors;                       ///< Color values for each individual (visualization)
-  std::vector<Coordinate> barrierLocs;                    ///< Locations of barrier cells in the grid
-  typedef std::vector<std::vector<uint8_t>> SignalLayer;  ///< 2D signal layer [x][y]
-  std::vector<SignalLayer> signalLayers;                  ///< All pheromone/signal layers [layer][x][y]
+  unsigned simStep = 0;                 ///< Current step number within the generation
+  unsigned generation = 0;              ///< Current generation number
+  unsigned challenge = 0;               ///< Active challenge/selection criterion ID
+  unsigned barrierType = 0;             ///< Type of barrier in the environment (if any)
+  std::vector<Coordinate> indivLocs;    ///< Locations of all individuals in the grid
+  std::vector<uint8_t> indivColors;     ///< Color index of each individual (see agentColor())
+  std::vector<Coordinate> barrierLocs;  ///< Locations of barrier cells in the grid
+  uint16_t sizeX = 0;                   ///< Grid width of the signal snapshot
+  uint16_t sizeY = 0;                   ///< Grid height of the signal snapshot
+  unsigned signalLayerCount = 0;        ///< Number of layers in signalData
+  std::vector<uint8_t> signalData;      ///< All signal layers, flattened [layer][x][y]
+
+  /**
+   * @brief Size the buffers for a grid and population so snapshots do not allocate
+   */
+  void allocate(unsigned layers, uint16_t gridSizeX, uint16_t gridSizeY, unsigned population);
+
+  /** @brief First cell of one layer; cell (x, y) is at offset x * sizeY + y */
+  const uint8_t* signalLayer(unsigned layer) const { return signalData.data() + size_t(layer) * sizeX * sizeY; }
+
+  /** @brief Signal magnitude of one cell */
+  uint8_t signal(unsigned layer, int16_t x, int16_t y) const { return signalLayer(layer)[size_t(x) * sizeY + y]; }
 };
 
 /**
@@ -56,21 +81,42 @@ struct ImageFrameData {
  * @brief Manages video frame capture and movie generation for simulation visualization.
  *
  * The ImageWriter creates visual representations of each simulation step and assembles
- * them into video files at the end of each generation. It buffers frame data and supports
- * both synchronous (blocking) and asynchronous (threaded) capture modes.
+ * them into video files at the end of each generation.
  *
  * @par Threading Model
- * The class includes infrastructure for asynchronous frame writing using a dedicated
- * worker thread. However, this functionality is currently disabled due to bugs.
- * Use saveVideoFrameSync() for synchronous, blocking frame capture.
+ * With videoAsync enabled (the default), capture and encoding are pipelined. The
+ * simulation thread snapshots each frame into a free preallocated ImageFrameData slot
+ * and returns. A pool of videoEncodeWorkers encoder threads, each with its own render
+ * backend, draws and encodes the slots. All frames of one generation go to the same
+ * worker, in order; the next generation goes to the least loaded worker. Several
+ * generations are therefore encoded at once, and a generation never waits for the
+ * previous generation's video to be finished. No frame is ever dropped. When every slot
+ * is still waiting to be encoded, saveVideoFrame() blocks until one is free
+ * (backpressure), and the time spent waiting is counted.
  *
- * @par Usage Pattern
- * 1. Call init() once at startup with grid dimensions
- * 2. Call startNewGeneration() at the beginning of each generation
- * 3. Call saveVideoFrameSync() for each simulation step to capture
- * 4. Call saveGenerationVideo() at generation end to create the movie file
+ * There are videoQueueFrames slots per worker, but never more than fit in
+ * videoEncodeMemoryMB. A backend is only touched by its worker while the pool runs.
+ * With videoAsync disabled, the first worker's backend is used inline on the calling
+ * thread. The raylib backend is not thread-safe, so it always runs one worker.
+ *
+ * @par Trace Recording
+ * With videoTrace enabled, no backend is created. Each frame is appended to a
+ * compact trace (imageDir/gen-NNNNNN.b4t, see traceFormat.h) on the same
+ * pipeline, and saveGenerationVideo() finalizes the trace instead of encoding.
+ * biosim4-render turns traces into videos later.
  *
- * @see doc/IMAGEWRITER_INTEGRATION_GUIDE.md for implementation details
+ * @par Frame Sampling and Region of Interest
+ * endOfSimulationStep() asks capturePolicy() whether a step becomes a frame
+ * (videoFrameStride, videoDeathTrigger, videoSurvivorTrigger). With videoRoiWidth
+ * and videoRoiHeight set, captureFrame() keeps only that rectangle of the grid, so
+ * slots, render buffers and videos shrink to it. Traces always hold the whole grid.
+ *
+ * @par Usage Pattern
+ * 1. Call init() once per run with grid dimensions (starts the encoder pool)
+ * 2. Call saveVideoFrame() for each simulation step to capture
+ * 3. Call saveGenerationVideo() at generation end to create the movie file
+ * 4. Call shutdown() at the end of the run to finish all pending videos
+ * 5. Read pipelineStats() for the pool's throughput
  */
 struct ImageWriter {
   /**
@@ -78,11 +124,21 @@ struct ImageWriter {
    */
   ImageWriter();
 
+  /**
+   * @brief Finishes pending work and joins the encoder threads.
+   */
+  ~ImageWriter();
+
+  ImageWriter(const ImageWriter&) = delete;
+  ImageWriter& operator=(const ImageWriter&) = delete;
+
   /**
    * @brief Initialize the image writer with simulation grid dimensions.
    *
-   * Must be called once before any frame capture operations. Sets up internal
-   * buffers and prepares the writer for frame capture operations.
+   * Must be called once per run before any frame capture. Shuts down the
+   * pipeline of a previous run, creates one render backend per worker, sizes
+   * the frame slots and, if videoAsync and saveVideo are set, starts the
+   * encoder threads.
    *
    * @param layers Number of signal/pheromone layers to visualize
    * @param sizeX Width of the simulation grid in cells
@@ -91,104 +147,189 @@ struct ImageWriter {
   void init(uint16_t layers, uint16_t sizeX, uint16_t sizeY);
 
   /**
-   * @brief Reset frame buffers at the start of a new generation.
+   * @brief Reset video state at the start of a new generation.
    *
-   * Clears any accumulated frame data from the previous generation and
-   * prepares the writer for a new sequence of frames.
+   * Waits for the pipeline to go idle, then discards the backends' unfinished
+   * videos.
    */
   void startNewGeneration();
 
   /**
-   * @brief Asynchronously capture a video frame (CURRENTLY DISABLED).
+   * @brief Capture a video frame (RECOMMENDED).
    *
-   * This method queues frame data for asynchronous writing by the worker thread.
-   * However, async mode is currently disabled due to threading bugs.
-   * Use saveVideoFrameSync() instead.
+   * Snapshots the simulation state into a free slot and queues it for the
+   * worker that encodes this generation. Blocks only if every slot is still
+   * waiting to be encoded. Falls back to saveVideoFrameSync() when the encoder
+   * pool is not running.
    *
-   * @param simStep Current simulation step number
+   * @param simStep Current simulation step number within the generation
    * @param generation Current generation number
    * @param challenge Active challenge/selection criterion ID
-   * @param barrierType Type of environmental barrier (if any)
-   * @return true if frame was successfully queued, false if busy/dropped
+   * @param barrierType Type of environmental barrier configuration
+   * @return true once the frame is queued or rendered
    *
-   * @warning Do not use - async threading is disabled. Use saveVideoFrameSync().
-   * @see saveVideoFrameSync()
+   * @note Respects videoStride and videoSaveFirstFrames config parameters (at the call site).
    */
   bool saveVideoFrame(unsigned simStep, unsigned generation, unsigned challenge, unsigned barrierType);
 
   /**
-   * @brief Synchronously capture a video frame (RECOMMENDED).
-   *
-   * Captures the current simulation state as a video frame in blocking mode.
-   * This is the preferred method as async threading is currently disabled.
-   * Snapshots grid state, individual locations, and signal layers, then
-   * renders and buffers the frame for later video assembly.
+   * @brief Synchronously capture and render a video frame on the calling thread.
    *
    * @param simStep Current simulation step number within the generation
    * @param generation Current generation number
    * @param challenge Active challenge/selection criterion ID
    * @param barrierType Type of environmental barrier configuration
-   * @return true if frame was successfully captured and buffered
+   * @return true if frame was successfully captured and rendered
    *
-   * @note Respects videoStride and videoSaveFirstFrames config parameters.
+   * @warning Must not be called while the encoder pool is running.
    */
   bool saveVideoFrameSync(unsigned simStep, unsigned generation, unsigned challenge, unsigned barrierType);
 
   /**
-   * @brief Assemble buffered frames into a generation video file.
+   * @brief Assemble the generation's frames into a video file.
    *
-   * Processes all captured frames from the current generation and creates
-   * an AVI video file in output/images/. Clears frame buffers after completion.
+   * In async mode this queues the encode behind the generation's frames on
+   * their worker and returns immediately; the next generation's frames go to
+   * the least loaded worker. Otherwise it finishes the video inline. Either
+   * way, the backend is reset for the next generation afterwards.
    *
    * @param generation Generation number (used in output filename)
    *
-   * @note Output filename format: output/images/gen-NNNN.avi
-   * @note Video codec and format controlled by OpenCV configuration
+   * @note Output filename format: output/images/gen-NNNNNN.avi
    */
   void saveGenerationVideo(unsigned generation);
 
   /**
-   * @brief Request immediate termination of async frame writing thread.
-   *
-   * Signals the worker thread to abort any pending operations and exit cleanly.
-   * Only relevant if async mode were enabled.
-   *
-   * @note Currently has no effect since async threading is disabled.
+   * @brief Block until every queued frame and video has been processed.
    */
-  void abort();
+  void flush();
 
   /**
-   * @brief Worker thread main loop for asynchronous frame writing.
-   *
-   * This method runs in a separate thread and processes frame data from the
-   * queue when available. Currently not used as async mode is disabled.
+   * @brief Drain the pool, stop the encoder threads and log pipeline statistics.
    *
-   * @warning Internal implementation - do not call directly.
+   * Safe to call repeatedly; the writer falls back to synchronous mode afterwards.
    */
-  void saveFrameThread();
+  void shutdown();
+
+  /** @brief Throughput of the pipeline since init(); complete once shutdown() returned */
+  Core::Simulation::VideoPipelineStats pipelineStats() const;
 
   /**
-   * @brief Count of frames dropped due to thread being busy.
+   * @brief Snapshot the current simulation state into a frame.
    *
-   * Tracks how many frames were skipped because the async writer thread
-   * couldn't keep up with the simulation rate. Should remain zero in
-   * synchronous mode.
+   * Copies live individuals' locations and colors, barrier locations and all
+   * signal layers. Colors are each individual's colorIndex, fixed at birth.
+   * With a region of interest, only its cells are copied, translated so that
+   * the region starts at (0, 0).
    *
-   * @note Atomic to allow safe concurrent access from multiple threads.
+   * @param frame Destination; reuses its capacity (see ImageFrameData::allocate())
+   * @param simStep Current simulation step number within the generation
+   * @param generation Current generation number
+   * @param challenge Active challenge/selection criterion ID
+   * @param barrierType Type of environmental barrier configuration
    */
-  std::atomic<unsigned> droppedFrameCount;
+  void captureFrame(ImageFrameData& frame, unsigned simStep, unsigned generation, unsigned challenge,
+                    unsigned barrierType);
+
+  /** @brief Which steps of a recorded generation are captured; configured by init() */
+  CapturePolicy& capturePolicy() { return policy; }
+
+  /** @brief Frames rendered since init() */
+  uint64_t renderedFrameCount() const;
+
+  /** @brief Captures that had to wait for a free slot since init() */
+  uint64_t stalledFrameCount() const;
 
  private:
-  std::atomic<bool> busy;           ///< Flag indicating worker thread is processing a frame
-  std::mutex mutex_;                ///< Protects shared data access between threads
-  std::condition_variable condVar;  ///< Signals worker thread when new data is available
-  bool dataReady;                   ///< Flag indicating new frame data is queued
-
-  ImageFrameData data;     ///< Cached frame data for async processing
-  bool abortRequested;     ///< Flag to signal worker thread to terminate
-  unsigned skippedFrames;  ///< Internal counter for frames skipped during async mode
+  /**
+   * @struct Job
+   * @brief One unit of work for an encoder worker, processed in FIFO order
+   */
+  struct Job {
+    enum class Kind { FRAME, ENCODE };
+    Kind kind;            ///< Render a slot, or encode the frames rendered so far
+    unsigned slot;        ///< Slot to render (FRAME)
+    unsigned generation;  ///< Generation number for the file name (ENCODE)
+  };
+
+  /**
+   * @struct Worker
+   * @brief One encoder thread with its own backend (or trace writer) and queue
+   */
+  struct Worker {
+    std::unique_ptr<Render::IRenderBackend> backend;  ///< Draws and encodes this worker's generations
+    std::unique_ptr<Trace::TraceWriter> traceWriter;  ///< Set in videoTrace mode instead of a render backend
+    std::deque<Job> jobs;                             ///< Pending work in capture order
+    std::thread thread;                               ///< Encoder thread (async mode only)
+    bool busy = false;                                ///< Processing a job
+    uint64_t frames = 0;                              ///< Frames rendered since init()
+    uint64_t videos = 0;                              ///< Videos (or traces) finished since init()
+    double busySeconds = 0.0;                         ///< Time spent processing jobs since init()
+  };
+
+  void renderLoop(Worker& worker);
+  void processFrame(Worker& worker, const ImageFrameData& frame);
+  void encodeGeneration(Worker& worker, unsigned generation);
+  Worker& pickWorker();
+  Core::Simulation::VideoPipelineStats pipelineStatsLocked() const;
+
+  std::vector<ImageFrameData> frames;            ///< Preallocated snapshots
+  std::vector<unsigned> freeSlots;               ///< Slots not waiting to be encoded
+  size_t frameBytes;                             ///< Estimated size of one snapshot, for the memory budget
+  std::vector<std::unique_ptr<Worker>> workers;  ///< Encoder pool; workers[0] also serves sync mode
+  Worker* captureWorker;                         ///< Worker of the generation being captured (null between generations)
+  CapturePolicy policy;                          ///< Frame sampling within a generation
+  Coordinate viewOrigin;                         ///< Grid cell drawn at the bottom-left of each frame
+  uint16_t viewWidth;                            ///< Captured columns (0 = not initialized, whole grid)
+  uint16_t viewHeight;                           ///< Captured rows
+
+  mutable std::mutex mutex_;          ///< Guards the job queues, counters and flags below
+  std::condition_variable workReady;  ///< Jobs queued or stop requested
+  std::condition_variable progress;   ///< A slot was freed or a worker went idle
+  bool poolRunning;                   ///< Encoder threads started and not yet joined
+  bool stopRequested;                 ///< Workers should exit once their queues are empty
+
+  uint64_t renderedFrames;                          ///< Frames rendered since init()
+  uint64_t stalledFrames;                           ///< Captures that waited for a free slot
+  double stallSeconds;                              ///< Total time captures waited for a free slot
+  size_t peakSlotsInUse;                            ///< Most slots waiting to be encoded at once
+  std::chrono::steady_clock::time_point poolStart;  ///< When init() started the pool
+  double poolSeconds;                               ///< Pool lifetime, set by shutdown()
 };
 
+/**
+ * @brief Render one captured frame through the active render backend.
+ *
+ * Exposed for benchmarks; simulation code goes through ImageWriter.
+ *
+ * @param data Snapshot of the simulation state to draw
+ */
+void saveOneFrameImmed(const ImageFrameData& data);
+
+/**
+ * @brief Render one frame through the given backend.
+ *
+ * Does not read the simulation or its parameters, so traces can be rendered
+ * offline (biosim4-render) and from several threads with one backend each.
+ *
+ * @param backend Backend that draws and encodes the frame
+ * @param data Snapshot to draw
+ * @param stepsPerGeneration Steps per generation (radioactive wall switch)
+ * @param agentSize Agent circle radius in pixels
+ */
+void renderFrame(Render::IRenderBackend& backend, const ImageFrameData& data, unsigned stepsPerGeneration,
+                 uint16_t agentSize);
+
+/**
+ * @brief Drawing color of an individual's color index (Individual::colorIndex).
+ *
+ * The index is spread over RGB, and colors too bright to see on the white
+ * background are darkened. All 256 colors are computed once per process.
+ */
+const Render::Color& agentColor(uint8_t colorIndex);
+
+using Core::Genetics::makeGeneticColor;
+
 /**
  * @brief Global singleton instance of the ImageWriter.
  *
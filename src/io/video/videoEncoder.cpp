@@ -0,0 +1,316 @@
+/**
+ * @file videoEncoder.cpp
+ * @brief Implementation of the streaming FFmpeg video encoder
+ */
+
+#include "videoEncoder.h"
+
+#include "../../utils/logger.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cerrno>
+#include <cstdio>
+
+// FFmpeg includes (C API, use extern "C")
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/opt.h>
+#include <libswscale/swscale.h>
+}
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+
+using Utils::Logger;
+
+namespace {
+
+constexpr int FRAMES_PER_SECOND = 25;
+
+/**
+ * @brief Config name and libx264 preset of each profile
+ */
+struct ProfileSpec {
+  EncoderProfile profile;
+  const char* name;
+  const char* preset;
+};
+
+constexpr ProfileSpec PROFILES[] = {
+    {EncoderProfile::MEDIUM, "medium", "medium"},
+    {EncoderProfile::SUPERFAST, "superfast", "superfast"},
+    {EncoderProfile::ULTRAFAST, "ultrafast", "ultrafast"},
+    {EncoderProfile::LOSSLESS, "lossless", "medium"},
+    {EncoderProfile::RAW, "raw", nullptr},
+};
+
+const ProfileSpec& profileSpec(EncoderProfile profile) {
+  for (const auto& spec : PROFILES) {
+    if (spec.profile == profile) {
+      return spec;
+    }
+  }
+  return PROFILES[0];
+}
+
+}  // namespace
+
+bool parseEncoderProfile(const std::string& name, EncoderProfile& profile) {
+  for (const auto& spec : PROFILES) {
+    if (name == spec.name) {
+      profile = spec.profile;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char* encoderProfileName(EncoderProfile profile) {
+  return profileSpec(profile).name;
+}
+
+const char* videoFileExtension(EncoderProfile profile) {
+  return profile == EncoderProfile::RAW ? ".y4m" : ".avi";
+}
+
+std::string generationVideoPath(const std::string& directory, unsigned generation, EncoderProfile profile) {
+  const char* separator = !directory.empty() && directory.back() == '/' ? "" : "/";
+  return fmt::format("{}{}gen-{:06}{}", directory, separator, generation, videoFileExtension(profile));
+}
+
+VideoEncoder::~VideoEncoder() {
+  if (isOpen()) {
+    close();
+  }
+}
+
+bool VideoEncoder::open(const std::string& path, int width, int height) {
+  if (isOpen()) {
+    abort();
+  }
+  path_ = path;
+  width_ = width;
+  height_ = height;
+  frameCount_ = 0;
+
+  // Pick the codec, pixel format and container of the profile
+  const ProfileSpec& spec = profileSpec(settings_.profile);
+  const char* container = "avi";
+  AVPixelFormat pixelFormat = AV_PIX_FMT_YUV420P;
+  const AVCodec* codec = nullptr;
+  if (settings_.profile == EncoderProfile::RAW) {
+    // The Y4M muxer takes frames as they are; no codec touches the pixels
+    codec = avcodec_find_encoder(AV_CODEC_ID_WRAPPED_AVFRAME);
+    container = "yuv4mpegpipe";
+  } else if (settings_.profile == EncoderProfile::LOSSLESS) {
+    // Encode RGB as is: converting to YUV rounds, and frames would no longer round-trip
+    codec = avcodec_find_encoder_by_name("libx264rgb");
+    pixelFormat = AV_PIX_FMT_BGR0;
+    if (!codec) {
+      codec = avcodec_find_encoder(AV_CODEC_ID_FFV1);
+      pixelFormat = AV_PIX_FMT_GBRP;
+      Logger::info("Using FFV1 codec for lossless video (libx264rgb not available)");
+    }
+  } else {
+    codec = avcodec_find_encoder(AV_CODEC_ID_H264);
+    if (!codec) {
+      // Fallback to MPEG4 if H264 not available
+      codec = avcodec_find_encoder(AV_CODEC_ID_MPEG4);
+      if (codec) {
+        Logger::info("Using MPEG-4 codec (H.264 not available)");
+      }
+    }
+  }
+  if (!codec) {
+    Logger::error("No suitable video codec found for the {} encoder profile", spec.name);
+    return false;
+  }
+
+  codecCtx_ = avcodec_alloc_context3(codec);
+  if (!codecCtx_) {
+    Logger::error("Could not allocate codec context");
+    return false;
+  }
+
+  // Configure codec parameters
+  codecCtx_->width = width;
+  codecCtx_->height = height;
+  codecCtx_->time_base = {1, FRAMES_PER_SECOND};
+  codecCtx_->framerate = {FRAMES_PER_SECOND, 1};
+  codecCtx_->pix_fmt = pixelFormat;
+  codecCtx_->thread_count = static_cast<int>(settings_.threads);
+  codecCtx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  if (codec->id == AV_CODEC_ID_H264 || codec->id == AV_CODEC_ID_MPEG4) {
+    codecCtx_->bit_rate = 400000;
+    codecCtx_->gop_size = 10;
+    codecCtx_->max_b_frames = 1;
+  }
+
+  // Set codec-specific options
+  if (codec->id == AV_CODEC_ID_H264) {
+    av_opt_set(codecCtx_->priv_data, "preset", spec.preset, 0);
+    if (settings_.profile == EncoderProfile::LOSSLESS) {
+      av_opt_set(codecCtx_->priv_data, "qp", "0", 0);
+    } else {
+      av_opt_set(codecCtx_->priv_data, "crf", "23", 0);
+    }
+  }
+
+  if (avcodec_open2(codecCtx_, codec, nullptr) < 0) {
+    Logger::error("Could not open codec");
+    release();
+    return false;
+  }
+
+  // Create output format context with one video stream
+  avformat_alloc_output_context2(&formatCtx_, nullptr, container, path.c_str());
+  if (!formatCtx_) {
+    Logger::error("Could not create format context");
+    release();
+    return false;
+  }
+
+  stream_ = avformat_new_stream(formatCtx_, nullptr);
+  if (!stream_) {
+    Logger::error("Could not create stream");
+    release();
+    return false;
+  }
+  stream_->time_base = codecCtx_->time_base;
+  avcodec_parameters_from_context(stream_->codecpar, codecCtx_);
+
+  if (!(formatCtx_->oformat->flags & AVFMT_NOFILE)) {
+    if (avio_open(&formatCtx_->pb, path.c_str(), AVIO_FLAG_WRITE) < 0) {
+      Logger::error("Could not open output file: {}", path);
+      release();
+      return false;
+    }
+  }
+
+  if (avformat_write_header(formatCtx_, nullptr) < 0) {
+    Logger::error("Could not write format header");
+    release();
+    return false;
+  }
+
+  // Reusable conversion target and packet
+  frame_ = av_frame_alloc();
+  packet_ = av_packet_alloc();
+  if (!frame_ || !packet_) {
+    Logger::error("Could not allocate frame");
+    release();
+    return false;
+  }
+  frame_->format = codecCtx_->pix_fmt;
+  frame_->width = width;
+  frame_->height = height;
+  if (av_frame_get_buffer(frame_, 0) < 0) {
+    Logger::error("Could not allocate frame data");
+    release();
+    return false;
+  }
+
+  // Converter from RGBA to the codec's format (a channel reorder for the lossless profile)
+  const int swsFlags = settings_.profile == EncoderProfile::LOSSLESS ? SWS_POINT : SWS_BILINEAR;
+  swsCtx_ = sws_getContext(width, height, AV_PIX_FMT_RGBA, width, height, codecCtx_->pix_fmt, swsFlags, nullptr,
+                           nullptr, nullptr);
+  if (!swsCtx_) {
+    Logger::error("Could not create scaler context");
+    release();
+    return false;
+  }
+
+  return true;
+}
+
+bool VideoEncoder::addFrame(const uint8_t* rgba, int stride) {
+  if (!isOpen()) {
+    return false;
+  }
+
+  // The encoder may still reference the previous frame's buffers
+  if (av_frame_make_writable(frame_) < 0) {
+    Logger::error("Could not make frame {} writable", frameCount_);
+    return false;
+  }
+
+  const uint8_t* srcData[1] = {rgba};
+  const int srcLinesize[1] = {stride};
+  sws_scale(swsCtx_, srcData, srcLinesize, 0, height_, frame_->data, frame_->linesize);
+  frame_->pts = static_cast<int64_t>(frameCount_);
+
+  if (avcodec_send_frame(codecCtx_, frame_) < 0) {
+    Logger::error("Could not send frame {} to encoder", frameCount_);
+    return false;
+  }
+  ++frameCount_;
+  return writePackets();
+}
+
+bool VideoEncoder::close() {
+  if (!isOpen()) {
+    return false;
+  }
+
+  // Flush delayed frames, then finalize the container
+  avcodec_send_frame(codecCtx_, nullptr);
+  writePackets();
+  const bool ok = av_write_trailer(formatCtx_) == 0;
+
+  release();
+  return ok;
+}
+
+void VideoEncoder::abort() {
+  if (!isOpen()) {
+    return;
+  }
+  release();
+  std::remove(path_.c_str());
+  Logger::info("Discarded partial video {} ({} frames)", path_, frameCount_);
+}
+
+bool VideoEncoder::writePackets() {
+  int result;
+  while ((result = avcodec_receive_packet(codecCtx_, packet_)) == 0) {
+    av_packet_rescale_ts(packet_, codecCtx_->time_base, stream_->time_base);
+    packet_->stream_index = stream_->index;
+    av_interleaved_write_frame(formatCtx_, packet_);
+    av_packet_unref(packet_);
+  }
+  return result == AVERROR(EAGAIN) || result == AVERROR_EOF;
+}
+
+void VideoEncoder::release() {
+  if (packet_) {
+    av_packet_free(&packet_);
+  }
+  if (swsCtx_) {
+    sws_freeContext(swsCtx_);
+    swsCtx_ = nullptr;
+  }
+  if (frame_) {
+    av_frame_free(&frame_);
+  }
+  if (formatCtx_) {
+    if (formatCtx_->pb && !(formatCtx_->oformat->flags & AVFMT_NOFILE)) {
+      avio_closep(&formatCtx_->pb);
+    }
+    avformat_free_context(formatCtx_);
+    formatCtx_ = nullptr;
+  }
+  stream_ = nullptr;
+  if (codecCtx_) {
+    avcodec_free_context(&codecCtx_);
+  }
+}
+
+}  // namespace Video
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
@@ -0,0 +1,168 @@
+#ifndef BIOSIM4_SRC_IO_VIDEO_VIDEOENCODER_H_
+#define BIOSIM4_SRC_IO_VIDEO_VIDEOENCODER_H_
+
+/**
+ * @file videoEncoder.h
+ * @brief Streaming FFmpeg encoder for generation videos
+ *
+ * Frames are converted and handed to the codec as soon as they are rendered.
+ * Memory use is the codec's own bounded lookahead plus one conversion frame.
+ * It does not grow with the number of frames, unlike buffering every frame
+ * of a generation until it ends.
+ *
+ * The codec setup comes from an EncoderProfile (videoEncoderProfile):
+ * - medium: H.264 preset medium, CRF 23 (the long-standing default)
+ * - superfast, ultrafast: the same quality target, much less CPU per frame
+ * - lossless: RGB H.264 (libx264rgb) at QP 0, for archival; RGB FFV1 if
+ *   libx264rgb is missing. Decoded frames match the rendered RGB exactly.
+ * - raw: uncompressed YUV 4:2:0 in a .y4m file; no codec work at all
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// FFmpeg types (C API); the headers are only included by the implementation
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct AVPacket;
+struct AVStream;
+struct SwsContext;
+
+namespace BioSim {
+inline namespace v1 {
+namespace IO {
+namespace Video {
+
+/**
+ * @brief Speed/size trade-off of the generation videos
+ */
+enum class EncoderProfile {
+  MEDIUM,     ///< H.264 preset medium, CRF 23 (AVI)
+  SUPERFAST,  ///< H.264 preset superfast, CRF 23 (AVI)
+  ULTRAFAST,  ///< H.264 preset ultrafast, CRF 23 (AVI)
+  LOSSLESS,   ///< libx264rgb QP 0, RGB (AVI); RGB FFV1 when libx264rgb is unavailable
+  RAW         ///< Uncompressed YUV 4:2:0 (Y4M)
+};
+
+/**
+ * @struct EncoderSettings
+ * @brief Codec setup applied by the next VideoEncoder::open()
+ */
+struct EncoderSettings {
+  EncoderProfile profile = EncoderProfile::MEDIUM;  ///< Preset, quality and container
+  unsigned threads = 1;                             ///< Codec threads per video (0 = one per core)
+};
+
+/**
+ * @brief Look up a profile by its config name ("medium", "superfast", "ultrafast", "lossless", "raw")
+ * @return false if the name is unknown
+ */
+bool parseEncoderProfile(const std::string& name, EncoderProfile& profile);
+
+/** @brief Config name of a profile */
+const char* encoderProfileName(EncoderProfile profile);
+
+/** @brief File extension of a profile's videos, including the dot */
+const char* videoFileExtension(EncoderProfile profile);
+
+/**
+ * @brief Path of a generation's video: `<directory>/gen-NNNNNN.avi` (`.y4m` for the raw profile)
+ * @param directory Output directory (a trailing slash is optional)
+ * @param generation Generation number (zero-padded to six digits)
+ * @param profile Profile the video is encoded with
+ */
+std::string generationVideoPath(const std::string& directory, unsigned generation,
+                                EncoderProfile profile = EncoderProfile::MEDIUM);
+
+/**
+ * @class VideoEncoder
+ * @brief Encodes RGBA frames into a video file one frame at a time
+ *
+ * The codec follows the EncoderSettings profile. For the compressed H.264
+ * profiles, MPEG-4 Part 2 is the fallback when H.264 is unavailable. Frames
+ * are 25 FPS. With threads != 1, the codec encodes several frames at once
+ * (frame threading), which speeds up a single video at the cost of a few
+ * frames of extra latency. Errors are logged and reported through return
+ * values; nothing throws.
+ *
+ * @par Usage Pattern
+ * 1. setSettings() if the defaults do not fit, then open() with the output path and frame size
+ * 2. addFrame() for every rendered frame
+ * 3. close() to flush the codec and write the trailer, or abort() to discard the file
+ */
+class VideoEncoder {
+ public:
+  VideoEncoder() = default;
+  ~VideoEncoder();
+
+  VideoEncoder(const VideoEncoder&) = delete;
+  VideoEncoder& operator=(const VideoEncoder&) = delete;
+
+  /** @brief Codec setup for the following open() calls; the open video keeps its own */
+  void setSettings(const EncoderSettings& settings) { settings_ = settings; }
+
+  /** @brief Codec setup used by open() */
+  const EncoderSettings& settings() const { return settings_; }
+
+  /**
+   * @brief Create the output file and set up codec, container and color conversion
+   * @param path Output file (.avi, or .y4m for the raw profile)
+   * @param width Frame width in pixels
+   * @param height Frame height in pixels
+   * @return false (after logging) if any FFmpeg step fails
+   */
+  bool open(const std::string& path, int width, int height);
+
+  /**
+   * @brief Convert one RGBA frame to the codec's pixel format and encode it
+   * @param rgba Top-left pixel of a width x height RGBA image
+   * @param stride Bytes per image row
+   * @return false if the encoder is not open or rejects the frame
+   */
+  bool addFrame(const uint8_t* rgba, int stride);
+
+  /**
+   * @brief Flush delayed frames, write the trailer and close the file
+   * @return true if the file was finalized
+   */
+  bool close();
+
+  /**
+   * @brief Close without finalizing and delete the partial file
+   */
+  void abort();
+
+  /** @brief True between a successful open() and close()/abort() */
+  bool isOpen() const { return codecCtx_ != nullptr; }
+
+  /** @brief Frames passed to addFrame() since open() */
+  size_t frameCount() const { return frameCount_; }
+
+  /** @brief Path given to the last open() */
+  const std::string& path() const { return path_; }
+
+ private:
+  bool writePackets();
+  void release();
+
+  AVCodecContext* codecCtx_ = nullptr;
+  AVFormatContext* formatCtx_ = nullptr;
+  AVStream* stream_ = nullptr;
+  AVFrame* frame_ = nullptr;
+  AVPacket* packet_ = nullptr;
+  SwsContext* swsCtx_ = nullptr;
+  int width_ = 0;
+  int height_ = 0;
+  size_t frameCount_ = 0;
+  std::string path_;
+  EncoderSettings settings_;
+};
+
+}  // namespace Video
+}  // namespace IO
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_IO_VIDEO_VIDEOENCODER_H_
@@ -0,0 +1,122 @@
+/**
+ * @file videoEncoder_test.cpp
+ * @brief Round-trip test of the lossless encoder profile.
+ */
+
+#include "videoEncoder.h"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libswscale/swscale.h>
+}
+
+namespace BioSim {
+
+using IO::Video::EncoderProfile;
+using IO::Video::EncoderSettings;
+using IO::Video::VideoEncoder;
+
+namespace {
+
+constexpr int WIDTH = 32;
+constexpr int HEIGHT = 16;
+constexpr int STRIDE = WIDTH * 4;
+
+/** @brief Opaque RGBA frame whose every channel varies by pixel and frame */
+std::vector<uint8_t> patternFrame(int frame) {
+  std::vector<uint8_t> rgba(static_cast<size_t>(STRIDE) * HEIGHT);
+  for (int y = 0; y < HEIGHT; ++y) {
+    for (int x = 0; x < WIDTH; ++x) {
+      uint8_t* pixel = &rgba[static_cast<size_t>(y) * STRIDE + x * 4];
+      pixel[0] = static_cast<uint8_t>(x * 8 + frame * 3);
+      pixel[1] = static_cast<uint8_t>(y * 16 + x);
+      pixel[2] = static_cast<uint8_t>((x * y + frame * 41) * 7);
+      pixel[3] = 255;
+    }
+  }
+  return rgba;
+}
+
+/** @brief First frame of the file's first stream, converted back to RGBA; empty on failure */
+std::vector<uint8_t> decodeFirstFrame(const std::string& path) {
+  std::vector<uint8_t> rgba;
+  AVFormatContext* formatCtx = nullptr;
+  if (avformat_open_input(&formatCtx, path.c_str(), nullptr, nullptr) < 0) {
+    return rgba;
+  }
+  AVCodecContext* codecCtx = nullptr;
+  AVPacket* packet = av_packet_alloc();
+  AVFrame* frame = av_frame_alloc();
+  const AVCodec* decoder = nullptr;
+  if (avformat_find_stream_info(formatCtx, nullptr) >= 0 && formatCtx->nb_streams > 0 &&
+      (decoder = avcodec_find_decoder(formatCtx->streams[0]->codecpar->codec_id)) != nullptr) {
+    codecCtx = avcodec_alloc_context3(decoder);
+    avcodec_parameters_to_context(codecCtx, formatCtx->streams[0]->codecpar);
+  }
+
+  bool decoded = false;
+  if (codecCtx && avcodec_open2(codecCtx, decoder, nullptr) >= 0) {
+    while (!decoded && av_read_frame(formatCtx, packet) >= 0) {
+      if (packet->stream_index == 0 && avcodec_send_packet(codecCtx, packet) >= 0) {
+        decoded = avcodec_receive_frame(codecCtx, frame) == 0;
+      }
+      av_packet_unref(packet);
+    }
+    if (!decoded) {
+      avcodec_send_packet(codecCtx, nullptr);
+      decoded = avcodec_receive_frame(codecCtx, frame) == 0;
+    }
+  }
+
+  if (decoded) {
+    SwsContext* swsCtx = sws_getContext(frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+                                        frame->width, frame->height, AV_PIX_FMT_RGBA, SWS_POINT, nullptr, nullptr,
+                                        nullptr);
+    if (swsCtx) {
+      rgba.resize(static_cast<size_t>(frame->width) * 4 * frame->height);
+      uint8_t* dstData[1] = {rgba.data()};
+      const int dstLinesize[1] = {frame->width * 4};
+      sws_scale(swsCtx, frame->data, frame->linesize, 0, frame->height, dstData, dstLinesize);
+      sws_freeContext(swsCtx);
+    }
+  }
+
+  av_frame_free(&frame);
+  av_packet_free(&packet);
+  avcodec_free_context(&codecCtx);
+  avformat_close_input(&formatCtx);
+  return rgba;
+}
+
+}  // namespace
+
+TEST(VideoEncoderTest, LosslessFramesDecodeToTheSameBytes) {
+  const std::string path = "biosim4-lossless-" + std::to_string(::getpid()) + ".avi";
+
+  VideoEncoder encoder;
+  encoder.setSettings(EncoderSettings{EncoderProfile::LOSSLESS, 1});
+  ASSERT_TRUE(encoder.open(path, WIDTH, HEIGHT));
+  for (int frame = 0; frame < 3; ++frame) {
+    ASSERT_TRUE(encoder.addFrame(patternFrame(frame).data(), STRIDE));
+  }
+  ASSERT_TRUE(encoder.close());
+
+  const std::vector<uint8_t> decoded = decodeFirstFrame(path);
+  std::remove(path.c_str());
+  const std::vector<uint8_t> expected = patternFrame(0);
+  ASSERT_EQ(decoded.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(decoded[i], expected[i]) << "byte " << i << " (pixel " << i / 4 << ", channel " << i % 4 << ")";
+  }
+}
+
+}  // namespace BioSim
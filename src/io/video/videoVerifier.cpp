@@ -9,21 +9,45 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 
 namespace BioSim {
 inline namespace v1 {
 namespace IO {
 namespace Video {
 
+namespace {
+
+/** @brief Quote and escape a string for JSON */
+std::string jsonString(const std::string& text) {
+  std::string out = "\"";
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out += fmt::format("\\u{:04x}", static_cast<unsigned>(c));
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+}  // namespace
+
 VideoVerificationResult VideoVerifier::verify(const std::string& outputDir, int expectedGenerations, bool verbose) {
   VideoVerificationResult result;
   result.expectedCount = expectedGenerations;
   result.foundVideos = listVideos(outputDir);
   result.actualCount = static_cast<int>(result.foundVideos.size());
+  result.invalidCount = static_cast<int>(std::count_if(result.foundVideos.begin(), result.foundVideos.end(),
+                                                       [](const VideoInfo& video) { return !video.media.valid; }));
 
   // Check which generations are missing
   std::vector<bool> found(expectedGenerations, false);
@@ -39,7 +63,7 @@ VideoVerificationResult VideoVerifier::verify(const std::string& outputDir, int
     }
   }
 
-  result.success = result.missingGenerations.empty() && result.actualCount > 0;
+  result.success = result.missingGenerations.empty() && result.actualCount > 0 && result.invalidCount == 0;
 
   // Build summary
   std::ostringstream summary;
@@ -47,6 +71,9 @@ VideoVerificationResult VideoVerifier::verify(const std::string& outputDir, int
     summary << "✅ All " << expectedGenerations << " videos generated successfully in " << outputDir;
   } else if (result.actualCount == 0) {
     summary << "❌ No videos found in " << outputDir;
+  } else if (result.missingGenerations.empty()) {
+    summary << "❌ " << result.invalidCount << "/" << result.actualCount << " videos in " << outputDir
+            << " are truncated or unfinished";
   } else {
     summary << "⚠️  Found " << result.actualCount << "/" << expectedGenerations << " videos in " << outputDir
             << ". Missing: ";
@@ -55,6 +82,9 @@ VideoVerificationResult VideoVerifier::verify(const std::string& outputDir, int
         summary << ", ";
       summary << result.missingGenerations[i];
     }
+    if (result.invalidCount > 0) {
+      summary << ". Invalid: " << result.invalidCount;
+    }
   }
   result.summary = summary.str();
 
@@ -72,17 +102,25 @@ std::vector<VideoInfo> VideoVerifier::listVideos(const std::string& outputDir) {
     return videos;
   }
 
+  std::vector<std::filesystem::path> paths;
   for (const auto& entry : std::filesystem::directory_iterator(outputDir)) {
     if (entry.is_regular_file()) {
       std::string ext = entry.path().extension().string();
       std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
-      if (ext == ".avi" || ext == ".mp4" || ext == ".mov") {
-        videos.push_back(getVideoInfo(entry.path()));
+      if (ext == ".avi" || ext == ".mp4" || ext == ".mov" || ext == ".y4m") {
+        paths.push_back(entry.path());
       }
     }
   }
 
+  // Each probe maps one file and reads a few KB of headers, so files are spread over all threads
+  videos.resize(paths.size());
+#pragma omp parallel for schedule(dynamic, 8)
+  for (size_t i = 0; i < paths.size(); ++i) {
+    videos[i] = getVideoInfo(paths[i]);
+  }
+
   // Sort by generation number
   std::sort(videos.begin(), videos.end(),
             [](const VideoInfo& a, const VideoInfo& b) { return a.generationNumber < b.generationNumber; });
@@ -98,6 +136,7 @@ VideoInfo VideoVerifier::getVideoInfo(const std::filesystem::path& videoPath) {
   if (info.exists) {
     info.fileSizeBytes = std::filesystem::file_size(videoPath);
     info.formattedSize = formatFileSize(info.fileSizeBytes);
+    info.media = probeContainer(videoPath);
   } else {
     info.fileSizeBytes = 0;
     info.formattedSize = "N/A";
@@ -125,7 +164,7 @@ std::string VideoVerifier::formatFileSize(size_t bytes) {
 
 int VideoVerifier::extractGenerationNumber(const std::filesystem::path& path) {
   // Match patterns like: gen-000042.avi, generation_042.mp4, etc.
-  std::regex genRegex(R"(gen(?:eration)?[-_]?(\d+))", std::regex::icase);
+  static const std::regex genRegex(R"(gen(?:eration)?[-_]?(\d+))", std::regex::icase);
   std::smatch match;
   std::string filename = path.stem().string();
 
@@ -149,17 +188,27 @@ void VideoVerifier::printReport(const VideoVerificationResult& result) {
 
   if (!result.foundVideos.empty()) {
     fmt::print("📹 Found Videos:\n");
-    fmt::print("┌────────────┬──────────────────────────────────────────┬────────────┐\n");
-    fmt::print("│ Generation │ Filename                                 │ Size       │\n");
-    fmt::print("├────────────┼──────────────────────────────────────────┼────────────┤\n");
+    fmt::print("┌────────────┬──────────────────────────┬────────────┬────────┬─────────────┬──────────┐\n");
+    fmt::print("│ Generation │ Filename                 │ Size       │ Frames │ Resolution  │ Length   │\n");
+    fmt::print("├────────────┼──────────────────────────┼────────────┼────────┼─────────────┼──────────┤\n");
 
     for (const auto& video : result.foundVideos) {
-      fmt::print("│ {:>10} │ {:<40} │ {:>10} │\n",
+      fmt::print("│ {:>10} │ {:<24} │ {:>10} │ {:>6} │ {:>11} │ {:>7.1f}s │\n",
                  (video.generationNumber >= 0 ? std::to_string(video.generationNumber) : "unknown"),
-                 video.path.filename().string(), video.formattedSize);
+                 video.path.filename().string(), video.formattedSize, video.media.frameCount,
+                 fmt::format("{}x{}", video.media.width, video.media.height), video.media.durationSeconds);
     }
 
-    fmt::print("└────────────┴──────────────────────────────────────────┴────────────┘\n");
+    fmt::print("└────────────┴──────────────────────────┴────────────┴────────┴─────────────┴──────────┘\n");
+
+    if (result.invalidCount > 0) {
+      fmt::print("\n❌ Invalid videos:\n");
+      for (const auto& video : result.foundVideos) {
+        if (!video.media.valid) {
+          fmt::print("  {}: {}\n", video.path.filename().string(), video.media.problem);
+        }
+      }
+    }
   }
 
   if (!result.missingGenerations.empty()) {
@@ -175,6 +224,38 @@ void VideoVerifier::printReport(const VideoVerificationResult& result) {
   fmt::print("\n");
 }
 
+void VideoVerifier::writeJson(const VideoVerificationResult& result, const std::string& path) {
+  std::ofstream file(path);
+  if (!file) {
+    throw std::runtime_error("Failed to open file for writing: " + path);
+  }
+
+  file << "{\n";
+  file << fmt::format("  \"success\": {},\n", result.success ? "true" : "false");
+  file << fmt::format("  \"expected\": {},\n", result.expectedCount);
+  file << fmt::format("  \"found\": {},\n", result.actualCount);
+  file << fmt::format("  \"invalid\": {},\n", result.invalidCount);
+  file << "  \"missingGenerations\": [";
+  for (size_t i = 0; i < result.missingGenerations.size(); ++i) {
+    file << (i > 0 ? ", " : "") << result.missingGenerations[i];
+  }
+  file << "],\n";
+  file << "  \"videos\": [\n";
+  for (size_t i = 0; i < result.foundVideos.size(); ++i) {
+    const auto& video = result.foundVideos[i];
+    file << fmt::format(
+        "    {{\"path\": {}, \"generation\": {}, \"bytes\": {}, \"container\": {}, \"valid\": {}, "
+        "\"frames\": {}, \"width\": {}, \"height\": {}, \"frameRate\": {:.4f}, \"durationSeconds\": {:.4f}, "
+        "\"problem\": {}}}{}\n",
+        jsonString(video.path.string()), video.generationNumber, video.fileSizeBytes,
+        jsonString(video.media.container), video.media.valid ? "true" : "false", video.media.frameCount,
+        video.media.width, video.media.height, video.media.frameRate, video.media.durationSeconds,
+        jsonString(video.media.problem), i + 1 < result.foundVideos.size() ? "," : "");
+  }
+  file << "  ]\n";
+  file << "}\n";
+}
+
 bool VideoVerifier::openVideoInPlayer(const std::filesystem::path& videoPath) {
   if (!std::filesystem::exists(videoPath)) {
     fmt::print(stderr, "❌ Video not found: {}\n", videoPath.string());
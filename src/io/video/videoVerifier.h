@@ -6,11 +6,17 @@
  * especially during transitions (like removing CImg/OpenCV dependencies).
  * It checks for generated videos, validates their properties, and provides
  * helpful feedback.
+ *
+ * Videos are validated from their container headers and index only (see
+ * containerProbe.h), on all cores at once, so truncated or unfinished files
+ * are found without decoding a single frame.
  */
 
 #ifndef VIDEOVERIFIER_H
 #define VIDEOVERIFIER_H
 
+#include "containerProbe.h"
+
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -29,6 +35,7 @@ struct VideoInfo {
   std::string formattedSize;
   int generationNumber;
   bool exists;
+  ContainerInfo media;
 };
 
 /**
@@ -38,6 +45,7 @@ struct VideoVerificationResult {
   bool success;
   int expectedCount;
   int actualCount;
+  int invalidCount;
   std::vector<VideoInfo> foundVideos;
   std::vector<int> missingGenerations;
   std::string summary;
@@ -61,6 +69,8 @@ class VideoVerifier {
   /**
    * @brief List all video files in output directory
    *
+   * Container headers are probed in parallel, one file per OpenMP thread.
+   *
    * @param outputDir Directory to search
    * @return List of found videos with metadata
    */
@@ -69,6 +79,8 @@ class VideoVerifier {
   /**
    * @brief Get information about a specific video file
    *
+   * Reads frame count, resolution and duration from the container headers.
+   *
    * @param videoPath Path to video file
    * @return Video information
    */
@@ -81,6 +93,15 @@ class VideoVerifier {
    */
   static void printReport(const VideoVerificationResult& result);
 
+  /**
+   * @brief Write verification results as JSON
+   *
+   * @param result Verification results to write
+   * @param path Output file
+   * @throws std::runtime_error if the file cannot be written
+   */
+  static void writeJson(const VideoVerificationResult& result, const std::string& path);
+
   /**
    * @brief Open video in system default player (macOS)
    *
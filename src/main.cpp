@@ -7,28 +7,28 @@
  * - Built-in presets for common scenarios
  * - Command-line overrides
  * - Interactive video verification
+ * - End-to-end benchmark mode with baseline regression checks
+ * - Thread-scaling study mode
+ * - Replay of a single generation from its checkpoint, with video
  * - Helpful error messages
  */
 
 #include "CLI/CLI.hpp"
+#include "benchmarkRunner.h"
 #include "configManager.h"
 #include "logger.h"
+#include "replay.h"
+#include "scalingStudy.h"
+#include "simulator.h"
 #include "videoVerifier.h"
 
 #include <spdlog/fmt/fmt.h>
 
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <string>
-
-namespace BioSim {
-inline namespace v1 {
-namespace Core {
-namespace Simulation {
-void simulator(const Types::Params& params);
-}
-}  // namespace Core
-}  // namespace v1
-}  // namespace BioSim
+#include <thread>
 
 /**
  * @brief Display available configuration presets
@@ -41,6 +41,59 @@ void showPresets(BioSim::ConfigManager& config) {
   }
 }
 
+/**
+ * @brief Run the standardized benchmark scenarios and compare against a baseline
+ *
+ * @return 0 on success, 1 on error, 2 if any metric regressed beyond its threshold
+ */
+int runBenchmarks(const BioSim::Params& params, const std::string& filter, unsigned generations,
+                  const std::string& outPath, const std::string& baselinePath,
+                  const BioSim::BenchmarkThresholds& thresholds) {
+  const auto results = BioSim::BenchmarkRunner::run(params, filter, generations);
+  if (results.empty()) {
+    BioSim::Logger::error("No benchmark scenario matches filter '{}'", filter);
+    return 1;
+  }
+  BioSim::BenchmarkRunner::printReport(results);
+
+  try {
+    if (!outPath.empty()) {
+      BioSim::BenchmarkRunner::saveBaseline(results, params, outPath);
+    }
+    if (!baselinePath.empty()) {
+      const auto comparisons = BioSim::BenchmarkRunner::compareToBaseline(results, params, baselinePath, thresholds);
+      if (BioSim::BenchmarkRunner::printComparison(comparisons)) {
+        return 2;
+      }
+    }
+  } catch (const std::exception& e) {
+    BioSim::Logger::error("Benchmark failed: {}", e.what());
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Run the thread-scaling study and optionally write it as JSON
+ *
+ * @return 0 on success, 1 on error
+ */
+int runScalingStudy(const BioSim::Params& params, unsigned maxThreads, unsigned generations,
+                    const std::string& jsonPath) {
+  const auto points = BioSim::ScalingStudy::run(params, maxThreads, generations);
+  BioSim::ScalingStudy::printReport(points);
+
+  if (!jsonPath.empty()) {
+    try {
+      BioSim::ScalingStudy::writeJson(points, params, jsonPath);
+    } catch (const std::exception& e) {
+      BioSim::Logger::error("Scaling study failed: {}", e.what());
+      return 1;
+    }
+  }
+  return 0;
+}
+
 /**
  * @brief Main program entry point
  */
@@ -53,7 +106,11 @@ int main(int argc, char** argv) {
       "  biosim4 --preset video-test       # Test video generation\n"
       "  biosim4 config.toml               # Use specific config\n"
       "  biosim4 --set population=500      # Override parameter\n"
-      "  biosim4 --verify-videos           # Check generated videos\n");
+      "  biosim4 --verify-videos           # Check generated videos\n"
+      "  biosim4 --verify-videos --verify-json videos.json  # Check headers of all videos, report as JSON\n"
+      "  biosim4 --benchmark --benchmark-baseline bench.toml  # Check for regressions\n"
+      "  biosim4 --scaling --scaling-json scaling.json        # Measure thread scaling\n"
+      "  biosim4 -c run.toml --replay 1200                    # Re-simulate generation 1200 with video\n");
 
   // Configuration options
   std::string configFile;
@@ -85,6 +142,59 @@ int main(int argc, char** argv) {
   std::string videoDir = "output/images";
   app.add_option("--video-dir", videoDir, "Directory containing videos")->default_val("output/images");
 
+  std::string verifyJson;
+  app.add_option("--verify-json", verifyJson, "With --verify-videos, also write the report as JSON");
+
+  // Benchmark mode options
+  bool benchmark = false;
+  app.add_flag("--benchmark", benchmark, "Run standardized benchmark scenarios and exit");
+
+  std::string benchmarkFilter;
+  app.add_option("--benchmark-filter", benchmarkFilter, "Only run scenarios whose name contains this text");
+
+  unsigned benchmarkGenerations = 3;
+  app.add_option("--benchmark-generations", benchmarkGenerations, "Generations per benchmark scenario")
+      ->default_val(3)
+      ->check(CLI::PositiveNumber);
+
+  std::string benchmarkOut;
+  app.add_option("--benchmark-out", benchmarkOut, "Write benchmark results as a baseline file (TOML)");
+
+  std::string benchmarkBaseline;
+  app.add_option("--benchmark-baseline", benchmarkBaseline, "Compare benchmark results against a baseline file")
+      ->check(CLI::ExistingFile);
+
+  BioSim::BenchmarkThresholds benchmarkThresholds;
+  app.add_option("--benchmark-max-slowdown", benchmarkThresholds.maxSlowdownPercent,
+                 "Max allowed throughput drop vs baseline, percent")
+      ->default_val(10.0);
+  app.add_option("--benchmark-max-rss-growth", benchmarkThresholds.maxRssGrowthPercent,
+                 "Max allowed peak RSS growth vs baseline, percent")
+      ->default_val(10.0);
+
+  // Thread-scaling study options
+  bool scaling = false;
+  app.add_flag("--scaling", scaling, "Run the current config at 1, 2, 4, ... N threads and report speedup");
+
+  unsigned scalingMaxThreads = std::max(1u, std::thread::hardware_concurrency());
+  app.add_option("--scaling-max-threads", scalingMaxThreads, "Largest thread count in the scaling study")
+      ->default_val(scalingMaxThreads)
+      ->check(CLI::PositiveNumber);
+
+  unsigned scalingGenerations = 3;
+  app.add_option("--scaling-generations", scalingGenerations, "Generations per scaling run")
+      ->default_val(3)
+      ->check(CLI::PositiveNumber);
+
+  std::string scalingJson;
+  app.add_option("--scaling-json", scalingJson, "Write the scaling study as JSON");
+
+  // Replay options
+  int replayGeneration = -1;
+  app.add_option("--replay", replayGeneration,
+                 "Re-simulate one generation from its checkpoint (replayCheckpoints) with video, then exit")
+      ->check(CLI::NonNegativeNumber);
+
   // Parse command line
   try {
     app.parse(argc, argv);
@@ -105,6 +215,14 @@ int main(int argc, char** argv) {
   if (verifyVideos) {
     BioSim::Logger::print("🔍 Verifying video generation...");
     auto result = BioSim::VideoVerifier::verify(videoDir, 5, true);  // Default: check 5 videos
+    if (!verifyJson.empty()) {
+      try {
+        BioSim::VideoVerifier::writeJson(result, verifyJson);
+      } catch (const std::exception& e) {
+        BioSim::Logger::error("Video verification failed: {}", e.what());
+        return 1;
+      }
+    }
     return result.success ? 0 : 1;
   }
 
@@ -156,11 +274,41 @@ int main(int argc, char** argv) {
 
   // Initialize logging system
   const auto& params = config.getParams();
-  BioSim::Logger::init(params.logDir + "/biosim4.log", spdlog::level::info);
+  BioSim::Logger::init(params.logDir + "/biosim4.log", spdlog::level::info, params.logQueueSize);
+  BioSim::Utils::ConsoleThrottle::setInterval(std::chrono::milliseconds(params.logConsoleIntervalMs));
   BioSim::Logger::info("=== BioSim4 Session Start ===");
   BioSim::Logger::info("Configuration: grid={}x{}, population={}, generations={}", params.gridSize_X, params.gridSize_Y,
                        params.population, params.maxGenerations);
 
+  // Handle --benchmark (runs its own scenarios, then exits)
+  if (benchmark) {
+    BioSim::Logger::header("\n⏱  BioSim4 Benchmark Mode");
+    int status = runBenchmarks(params, benchmarkFilter, benchmarkGenerations, benchmarkOut, benchmarkBaseline,
+                               benchmarkThresholds);
+    BioSim::Logger::info("=== BioSim4 Session End (benchmark, status {}) ===", status);
+    BioSim::Logger::shutdown();
+    return status;
+  }
+
+  // Handle --scaling (repeats the config at increasing thread counts, then exits)
+  if (scaling) {
+    BioSim::Logger::header("\n🧵 BioSim4 Thread-Scaling Study");
+    int status = runScalingStudy(params, scalingMaxThreads, scalingGenerations, scalingJson);
+    BioSim::Logger::info("=== BioSim4 Session End (scaling, status {}) ===", status);
+    BioSim::Logger::shutdown();
+    return status;
+  }
+
+  // Handle --replay (one generation from its checkpoint, then exits)
+  if (replayGeneration >= 0) {
+    BioSim::Logger::header("\n🔁 BioSim4 Replay of Generation {}", replayGeneration);
+    int survivors = BioSim::Core::Simulation::replayGeneration(params, static_cast<unsigned>(replayGeneration));
+    int status = survivors < 0 ? 1 : 0;
+    BioSim::Logger::info("=== BioSim4 Session End (replay, status {}) ===", status);
+    BioSim::Logger::shutdown();
+    return status;
+  }
+
   // Print configuration summary to console
   BioSim::Logger::header("\n🧬 BioSim4 Starting...");
   config.printConfig(false);
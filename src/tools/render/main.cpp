@@ -0,0 +1,160 @@
+/**
+ * @file main.cpp
+ * @brief biosim4-render: turns generation traces (.b4t) into videos
+ *
+ * A run with videoTrace enabled records one compact trace per saved
+ * generation instead of rendering. This tool renders any of those traces
+ * afterwards, with the same drawing code as the simulator. Traces are
+ * independent, so several are rendered at once, one backend per thread.
+ */
+
+#include "CLI/CLI.hpp"
+#include "imageWriter.h"
+#include "logger.h"
+#include "renderBackend.h"
+#include "traceReader.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using BioSim::Logger;
+using BioSim::IO::Trace::TraceReader;
+
+/**
+ * @brief Render settings shared by all traces
+ */
+struct RenderOptions {
+  std::string outputDir;                       ///< Video directory; empty = next to each trace
+  std::string backend;                         ///< Render backend name
+  unsigned scale = 0;                          ///< Pixels per cell; 0 = the recording run's displayScale
+  unsigned agentSize = 0;                      ///< Agent radius; 0 = the recording run's agentSize
+  BioSim::IO::Video::EncoderSettings encoder;  ///< Encoder profile and codec threads
+};
+
+/**
+ * @brief Render every frame of one trace into gen-NNNNNN.avi (.y4m with --profile raw)
+ * @return true if the video was written
+ */
+bool renderTrace(const std::string& tracePath, const RenderOptions& options) {
+  TraceReader reader;
+  if (!reader.open(tracePath)) {
+    return false;
+  }
+  const auto& header = reader.header();
+  if (reader.frameCount() == 0) {
+    Logger::warning("{} has no frames", tracePath);
+    return false;
+  }
+
+  auto backend = BioSim::createRenderBackend(options.backend);
+  if (!backend) {
+    Logger::error("Unknown render backend \"{}\"", options.backend);
+    return false;
+  }
+  const uint16_t scale = static_cast<uint16_t>(options.scale > 0 ? options.scale : header.displayScale);
+  const uint16_t agentSize = static_cast<uint16_t>(options.agentSize > 0 ? options.agentSize : header.agentSize);
+  std::string outputDir = options.outputDir;
+  if (outputDir.empty()) {
+    outputDir = std::filesystem::path(tracePath).parent_path().string();
+    if (outputDir.empty()) {
+      outputDir = ".";
+    }
+  }
+  backend->init(header.sizeX, header.sizeY, scale, agentSize);
+  backend->setOutputDirectory(outputDir);
+  backend->setEncoderSettings(options.encoder);
+
+  BioSim::ImageFrameData frame;
+  for (size_t i = 0; i < reader.frameCount(); ++i) {
+    if (!reader.readFrame(i, frame)) {
+      backend->startNewGeneration();  // Discard the partial video
+      return false;
+    }
+    BioSim::IO::Video::renderFrame(*backend, frame, header.stepsPerGeneration, agentSize);
+  }
+  return backend->saveVideo(header.generation, outputDir);
+}
+
+}  // namespace
+
+/**
+ * @brief Main program entry point
+ */
+int main(int argc, char** argv) {
+  CLI::App app{"biosim4-render - Render BioSim4 generation traces (.b4t) into videos"};
+  app.footer(
+      "\nExamples:\n"
+      "  biosim4-render output/images/*.b4t             # Videos next to the traces\n"
+      "  biosim4-render -o videos -j 4 gen-000100.b4t   # Four at a time into videos/\n"
+      "  biosim4-render --scale 2 gen-000100.b4t        # Smaller video than the run's\n"
+      "  biosim4-render --profile ultrafast *.b4t       # Fastest encode, larger files\n");
+
+  std::vector<std::string> traces;
+  app.add_option("traces", traces, "Trace files to render")->required()->check(CLI::ExistingFile);
+
+  RenderOptions options;
+  app.add_option("-o,--output-dir", options.outputDir, "Directory for the videos (default: next to each trace)");
+  app.add_option("--backend", options.backend, "Render backend")
+      ->default_val("software")
+      ->check(CLI::IsMember({"software", "raylib"}));
+  app.add_option("--scale", options.scale, "Pixels per grid cell (default: the recording run's displayScale)");
+  app.add_option("--agent-size", options.agentSize, "Agent radius in pixels (default: the recording run's agentSize)");
+  std::string profile = "medium";
+  app.add_option("--profile", profile, "Encoder profile")
+      ->default_val(profile)
+      ->check(CLI::IsMember({"medium", "superfast", "ultrafast", "lossless", "raw"}));
+  app.add_option("--encoder-threads", options.encoder.threads, "Codec threads per video (0 = one per core)")
+      ->default_val(1);
+
+  unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+  app.add_option("-j,--jobs", jobs, "Traces rendered in parallel")->default_val(jobs)->check(CLI::PositiveNumber);
+
+  try {
+    app.parse(argc, argv);
+  } catch (const CLI::ParseError& e) {
+    return app.exit(e);
+  }
+
+  BioSim::IO::Video::parseEncoderProfile(profile, options.encoder.profile);
+  if (!options.outputDir.empty()) {
+    std::filesystem::create_directories(options.outputDir);
+  }
+  if (options.backend == "raylib" && jobs > 1) {
+    Logger::warning("The raylib backend is not thread-safe; rendering one trace at a time");
+    jobs = 1;
+  }
+  jobs = std::min<unsigned>(jobs, static_cast<unsigned>(traces.size()));
+
+  // Each worker takes the next unrendered trace until none are left
+  const auto start = std::chrono::steady_clock::now();
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> failed{0};
+  std::vector<std::thread> workers;
+  for (unsigned w = 0; w < jobs; ++w) {
+    workers.emplace_back([&] {
+      for (size_t i = next++; i < traces.size(); i = next++) {
+        if (!renderTrace(traces[i], options)) {
+          Logger::error("Failed to render {}", traces[i]);
+          ++failed;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const size_t rendered = traces.size() - failed;
+  Logger::success("Rendered {} of {} traces in {:.1f}s ({} jobs)", rendered, traces.size(), seconds, jobs);
+  return failed == 0 ? 0 : 1;
+}
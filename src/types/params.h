@@ -74,11 +74,29 @@ struct Params {
   float valenceSaturationMag;           ///< Signal saturation magnitude
 
   /// Video output settings
-  bool saveVideo;                 ///< Enable video generation
-  unsigned videoStride;           ///< Save every Nth generation (> 0)
-  unsigned videoSaveFirstFrames;  ///< Always save first N generations (>= 0, overrides videoStride)
-  unsigned displayScale;          ///< Pixel scale for output
-  unsigned agentSize;             ///< Visual size of agents
+  bool saveVideo;                   ///< Enable video generation
+  unsigned videoStride;             ///< Save every Nth generation (> 0)
+  unsigned videoSaveFirstFrames;    ///< Always save first N generations (>= 0, overrides videoStride)
+  bool videoAsync;                  ///< Render and encode on a pipelined render thread
+  unsigned videoQueueFrames;        ///< Captured frames buffered per encoder worker before capture blocks (> 0)
+  unsigned videoEncodeWorkers;      ///< Encoder threads; each encodes a different generation (> 0)
+  unsigned videoEncodeMemoryMB;     ///< Cap on buffered frames across all workers, in MiB (0 = no cap)
+  std::string renderBackend;        ///< "software" (CPU rasterizer) or "raylib"
+  std::string videoEncoderProfile;  ///< "medium", "superfast", "ultrafast", "lossless" or "raw" (see videoEncoder.h)
+  unsigned videoEncoderThreads;     ///< Codec threads per video (0 = one per core)
+  bool videoTrace;                  ///< Record compact .b4t traces instead of rendering video
+  bool videoTraceSignals;           ///< Include 4-bit pheromone layers in traces
+  std::string videoLiveRing;        ///< Shared-memory name for the live frame ring ("" = off, see liveRing.h)
+  unsigned videoLiveRingSlots;      ///< Frames kept in the live ring (>= 2)
+  unsigned videoFrameStride;        ///< Capture every Nth step of a recorded generation as a keyframe (> 0)
+  float videoDeathTrigger;          ///< Also capture when this fraction of the living died in one step (0 = off)
+  float videoSurvivorTrigger;       ///< Also capture when survivors moved by this fraction of the population (0 = off)
+  unsigned videoRoiX;               ///< First grid column of the captured region
+  unsigned videoRoiY;               ///< First grid row of the captured region
+  unsigned videoRoiWidth;           ///< Columns of the captured region (0 = whole grid)
+  unsigned videoRoiHeight;          ///< Rows of the captured region (0 = whole grid)
+  unsigned displayScale;            ///< Pixel scale for output
+  unsigned agentSize;               ///< Visual size of agents
 
   /// Analysis and logging settings
   unsigned genomeAnalysisStride;    ///< Genome analysis frequency (> 0)
@@ -87,6 +105,22 @@ struct Params {
   bool updateGraphLog;              ///< Enable graph log updates
   unsigned updateGraphLogStride;    ///< Graph log update frequency (> 0)
 
+  /// Metrics log settings (epoch-log.csv / epoch-log.bin in logDir)
+  std::string metricsFormat;        ///< "csv", "binary" or "none"
+  unsigned metricsQueueCapacity;    ///< Rows buffered before new rows are dropped (> 0)
+  unsigned metricsQueueMemoryMB;    ///< Cap on buffered rows and their diversity samples, in MiB (0 = no cap)
+  unsigned metricsFlushRows;        ///< Flush after this many rows (0 = interval only)
+  unsigned metricsFlushIntervalMs;  ///< Flush at least this often while rows arrive (0 = rows only)
+  std::string metricsEndpoint;      ///< Live /metrics address: "PORT", "HOST:PORT", "unix:PATH" or "" (off)
+
+  /// Logging settings
+  unsigned logQueueSize;          ///< Async file-log queue length (> 0); oldest messages are overwritten when full
+  unsigned logConsoleIntervalMs;  ///< Min time between repeated console lines from one call site (0 = no limit)
+
+  /// Replay checkpoints (parent genomes and RNG state per generation, see replay.h)
+  bool replayCheckpoints;  ///< Write one checkpoint per generation so any generation can be replayed
+  std::string replayDir;   ///< Directory for checkpoint files
+
   /// Challenge and environment settings
   unsigned challenge;    ///< Challenge type identifier
   unsigned barrierType;  ///< Barrier configuration (>= 0)
@@ -6,7 +6,7 @@
  * - Converting sensor/action enums to human-readable strings
  * - Printing genome and neural network information
  * - Calculating population statistics
- * - Generating epoch logs and reports
+ * - Generating reports (the per-generation epoch log is in io/metrics/metricsWriter)
  */
 
 #include "../core/simulation/simulator.h"
@@ -15,7 +15,6 @@
 
 #include <cassert>
 #include <cstring>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -455,44 +454,6 @@ float averageGenomeLength() {
   return sum / numberSamples;
 }
 
-/**
- * @brief Append generation statistics to epoch log file
- * @param generation Generation number (0-based)
- * @param numberSurvivors Count of individuals passing survival challenge
- * @param murderCount Number of individuals killed by others (if enabled)
- *
- * Writes one line per generation to `<logDir>/epoch-log.txt` in format:
- * @code
- * generation survivors diversity avg_genome_length murders
- * @endcode
- *
- * On generation 0, creates/truncates the log file. Subsequent generations
- * append. The output format is compatible with tools/graphlog.gp for
- * plotting simulation progress.
- *
- * @note Uses hardcoded filename "epoch-log.txt" in configured log directory
- * @see geneticDiversity() for diversity calculation
- * @see averageGenomeLength() for genome length calculation
- * @todo Remove hardcoded filename
- */
-void appendEpochLog(unsigned generation, unsigned numberSurvivors, unsigned murderCount) {
-  std::ofstream foutput;
-
-  if (generation == 0) {
-    foutput.open(parameterMngrSingleton.logDir + "/epoch-log.txt");
-    foutput.close();
-  }
-
-  foutput.open(parameterMngrSingleton.logDir + "/epoch-log.txt", std::ios::app);
-
-  if (foutput.is_open()) {
-    foutput << generation << " " << numberSurvivors << " " << geneticDiversity() << " " << averageGenomeLength() << " "
-            << murderCount << std::endl;
-  } else {
-    assert(false);
-  }
-}
-
 /**
  * @brief Print pheromone usage statistics to stdout
  *
@@ -51,6 +51,15 @@ void printSensorsActions();
  */
 float geneticDiversity();
 
+/**
+ * @brief Sample the mean genome length of the current population
+ *
+ * Draws 100 random individuals, so it advances the random number generator.
+ *
+ * @return Average number of genes per genome
+ */
+float averageGenomeLength();
+
 }  // namespace Utils
 
 }  // namespace v1
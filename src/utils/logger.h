@@ -2,25 +2,91 @@
 #define BIOSIM4_SRC_UTILS_LOGGER_H_
 
 // Use spdlog's bundled fmt (no separate fmt dependency needed)
+#include <spdlog/async.h>
 #include <spdlog/fmt/bundled/color.h>
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string_view>
 
+/**
+ * @def BIOSIM_LOG_ACTIVE_LEVEL
+ * @brief Lowest file-log level compiled into the binary (an SPDLOG_LEVEL_* value)
+ *
+ * BIOSIM_LOG_TRACE() ... BIOSIM_LOG_CRITICAL() below this level expand to
+ * nothing, so their arguments are not even evaluated. Set from CMake with
+ * `-DBIOSIM_LOG_LEVEL=DEBUG` (default INFO).
+ */
+#ifndef BIOSIM_LOG_ACTIVE_LEVEL
+#define BIOSIM_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+
 namespace BioSim {
 inline namespace v1 {
 namespace Utils {
 
+/**
+ * @brief Per-call-site console rate limit
+ *
+ * Used through BIOSIM_PRINT_THROTTLED(), which keeps one static instance per
+ * call site. A site prints at most once per interval (see setInterval()); the
+ * lines skipped in between are counted and reported with the next line that
+ * gets through. Safe to use from several threads.
+ */
+class ConsoleThrottle {
+ public:
+  /**
+   * @brief Minimum time between two console lines from the same call site
+   * @param interval 0 disables throttling
+   */
+  static void setInterval(std::chrono::milliseconds interval) {
+    intervalMs_.store(interval.count(), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Claim the right to print now
+   * @param suppressed Receives the number of lines skipped since the last print
+   * @return true if the caller should print
+   */
+  bool tryAcquire(uint64_t& suppressed) {
+    const int64_t interval = intervalMs_.load(std::memory_order_relaxed);
+    const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+    int64_t last = lastPrintMs_.load(std::memory_order_relaxed);
+    if ((interval > 0 && last != NEVER && now - last < interval) ||
+        !lastPrintMs_.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+      suppressed_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+    return true;
+  }
+
+ private:
+  static constexpr int64_t NEVER = INT64_MIN;
+  static inline std::atomic<int64_t> intervalMs_{1000};
+  std::atomic<int64_t> lastPrintMs_{NEVER};
+  std::atomic<uint64_t> suppressed_{0};
+};
+
 /**
  * @brief Centralized logging utility with dual output strategy
  *
  * Architecture:
  * - **Console output**: Direct fmt formatting with colors (immediate, human-friendly)
- * - **File logging**: spdlog with rotation (persistent, structured, filterable)
+ * - **File logging**: asynchronous spdlog with rotation (persistent, structured, filterable)
+ *
+ * File logging goes through a bounded queue drained by one spdlog worker
+ * thread. When the queue is full, the oldest message is overwritten, so a
+ * slow (e.g. network) filesystem never blocks the caller. The file is flushed
+ * on every error and every couple of seconds, not on every message.
  *
  * Usage:
  * @code
@@ -36,6 +102,10 @@ namespace Utils {
  * // File logging (persistent, with levels)
  * Logger::info("Generation {} complete, {} survivors", gen, count);
  * Logger::debug("Genome length: min={} max={} avg={}", min, max, avg);
+ *
+ * // Hot paths: compiled out below BIOSIM_LOG_ACTIVE_LEVEL, console rate-limited
+ * BIOSIM_LOG_DEBUG("Frame {} captured", step);
+ * BIOSIM_PRINT_THROTTLED("Gen {}, {} survivors", gen, count);
  * @endcode
  *
  * Log levels (file only):
@@ -52,14 +122,19 @@ class Logger {
    * @brief Initialize the logging system
    * @param logPath Path to log file (will create rotating logs with 5MB max, 3 files)
    * @param level Minimum log level (default: info)
+   * @param queueSize Messages buffered for the async writer before the oldest is overwritten
    */
   static void init(const std::string& logPath = "output/logs/biosim4.log",
-                   spdlog::level::level_enum level = spdlog::level::info) {
+                   spdlog::level::level_enum level = spdlog::level::info, size_t queueSize = 8192) {
     try {
-      // Create rotating file logger: 5MB max size, 3 backup files
-      auto file_logger = spdlog::rotating_logger_mt("biosim", logPath, 1024 * 1024 * 5, 3);
+      // Async rotating file logger: 5MB max size, 3 backup files, one writer thread
+      spdlog::init_thread_pool(queueSize, 1);
+      auto file_logger =
+          spdlog::rotating_logger_mt<spdlog::async_factory_nonblock>("biosim", logPath, 1024 * 1024 * 5, 3);
       file_logger->set_level(level);
       file_logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
+      file_logger->flush_on(spdlog::level::err);
+      spdlog::flush_every(std::chrono::seconds(2));
       spdlog::set_default_logger(file_logger);
 
       file_logger->info("========================================");
@@ -71,7 +146,7 @@ class Logger {
   }
 
   /**
-   * @brief Shutdown logging system (flush and close files)
+   * @brief Shutdown logging system (drain the async queue, flush and close files)
    */
   static void shutdown() {
     if (spdlog::get("biosim")) {
@@ -93,6 +168,24 @@ class Logger {
     fmt::print("\n");
   }
 
+  /**
+   * @brief Print to console unless @p throttle printed within the last interval
+   *
+   * Prefer BIOSIM_PRINT_THROTTLED(), which supplies a per-call-site throttle.
+   */
+  template <typename... Args>
+  static void printThrottled(ConsoleThrottle& throttle, fmt::format_string<Args...> fmt_str, Args&&... args) {
+    uint64_t suppressed = 0;
+    if (!throttle.tryAcquire(suppressed)) {
+      return;
+    }
+    fmt::print(fmt_str, std::forward<Args>(args)...);
+    if (suppressed > 0) {
+      fmt::print(" [{} similar lines suppressed]", suppressed);
+    }
+    fmt::print("\n");
+  }
+
   /**
    * @brief Print success message (green checkmark, console only)
    */
@@ -197,7 +290,7 @@ class Logger {
   }
 
   /**
-   * @brief Flush log buffers to disk
+   * @brief Flush log buffers to disk (queued behind pending async messages)
    */
   static void flush() {
     if (auto logger = spdlog::get("biosim")) {
@@ -223,4 +316,51 @@ using Utils::Logger;
 }  // namespace v1
 }  // namespace BioSim
 
+// ============================================================================
+// Level-elided file logging and rate-limited console output
+// ============================================================================
+
+#if BIOSIM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define BIOSIM_LOG_TRACE(...) ::BioSim::Utils::Logger::trace(__VA_ARGS__)
+#else
+#define BIOSIM_LOG_TRACE(...) (void)0
+#endif
+
+#if BIOSIM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define BIOSIM_LOG_DEBUG(...) ::BioSim::Utils::Logger::debug(__VA_ARGS__)
+#else
+#define BIOSIM_LOG_DEBUG(...) (void)0
+#endif
+
+#if BIOSIM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define BIOSIM_LOG_INFO(...) ::BioSim::Utils::Logger::info(__VA_ARGS__)
+#else
+#define BIOSIM_LOG_INFO(...) (void)0
+#endif
+
+#if BIOSIM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define BIOSIM_LOG_WARN(...) ::BioSim::Utils::Logger::warn(__VA_ARGS__)
+#else
+#define BIOSIM_LOG_WARN(...) (void)0
+#endif
+
+#if BIOSIM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define BIOSIM_LOG_ERROR(...) ::BioSim::Utils::Logger::log_error(__VA_ARGS__)
+#else
+#define BIOSIM_LOG_ERROR(...) (void)0
+#endif
+
+#if BIOSIM_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define BIOSIM_LOG_CRITICAL(...) ::BioSim::Utils::Logger::critical(__VA_ARGS__)
+#else
+#define BIOSIM_LOG_CRITICAL(...) (void)0
+#endif
+
+/// Console print limited to one line per ConsoleThrottle interval at this call site
+#define BIOSIM_PRINT_THROTTLED(...)                                               \
+  do {                                                                            \
+    static ::BioSim::Utils::ConsoleThrottle biosimConsoleThrottle_;               \
+    ::BioSim::Utils::Logger::printThrottled(biosimConsoleThrottle_, __VA_ARGS__); \
+  } while (0)
+
 #endif  // BIOSIM4_SRC_UTILS_LOGGER_H_
@@ -38,6 +38,18 @@ namespace Utils {
  * ```
  */
 struct RandomUintGenerator {
+  /**
+   * @struct State
+   * @brief Complete generator state
+   *
+   * Saved with replay checkpoints so that a generation can be re-simulated
+   * from exactly the random stream it originally consumed.
+   */
+  struct State {
+    uint32_t rngx, rngy, rngz, rngc;  ///< Marsaglia state
+    uint32_t a, b, c, d;              ///< Jenkins state
+  };
+
  private:
   /// Marsaglia algorithm state
   uint32_t rngx;  ///< Marsaglia state X
@@ -82,6 +94,21 @@ struct RandomUintGenerator {
    * @return Random value in range [min, max]
    */
   unsigned operator()(unsigned min, unsigned max);
+
+  /** @brief Snapshot of the generator state */
+  State state() const { return State{rngx, rngy, rngz, rngc, a, b, c, d}; }
+
+  /** @brief Resume from a snapshot taken with state() */
+  void setState(const State& s) {
+    rngx = s.rngx;
+    rngy = s.rngy;
+    rngz = s.rngz;
+    rngc = s.rngc;
+    a = s.a;
+    b = s.b;
+    c = s.c;
+    d = s.d;
+  }
 };
 
 /**
@@ -0,0 +1,86 @@
+/**
+ * @file resourceUsage.cpp
+ * @brief Implementation of process memory usage queries
+ */
+
+#include "resourceUsage.h"
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+#include <fstream>
+#include <string>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Utils {
+
+size_t peakResidentSetBytes() {
+#if defined(__linux__)
+  // VmHWM honours resets through clear_refs; ru_maxrss does not
+  std::ifstream status("/proc/self/status");
+  std::string key;
+  while (status >> key) {
+    if (key == "VmHWM:") {
+      size_t kilobytes = 0;
+      status >> kilobytes;
+      return kilobytes * 1024;
+    }
+    status.ignore(256, '\n');
+  }
+#endif
+
+  struct rusage usage {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return static_cast<size_t>(usage.ru_maxrss);  // bytes on macOS
+#else
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;  // kilobytes on Linux/BSD
+#endif
+}
+
+size_t currentResidentSetBytes() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  size_t totalPages = 0;
+  size_t residentPages = 0;
+  if (statm >> totalPages >> residentPages) {
+    return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+  return 0;
+#elif defined(__APPLE__)
+  mach_task_basic_info info{};
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) ==
+      KERN_SUCCESS) {
+    return static_cast<size_t>(info.resident_size);
+  }
+  return 0;
+#else
+  return 0;
+#endif
+}
+
+bool resetPeakResidentSetBytes() {
+#if defined(__linux__)
+  // Writing "5" resets the VmHWM high-water mark (Linux >= 4.0)
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  if (!clearRefs) {
+    return false;
+  }
+  clearRefs << "5";
+  return static_cast<bool>(clearRefs.flush());
+#else
+  return false;
+#endif
+}
+
+}  // namespace Utils
+}  // namespace v1
+}  // namespace BioSim
@@ -0,0 +1,45 @@
+#ifndef BIOSIM4_SRC_UTILS_RESOURCEUSAGE_H_
+#define BIOSIM4_SRC_UTILS_RESOURCEUSAGE_H_
+
+/**
+ * @file resourceUsage.h
+ * @brief Process memory usage queries (resident set size)
+ *
+ * Thin wrappers over getrusage() and /proc so reporting code does not need
+ * platform conditionals. All sizes are in bytes.
+ */
+
+#include <cstddef>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Utils {
+
+/**
+ * @brief Peak resident set size of this process
+ * @return High-water mark in bytes (since start, or since resetPeakResidentSetBytes())
+ */
+size_t peakResidentSetBytes();
+
+/**
+ * @brief Current resident set size of this process
+ * @return Bytes currently resident, or 0 if the platform does not expose it
+ */
+size_t currentResidentSetBytes();
+
+/**
+ * @brief Reset the peak resident set high-water mark
+ *
+ * Lets a process that runs several workloads back to back measure the peak
+ * of each one. Supported on Linux (via /proc/self/clear_refs); elsewhere the
+ * peak stays cumulative.
+ *
+ * @return true if the high-water mark was reset
+ */
+bool resetPeakResidentSetBytes();
+
+}  // namespace Utils
+}  // namespace v1
+}  // namespace BioSim
+
+#endif  // BIOSIM4_SRC_UTILS_RESOURCEUSAGE_H_
@@ -0,0 +1,127 @@
+/**
+ * @file agents_bench.cpp
+ * @brief Microbenchmarks for per-agent work: feedForward, getSensor and the action queues
+ */
+
+#include "benchFixtures.h"
+#include "utils/analysis.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace BioSim;
+
+/**
+ * Neural net forward pass for a single individual at several net sizes.
+ * Args: {genome length, maxNumberNeurons}. Includes the sensor reads the net
+ * performs, since that is what the simulation step pays for.
+ */
+static void BM_FeedForward(benchmark::State& state) {
+  Params p = Bench::makeBenchParams(128, 1000);
+  p.maxNumberNeurons = static_cast<unsigned>(state.range(1));
+  Bench::initWorld(p);
+  Bench::depositSignals(0, 4);
+
+  Individual& indiv = peeps[1];
+  indiv.genome = Bench::makeGenome(static_cast<unsigned>(state.range(0)));
+  indiv.createWiringFromGenome();
+
+  unsigned simStep = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(indiv.feedForward(simStep));
+    simStep = (simStep + 1) % p.stepsPerGeneration;
+  }
+
+  state.counters["connections"] = static_cast<double>(indiv.nnet.connections.size());
+  state.counters["neurons"] = static_cast<double>(indiv.nnet.neurons.size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FeedForward)->Args({8, 2})->Args({24, 5})->Args({64, 10})->Args({128, 20})->Args({300, 40});
+
+/**
+ * One sensor read, cycling through the whole population so that probes and
+ * neighborhood scans see realistic occupancy. Arg: Sensor enum value.
+ */
+static void BM_GetSensor(benchmark::State& state) {
+  const auto sensor = static_cast<Sensor>(state.range(0));
+  Params p = Bench::makeBenchParams(128, 3000);
+  Bench::initWorld(p);
+  Bench::depositSignals(0, 4);
+
+  unsigned index = 1;
+  unsigned simStep = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(peeps[index].getSensor(sensor, simStep));
+    if (++index > p.population) {
+      index = 1;
+      simStep = (simStep + 1) % p.stepsPerGeneration;
+    }
+  }
+
+  state.SetLabel(Utils::sensorName(sensor));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetSensor)->DenseRange(0, Sensor::NUM_SENSES - 1);
+
+/**
+ * Peeps::drainDeathQueue with a fraction of the population queued.
+ * Arg: percentage of the population killed per drain.
+ */
+static void BM_DrainDeathQueue(benchmark::State& state) {
+  Params p = Bench::makeBenchParams(128, 3000);
+  Bench::initWorld(p);
+  const unsigned stride = 100 / static_cast<unsigned>(state.range(0));
+
+  std::vector<uint16_t> victims;
+  for (unsigned index = 1; index <= p.population; index += stride) {
+    victims.push_back(static_cast<uint16_t>(index));
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (uint16_t index : victims) {
+      Individual& indiv = peeps[index];
+      indiv.alive = true;
+      grid.set(indiv.loc, index);
+      peeps.queueForDeath(indiv);
+    }
+    state.ResumeTiming();
+
+    peeps.drainDeathQueue();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(victims.size()));
+}
+BENCHMARK(BM_DrainDeathQueue)->Arg(1)->Arg(10)->Arg(50)->Arg(100);
+
+/**
+ * Peeps::drainMoveQueue with every individual requesting a one-cell move in
+ * a random direction (collisions and out-of-bounds targets are filtered the
+ * same way executeActions() does).
+ */
+static void BM_DrainMoveQueue(benchmark::State& state) {
+  Params p = Bench::makeBenchParams(128, static_cast<unsigned>(state.range(0)));
+  Bench::initWorld(p);
+
+  unsigned queued = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    queued = 0;
+    for (unsigned index = 1; index <= p.population; ++index) {
+      const Individual& indiv = peeps[index];
+      Coordinate newLoc = indiv.loc + Dir::random8();
+      if (grid.isInBounds(newLoc) && grid.isEmptyAt(newLoc)) {
+        peeps.queueForMove(indiv, newLoc);
+        ++queued;
+      }
+    }
+    state.ResumeTiming();
+
+    peeps.drainMoveQueue();
+  }
+
+  state.counters["queued"] = static_cast<double>(queued);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queued));
+}
+BENCHMARK(BM_DrainMoveQueue)->Arg(1000)->Arg(3000)->Arg(10000);
@@ -0,0 +1,176 @@
+#ifndef BIOSIM4_TESTS_BENCH_BENCHFIXTURES_H_
+#define BIOSIM4_TESTS_BENCH_BENCHFIXTURES_H_
+
+/**
+ * @file benchFixtures.h
+ * @brief Shared, deterministic world setup for the biosim4_bench microbenchmarks
+ *
+ * Every benchmark starts from the same seeded parameter set so that runs are
+ * comparable across commits and machines. The helpers install a complete
+ * Params block (not just the grid size used by the unit tests), seed the
+ * thread-local RNG in deterministic mode, and populate the global grid,
+ * pheromones and peeps singletons exactly as generation 0 of a real run.
+ */
+
+#include "core/simulation/simulator.h"
+
+#include <cstdint>
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Simulation {
+/// @brief Spawn generation 0 (implemented in spawnNewGeneration.cpp)
+extern void initializeGeneration0();
+}  // namespace Simulation
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
+
+namespace BioSim {
+namespace Bench {
+
+/// Seed used for every benchmark fixture (matches the default config RNGSeed)
+constexpr unsigned BENCH_RNG_SEED = 12345678;
+
+/**
+ * @brief Build a complete, deterministic parameter set for benchmarking
+ *
+ * Values mirror the ConfigManager defaults except for the fields that would
+ * make results run-dependent (deterministic RNG on, video and logging off).
+ *
+ * @param gridSize Width and height of the square world
+ * @param population Number of individuals
+ * @return Fully populated Params
+ */
+inline Params makeBenchParams(uint16_t gridSize = 128, unsigned population = 3000) {
+  Params p{};
+  p.population = population;
+  p.stepsPerGeneration = 300;
+  p.maxGenerations = 1;
+  p.numThreads = 1;
+  p.signalLayers = 1;
+  p.genomeMaxLength = 300;
+  p.maxNumberNeurons = 5;
+  p.pointMutationRate = 0.001;
+  p.geneInsertionDeletionRate = 0.0;
+  p.deletionRatio = 0.5;
+  p.killEnable = false;
+  p.sexualReproduction = true;
+  p.chooseParentsByFitness = true;
+  p.populationSensorRadius = 2.5;
+  p.signalSensorRadius = 2;
+  p.responsiveness = 0.5;
+  p.responsivenessCurveKFactor = 2;
+  p.longProbeDistance = 16;
+  p.shortProbeBarrierDistance = 4;
+  p.valenceSaturationMag = 0.5;
+  p.saveVideo = false;
+  p.videoStride = 25;
+  p.videoSaveFirstFrames = 0;
+  p.videoAsync = false;
+  p.videoQueueFrames = 8;
+  p.videoEncodeWorkers = 1;
+  p.videoEncodeMemoryMB = 512;
+  p.renderBackend = "software";
+  p.videoEncoderProfile = "medium";
+  p.videoEncoderThreads = 1;
+  p.videoTrace = false;
+  p.videoTraceSignals = false;
+  p.videoLiveRing = "";
+  p.videoLiveRingSlots = 8;
+  p.videoFrameStride = 1;
+  p.videoDeathTrigger = 0.0;
+  p.videoSurvivorTrigger = 0.0;
+  p.videoRoiX = 0;
+  p.videoRoiY = 0;
+  p.videoRoiWidth = 0;
+  p.videoRoiHeight = 0;
+  p.displayScale = 8;
+  p.agentSize = 4;
+  p.genomeAnalysisStride = 25;
+  p.displaySampleGenomes = 0;
+  p.genomeComparisonMethod = 1;
+  p.updateGraphLog = false;
+  p.updateGraphLogStride = 25;
+  p.metricsFormat = "none";
+  p.metricsQueueCapacity = 1024;
+  p.metricsQueueMemoryMB = 64;
+  p.metricsFlushRows = 16;
+  p.metricsFlushIntervalMs = 1000;
+  p.metricsEndpoint = "";
+  p.logQueueSize = 8192;
+  p.logConsoleIntervalMs = 1000;
+  p.replayCheckpoints = false;
+  p.replayDir = "./output/replay/";
+  p.challenge = 6;
+  p.barrierType = 0;
+  p.deterministic = true;
+  p.RNGSeed = BENCH_RNG_SEED;
+  p.gridSize_X = gridSize;
+  p.gridSize_Y = gridSize;
+  p.genomeInitialLengthMin = 24;
+  p.genomeInitialLengthMax = 24;
+  p.logDir = "./output/logs/";
+  p.imageDir = "./output/images/";
+  p.parameterChangeGenerationNumber = 0;
+  return p;
+}
+
+/**
+ * @brief Install params globally and reseed the calling thread's RNG
+ * @param p Parameter set (deterministic must be true for reproducible runs)
+ */
+inline void installParams(const Params& p) {
+  initParamsForTesting(p);
+  randomUint.initialize();
+}
+
+/**
+ * @brief Allocate and populate the global world as generation 0
+ *
+ * Reseeds the RNG first, so calling this twice with the same params yields
+ * bit-identical grid, genomes and placements.
+ *
+ * @param p Parameter set to install
+ */
+inline void initWorld(const Params& p) {
+  installParams(p);
+  grid.initialize(p.gridSize_X, p.gridSize_Y);
+  pheromones.initialize(p.signalLayers, p.gridSize_X, p.gridSize_Y);
+  peeps.initialize(p.population);
+  Core::Simulation::initializeGeneration0();
+}
+
+/**
+ * @brief Deposit pheromone around a fraction of the population
+ *
+ * Gives the signal sensors and the frame renderer non-trivial layer content.
+ *
+ * @param layer Signal layer to write
+ * @param everyNth Emit for every Nth individual (1 = everyone)
+ */
+inline void depositSignals(uint16_t layer, unsigned everyNth) {
+  for (unsigned index = 1; index <= parameterMngrSingleton.population; index += everyNth) {
+    pheromones.increment(layer, peeps[index].loc);
+  }
+}
+
+/**
+ * @brief Create a random genome of an exact length using the seeded RNG
+ * @param length Number of genes
+ * @return Genome of @p length random genes
+ */
+inline Genome makeGenome(unsigned length) {
+  Genome genome;
+  genome.reserve(length);
+  for (unsigned n = 0; n < length; ++n) {
+    genome.push_back(makeRandomGene());
+  }
+  return genome;
+}
+
+}  // namespace Bench
+}  // namespace BioSim
+
+#endif  // BIOSIM4_TESTS_BENCH_BENCHFIXTURES_H_
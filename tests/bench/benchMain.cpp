@@ -0,0 +1,15 @@
+/**
+ * @file benchMain.cpp
+ * @brief Entry point for the biosim4_bench microbenchmark suite
+ *
+ * All benchmarks run on the calling thread with the deterministic RNG seeded
+ * from Bench::BENCH_RNG_SEED (see benchFixtures.h), so results are comparable
+ * across commits. Typical use:
+ *
+ *   ./bin/biosim4_bench --benchmark_filter=GetSensor --benchmark_repetitions=5
+ *   ./bin/biosim4_bench --benchmark_format=json --benchmark_out=bench.json
+ */
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+/**
+ * @file genetics_bench.cpp
+ * @brief Microbenchmarks for reproduction, wiring and genome comparison
+ */
+
+#include "benchFixtures.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace BioSim;
+
+namespace BioSim {
+inline namespace v1 {
+namespace Core {
+namespace Genetics {
+/// @brief Create offspring genome (implemented in genome.cpp)
+extern Genome generateChildGenome(const std::vector<Genome>& parentGenomes);
+}  // namespace Genetics
+}  // namespace Core
+}  // namespace v1
+}  // namespace BioSim
+
+/**
+ * generateChildGenome from a pool of parents, as spawnNewGeneration() calls it
+ * once per new individual. Args: {parent pool size, genome length}.
+ */
+static void BM_GenerateChildGenome(benchmark::State& state) {
+  Params p = Bench::makeBenchParams();
+  p.genomeMaxLength = static_cast<unsigned>(state.range(1)) * 2;
+  Bench::installParams(p);
+
+  std::vector<Genome> parentGenomes;
+  for (int64_t n = 0; n < state.range(0); ++n) {
+    parentGenomes.push_back(Bench::makeGenome(static_cast<unsigned>(state.range(1))));
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Core::Genetics::generateChildGenome(parentGenomes));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GenerateChildGenome)->Args({100, 24})->Args({1000, 24})->Args({1000, 128});
+
+/**
+ * Individual::createWiringFromGenome (renumbering, culling useless neurons and
+ * ordering connections). Args: {genome length, maxNumberNeurons}.
+ */
+static void BM_CreateWiringFromGenome(benchmark::State& state) {
+  Params p = Bench::makeBenchParams();
+  p.maxNumberNeurons = static_cast<unsigned>(state.range(1));
+  Bench::installParams(p);
+
+  Individual indiv;
+  indiv.genome = Bench::makeGenome(static_cast<unsigned>(state.range(0)));
+
+  for (auto _ : state) {
+    indiv.createWiringFromGenome();
+    benchmark::DoNotOptimize(indiv.nnet.connections.data());
+  }
+
+  state.counters["connections"] = static_cast<double>(indiv.nnet.connections.size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateWiringFromGenome)->Args({8, 2})->Args({24, 5})->Args({64, 10})->Args({128, 20})->Args({300, 40});
+
+/**
+ * genomeSimilarity for each genomeComparisonMethod on a parent/child pair
+ * (similar but not identical, as in geneticDiversity() on a real population).
+ * Args: {method (0 = Jaro-Winkler, 1 = Hamming bits, 2 = Hamming bytes), genome length}.
+ */
+static void BM_GenomeSimilarity(benchmark::State& state) {
+  Params p = Bench::makeBenchParams();
+  p.genomeComparisonMethod = static_cast<unsigned>(state.range(0));
+  p.pointMutationRate = 0.05;
+  p.genomeMaxLength = static_cast<unsigned>(state.range(1));
+  Bench::installParams(p);
+
+  const Genome genome1 = Bench::makeGenome(static_cast<unsigned>(state.range(1)));
+  const Genome genome2 = Core::Genetics::generateChildGenome({genome1});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(genomeSimilarity(genome1, genome2));
+  }
+
+  static const char* const methodNames[] = {"jaro-winkler", "hamming-bits", "hamming-bytes"};
+  state.SetLabel(methodNames[state.range(0)]);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GenomeSimilarity)->ArgsProduct({{0, 1, 2}, {24, 128}});
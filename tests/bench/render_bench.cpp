@@ -0,0 +1,72 @@
+/**
+ * @file render_bench.cpp
+ * @brief Microbenchmark for rendering one video frame (saveOneFrameImmed)
+ */
+
+#include "benchFixtures.h"
+#include "io/video/imageWriter.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace BioSim;
+
+/**
+ * saveOneFrameImmed on a snapshot of a populated world through the default
+ * render backend. The backend's unfinished video is discarded (outside
+ * the timed region) so memory stays bounded over long runs.
+ * Args: {population, pheromone emitters: every Nth individual (0 = none)}.
+ */
+static void BM_SaveOneFrameImmed(benchmark::State& state) {
+  Params p = Bench::makeBenchParams(128, static_cast<unsigned>(state.range(0)));
+  p.saveVideo = true;
+  p.signalLayers = 2;
+  Bench::initWorld(p);
+  if (state.range(1) > 0) {
+    Bench::depositSignals(0, static_cast<unsigned>(state.range(1)));
+  }
+  imageWriter.init(p.signalLayers, p.gridSize_X, p.gridSize_Y);
+
+  ImageFrameData data;
+  imageWriter.captureFrame(data, 0, 0, p.challenge, p.barrierType);
+
+  constexpr unsigned framesPerGeneration = 50;
+  unsigned frames = 0;
+  for (auto _ : state) {
+    IO::Video::saveOneFrameImmed(data);
+    if (++frames == framesPerGeneration) {
+      state.PauseTiming();
+      imageWriter.startNewGeneration();
+      frames = 0;
+      state.ResumeTiming();
+    }
+  }
+  imageWriter.startNewGeneration();
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SaveOneFrameImmed)->Args({1000, 0})->Args({3000, 0})->Args({3000, 4})->Args({3000, 1})->Unit(
+    benchmark::kMillisecond);
+
+/**
+ * ImageWriter::captureFrame into a preallocated frame: the per-step cost that
+ * video capture adds to the serial end of step before rendering.
+ * Args: {population}.
+ */
+static void BM_CaptureFrame(benchmark::State& state) {
+  Params p = Bench::makeBenchParams(128, static_cast<unsigned>(state.range(0)));
+  p.saveVideo = true;
+  p.signalLayers = 2;
+  Bench::initWorld(p);
+  Bench::depositSignals(0, 4);
+  imageWriter.init(p.signalLayers, p.gridSize_X, p.gridSize_Y);
+
+  ImageFrameData data;
+  data.allocate(p.signalLayers, p.gridSize_X, p.gridSize_Y, p.population);
+  for (auto _ : state) {
+    imageWriter.captureFrame(data, 0, 0, p.challenge, p.barrierType);
+    benchmark::DoNotOptimize(data.signalData.data());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CaptureFrame)->Arg(1000)->Arg(3000)->Unit(benchmark::kMicrosecond);
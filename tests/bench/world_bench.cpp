@@ -0,0 +1,115 @@
+/**
+ * @file world_bench.cpp
+ * @brief Microbenchmarks for grid neighborhoods, pheromone layers and the RNG
+ */
+
+#include "benchFixtures.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace BioSim;
+
+/**
+ * visitNeighborhood with a trivial visitor at several radii.
+ * Arg: radius in tenths of a cell (15 = 1.5, the Signals::increment radius).
+ */
+static void BM_VisitNeighborhood(benchmark::State& state) {
+  const float radius = static_cast<float>(state.range(0)) / 10.0f;
+  Params p = Bench::makeBenchParams(128, 3000);
+  Bench::initWorld(p);
+
+  unsigned index = 1;
+  for (auto _ : state) {
+    unsigned count = 0;
+    visitNeighborhood(peeps[index].loc, radius, [&count](Coordinate loc) {
+      if (grid.isOccupiedAt(loc)) {
+        ++count;
+      }
+    });
+    benchmark::DoNotOptimize(count);
+    if (++index > p.population) {
+      index = 1;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VisitNeighborhood)->Arg(10)->Arg(15)->Arg(25)->Arg(50)->Arg(100);
+
+/**
+ * Signals::increment at each individual's location in turn (the EMIT_SIGNAL0
+ * action path, including its omp critical section).
+ */
+static void BM_SignalsIncrement(benchmark::State& state) {
+  Params p = Bench::makeBenchParams(128, 3000);
+  Bench::initWorld(p);
+
+  unsigned index = 1;
+  for (auto _ : state) {
+    pheromones.increment(0, peeps[index].loc);
+    if (++index > p.population) {
+      index = 1;
+      state.PauseTiming();
+      pheromones.zeroFill();
+      state.ResumeTiming();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SignalsIncrement);
+
+/**
+ * Signals::fade over a whole layer, as endOfSimulationStep() runs it once per
+ * layer per step. Arg: square grid size.
+ */
+static void BM_SignalsFade(benchmark::State& state) {
+  const auto gridSize = static_cast<uint16_t>(state.range(0));
+  Params p = Bench::makeBenchParams(gridSize, 1000);
+  Bench::initWorld(p);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    Bench::depositSignals(0, 2);
+    state.ResumeTiming();
+
+    pheromones.fade(0);
+  }
+
+  state.SetItemsProcessed(state.iterations() * gridSize * gridSize);
+}
+BENCHMARK(BM_SignalsFade)->Arg(128)->Arg(256)->Arg(512);
+
+/**
+ * RandomUintGenerator raw 32-bit output (the Jenkins generator).
+ */
+static void BM_RandomUint(benchmark::State& state) {
+  Bench::installParams(Bench::makeBenchParams());
+  RandomUintGenerator rng;
+  rng.initialize();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rng());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomUint);
+
+/**
+ * RandomUintGenerator ranged output, as used by Dir::random8() and mutation.
+ * Arg: inclusive upper bound.
+ */
+static void BM_RandomUintRange(benchmark::State& state) {
+  Bench::installParams(Bench::makeBenchParams());
+  RandomUintGenerator rng;
+  rng.initialize();
+  const auto maxValue = static_cast<unsigned>(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(rng(0, maxValue));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomUintRange)->Arg(7)->Arg(65535);
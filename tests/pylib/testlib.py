@@ -243,12 +243,12 @@ def readLog(results_log):
             pass
         last_line = line
     try:
-        reslist = str.split(last_line)
+        reslist = last_line.strip().split(",")
         resdict = {
             "generation": int(reslist[0]),
             "survivors": int(reslist[1]),
             "diversity": float(reslist[2]),
-            "genomeSize": int(reslist[3]),
+            "genomeSize": int(float(reslist[3])),
             "kills": int(reslist[4]),
         }
         return resdict
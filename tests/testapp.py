@@ -43,7 +43,7 @@ _libname = "%s-lib" % _appname
 _configfile = "%s.ini" % _appname
 # temporary file used by this app to create test configurations:
 _temp_ini = "tmp.ini"
-_results_log = "epoch-log.txt"
+_results_log = "epoch-log.csv"
 _version = "21.12.12"
 
 
@@ -1,6 +1,7 @@
 #!/usr/bin/gnuplot --persist
 
-# Requires a text file named "epoch-log.txt" in the log directory
+# Requires the CSV metrics log "epoch-log.csv" in the log directory
+# (metrics format = "csv"; lines starting with # and the column-name row are skipped)
 
 set term png size 2000, 400
 set output "./output/images/log.png"
@@ -18,10 +19,12 @@ set y2range [ 0:256 ]
 set y2tics autofreq nomirror tc lt 1
 set grid
 set key lmargin
+set datafile separator ","
+set key autotitle columnhead
 
 ScaleGenomeLength(y)= y*2
 ScaleDiversity(d)= 350*d
 
-plot "./output/logs/epoch-log.txt" using 1:2 with lines lw 1 linecolor 2 title "Survivors", \
+plot "./output/logs/epoch-log.csv" using 1:2 with lines lw 1 linecolor 2 title "Survivors", \
     "" using 1:(ScaleDiversity($3)) with lines lw 1 linecolor 1 title "Diversity" axes x1y2, \
     "" using 1:(ScaleGenomeLength($4)) with lines lw 1 linecolor 6 title "Genome Len" axes x1y2
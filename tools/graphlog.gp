@@ -1,6 +1,7 @@
 #!/usr/bin/gnuplot --persist
 
-# Requires a text file named "epoch-log.txt" in the log directory
+# Requires the CSV metrics log "epoch-log.csv" in the log directory
+# (metrics format = "csv"; lines starting with # and the column-name row are skipped)
 
 set term png size 2000, 400
 set output "./output/images/log.png"
@@ -19,12 +20,14 @@ set y2range [ 0:1 ]
 set y2tics autofreq nomirror tc lt 1
 set grid
 set key lmargin
+set datafile separator ","
+set key autotitle columnhead
 
 ScaleSurvivors(s) = s
 ScaleGenomeLength(y)= y*2
 ScaleDiversity(d)= d
 #ScaleMurders(m) = m
 
-plot "./output/logs/epoch-log.txt" \
+plot "./output/logs/epoch-log.csv" \
        using 1:(ScaleSurvivors($2)) with lines lw 2 linecolor 2 title "Survivors", \
     "" using 1:(ScaleDiversity($3)) with lines lw 2 linecolor 1 title "Diversity" axes x1y2